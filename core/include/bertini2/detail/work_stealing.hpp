@@ -0,0 +1,172 @@
+//This file is part of Bertini 2.
+//
+//work_stealing.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//work_stealing.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with work_stealing.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// Daniel Brake
+// University of Notre Dame
+//
+
+/**
+\file work_stealing.hpp
+
+\brief Provides a set of work queues, one per worker, from which idle workers steal.
+*/
+
+
+#ifndef BERTINI_DETAIL_WORK_STEALING_HPP
+#define BERTINI_DETAIL_WORK_STEALING_HPP
+
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+
+namespace bertini {
+
+	namespace detail {
+
+	/**
+	\brief Distributes indexed jobs among workers, letting workers which run out of jobs take them from the others.
+
+	The jobs 0, ..., num_jobs-1 are initially dealt out in contiguous blocks, one block per worker.  A worker takes jobs from the front of its own queue.  When its queue is empty, it steals the back half of the fullest queue, so that a worker stuck on a few expensive jobs hands off the rest of its block to the others.
+
+	Each queue has its own lock, so workers contend only when stealing.
+	*/
+	class WorkStealingQueues
+	{
+	public:
+
+		/**
+		\param num_jobs The number of jobs to distribute.
+		\param num_workers The number of workers taking jobs.  Must be positive.
+		*/
+		WorkStealingQueues(unsigned long long num_jobs, unsigned num_workers)
+		{
+			if (num_workers==0)
+				throw std::runtime_error("work stealing queues require at least one worker");
+
+			for (unsigned ii = 0; ii < num_workers; ++ii)
+				queues_.push_back(std::make_unique<Queue>());
+
+			for (unsigned ii = 0; ii < num_workers; ++ii)
+			{
+				auto begin = num_jobs*ii/num_workers, end = num_jobs*(ii+1)/num_workers;
+				for (auto jj = begin; jj < end; ++jj)
+					queues_[ii]->jobs.push_back(jj);
+			}
+		}
+
+		/**
+		\brief Get the next job for a worker.
+
+		\param worker The index of the worker asking for a job.
+		\param job The job, if there is one.
+		\return Whether there was a job.  If false, all the jobs have been handed out.
+		*/
+		bool Next(unsigned worker, unsigned long long & job)
+		{
+			while (true)
+			{
+				{
+					auto& own = *queues_[worker];
+					std::lock_guard<std::mutex> lock(own.mutex);
+					if (!own.jobs.empty())
+					{
+						job = own.jobs.front();
+						own.jobs.pop_front();
+						return true;
+					}
+				}
+
+				if (!Steal(worker))
+					return false;
+			}
+		}
+
+		/**
+		\brief The number of workers among which the jobs are distributed.
+		*/
+		unsigned NumWorkers() const
+		{
+			return queues_.size();
+		}
+
+	private:
+
+		struct Queue
+		{
+			std::mutex mutex;
+			std::deque<unsigned long long> jobs;
+		};
+
+		/**
+		Move the back half of the fullest other queue into the queue for worker thief.
+
+		\return Whether anything was stolen.  If false, every queue was empty when looked at.
+		*/
+		bool Steal(unsigned thief)
+		{
+			while (true)
+			{
+				// find a victim without holding more than one lock at a time
+				unsigned victim = thief;
+				size_t most = 0;
+				for (unsigned ii = 0; ii < queues_.size(); ++ii)
+				{
+					if (ii==thief)
+						continue;
+					std::lock_guard<std::mutex> lock(queues_[ii]->mutex);
+					if (queues_[ii]->jobs.size() > most)
+					{
+						most = queues_[ii]->jobs.size();
+						victim = ii;
+					}
+				}
+
+				if (victim==thief)
+					return false;
+
+				std::deque<unsigned long long> loot;
+				{
+					auto& v = *queues_[victim];
+					std::lock_guard<std::mutex> lock(v.mutex);
+					if (v.jobs.empty()) // emptied since we looked.  look again.
+						continue;
+					auto num_to_steal = (v.jobs.size()+1)/2;
+					loot.assign(v.jobs.end()-num_to_steal, v.jobs.end());
+					v.jobs.erase(v.jobs.end()-num_to_steal, v.jobs.end());
+				}
+
+				auto& own = *queues_[thief];
+				std::lock_guard<std::mutex> lock(own.mutex);
+				own.jobs.insert(own.jobs.end(), loot.begin(), loot.end());
+				return true;
+			}
+		}
+
+		std::vector<std::unique_ptr<Queue> > queues_; ///< One queue per worker.
+	};
+
+	} // re: namespace detail
+} // re: namespace bertini
+
+#endif
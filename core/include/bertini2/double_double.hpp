@@ -0,0 +1,499 @@
+//This file is part of Bertini 2.
+//
+//double_double.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//double_double.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with double_double.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+/**
+\file double_double.hpp
+
+\brief Provides dd_real, a real number of about 32 significant digits represented as the unevaluated sum of two doubles, and its complex counterpart dd_complex.
+
+Double-double arithmetic is done entirely in hardware floating point, with no allocation, so it costs a small multiple of double arithmetic, rather than the much larger multiple of mpfr arithmetic at a similar precision.  It is the precision between double and multiple precision, for paths which need a few more digits than double for a stretch.
+
+The algorithms are those of Dekker, and of Hida, Li, and Bailey's QD library.  The exponent range is that of double.
+*/
+
+#ifndef BERTINI_DOUBLE_DOUBLE_HPP
+#define BERTINI_DOUBLE_DOUBLE_HPP
+
+#include <cmath>
+#include <complex>
+#include <iosfwd>
+#include <limits>
+
+#include <Eigen/Core>
+
+#include "bertini2/num_traits.hpp"
+
+namespace bertini {
+
+	/**
+	\brief A real number represented as the unevaluated sum of two doubles, hi and lo, with \f$|lo| \le ulp(hi)/2\f$.
+
+	Gives 106 bits of significand, or about 32 decimal digits.  Converts implicitly from double, and explicitly to and from double and mpfr_float.
+
+	The arithmetic and functions are hidden friends, found only by argument dependent lookup, so that they are never picked for unqualified calls on doubles.
+	*/
+	class dd_real
+	{
+	public:
+
+		constexpr dd_real() : hi_(0), lo_(0)
+		{}
+
+		constexpr dd_real(double x) : hi_(x), lo_(0)
+		{}
+
+		/**
+		\brief Make from the parts.  The parts must not overlap, as they do not if they are the result of QuickTwoSum.
+		*/
+		constexpr dd_real(double hi, double lo) : hi_(hi), lo_(lo)
+		{}
+
+		/**
+		\brief Round a multiple precision number to double-double.
+		*/
+		explicit dd_real(mpfr_float const& x);
+
+		/**
+		\brief Convert to multiple precision, at the current default precision.
+		*/
+		explicit operator mpfr_float() const;
+
+		explicit operator double() const
+		{
+			return hi_;
+		}
+
+		double hi() const
+		{
+			return hi_;
+		}
+
+		double lo() const
+		{
+			return lo_;
+		}
+
+
+
+		friend dd_real operator-(dd_real const& a)
+		{
+			return dd_real(-a.hi_, -a.lo_);
+		}
+
+		friend dd_real operator+(dd_real const& a, dd_real const& b)
+		{
+			double s, e, t, f;
+			TwoSum(a.hi_, b.hi_, s, e);
+			TwoSum(a.lo_, b.lo_, t, f);
+			e += t;
+			QuickTwoSum(s, e, s, e);
+			e += f;
+			QuickTwoSum(s, e, s, e);
+			return dd_real(s, e);
+		}
+
+		friend dd_real operator+(dd_real const& a, double b)
+		{
+			double s, e;
+			TwoSum(a.hi_, b, s, e);
+			e += a.lo_;
+			QuickTwoSum(s, e, s, e);
+			return dd_real(s, e);
+		}
+
+		friend dd_real operator+(double a, dd_real const& b)
+		{
+			return b + a;
+		}
+
+		friend dd_real operator-(dd_real const& a, dd_real const& b)
+		{
+			return a + (-b);
+		}
+
+		friend dd_real operator-(dd_real const& a, double b)
+		{
+			return a + (-b);
+		}
+
+		friend dd_real operator-(double a, dd_real const& b)
+		{
+			return (-b) + a;
+		}
+
+		friend dd_real operator*(dd_real const& a, dd_real const& b)
+		{
+			double p, e;
+			TwoProd(a.hi_, b.hi_, p, e);
+			e += a.hi_*b.lo_ + a.lo_*b.hi_;
+			QuickTwoSum(p, e, p, e);
+			return dd_real(p, e);
+		}
+
+		friend dd_real operator*(dd_real const& a, double b)
+		{
+			double p, e;
+			TwoProd(a.hi_, b, p, e);
+			e += a.lo_*b;
+			QuickTwoSum(p, e, p, e);
+			return dd_real(p, e);
+		}
+
+		friend dd_real operator*(double a, dd_real const& b)
+		{
+			return b*a;
+		}
+
+		friend dd_real operator/(dd_real const& a, dd_real const& b)
+		{
+			// long division, three quotient digits
+			double q1 = a.hi_/b.hi_;
+			dd_real r = a - b*q1;
+			double q2 = r.hi_/b.hi_;
+			r = r - b*q2;
+			double q3 = r.hi_/b.hi_;
+			QuickTwoSum(q1, q2, q1, q2);
+			return dd_real(q1, q2) + q3;
+		}
+
+		dd_real& operator+=(dd_real const& b)
+		{
+			return *this = *this + b;
+		}
+
+		dd_real& operator-=(dd_real const& b)
+		{
+			return *this = *this - b;
+		}
+
+		dd_real& operator*=(dd_real const& b)
+		{
+			return *this = *this * b;
+		}
+
+		dd_real& operator/=(dd_real const& b)
+		{
+			return *this = *this / b;
+		}
+
+
+
+		friend bool operator==(dd_real const& a, dd_real const& b)
+		{
+			return a.hi_==b.hi_ && a.lo_==b.lo_;
+		}
+
+		friend bool operator!=(dd_real const& a, dd_real const& b)
+		{
+			return !(a==b);
+		}
+
+		friend bool operator<(dd_real const& a, dd_real const& b)
+		{
+			return a.hi_<b.hi_ || (a.hi_==b.hi_ && a.lo_<b.lo_);
+		}
+
+		friend bool operator>(dd_real const& a, dd_real const& b)
+		{
+			return b<a;
+		}
+
+		friend bool operator<=(dd_real const& a, dd_real const& b)
+		{
+			return a.hi_<b.hi_ || (a.hi_==b.hi_ && a.lo_<=b.lo_);
+		}
+
+		friend bool operator>=(dd_real const& a, dd_real const& b)
+		{
+			return b<=a;
+		}
+
+
+
+		friend dd_real abs(dd_real const& a)
+		{
+			return a.hi_ < 0 ? -a : a;
+		}
+
+		friend dd_real fabs(dd_real const& a)
+		{
+			return abs(a);
+		}
+
+		friend bool isfinite(dd_real const& a)
+		{
+			return std::isfinite(a.hi_);
+		}
+
+		friend bool isnan(dd_real const& a)
+		{
+			return std::isnan(a.hi_);
+		}
+
+		friend bool isinf(dd_real const& a)
+		{
+			return std::isinf(a.hi_);
+		}
+
+		/**
+		\brief Multiply by \f$2^e\f$, exactly.
+		*/
+		friend dd_real ldexp(dd_real const& a, int e)
+		{
+			return dd_real(std::ldexp(a.hi_, e), std::ldexp(a.lo_, e));
+		}
+
+		friend dd_real sqrt(dd_real const& a);
+		friend dd_real exp(dd_real const& a);
+		friend dd_real log(dd_real const& a);
+		friend dd_real log10(dd_real const& a);
+		friend dd_real sin(dd_real const& a);
+		friend dd_real cos(dd_real const& a);
+		friend dd_real tan(dd_real const& a);
+		friend dd_real sinh(dd_real const& a);
+		friend dd_real cosh(dd_real const& a);
+		friend dd_real tanh(dd_real const& a);
+		friend dd_real atan2(dd_real const& y, dd_real const& x);
+		friend dd_real atan(dd_real const& a);
+		friend dd_real pow(dd_real const& a, dd_real const& b);
+		friend dd_real pow(dd_real const& a, int n);
+
+		friend std::ostream& operator<<(std::ostream& out, dd_real const& a);
+
+	private:
+
+		/**
+		\brief \f$s+e = a+b\f$ exactly, with \f$s\f$ the rounded sum.
+		*/
+		static void TwoSum(double a, double b, double & s, double & e)
+		{
+			s = a + b;
+			double v = s - a;
+			e = (a - (s - v)) + (b - v);
+		}
+
+		/**
+		\brief As TwoSum, requiring \f$|a| \ge |b|\f$.
+		*/
+		static void QuickTwoSum(double a, double b, double & s, double & e)
+		{
+			s = a + b;
+			e = b - (s - a);
+		}
+
+		/**
+		\brief \f$p+e = ab\f$ exactly, with \f$p\f$ the rounded product.
+		*/
+		static void TwoProd(double a, double b, double & p, double & e)
+		{
+			p = a * b;
+		#ifdef FP_FAST_FMA
+			e = std::fma(a, b, -p);
+		#else
+			// Dekker's splitting, cheaper than a software fma
+			double a_hi, a_lo, b_hi, b_lo;
+			Split(a, a_hi, a_lo);
+			Split(b, b_hi, b_lo);
+			e = ((a_hi*b_hi - p) + a_hi*b_lo + a_lo*b_hi) + a_lo*b_lo;
+		#endif
+		}
+
+		static void Split(double a, double & hi, double & lo)
+		{
+			const double splitter = 134217729.0; // 2^27+1
+			double t = splitter*a;
+			hi = t - (t - a);
+			lo = a - hi;
+		}
+
+		double hi_;
+		double lo_;
+	};
+
+
+	/**
+	\brief The complex double-double type, by analogy with dbl and mpfr.
+	*/
+	using dd_complex = std::complex<dd_real>;
+
+
+	/**
+	\brief The number of digits of double-double numbers.
+	*/
+	inline
+	unsigned DoubleDoublePrecision()
+	{
+		return 32;
+	}
+
+	/**
+	\brief Get the precision of a number.
+
+	For double-doubles, this is trivially DoubleDoublePrecision().
+	*/
+	inline
+	unsigned Precision(dd_real const& num)
+	{
+		return DoubleDoublePrecision();
+	}
+
+	inline
+	unsigned Precision(dd_complex const& num)
+	{
+		return DoubleDoublePrecision();
+	}
+
+
+	/**
+	\brief Round a number to double-double.  Exact for doubles.
+	*/
+	inline
+	dd_complex ToDoubleDouble(dbl const& z)
+	{
+		return dd_complex(z.real(), z.imag());
+	}
+
+	inline
+	dd_complex ToDoubleDouble(mpfr const& z)
+	{
+		return dd_complex(dd_real(z.real()), dd_real(z.imag()));
+	}
+
+	/**
+	\brief Convert a double-double number into the type of the second argument, which for mpfr is at the current default precision.
+	*/
+	inline
+	void FromDoubleDouble(dd_complex const& z, dbl & result)
+	{
+		result = dbl(double(z.real()), double(z.imag()));
+	}
+
+	inline
+	void FromDoubleDouble(dd_complex const& z, mpfr & result)
+	{
+		result = mpfr(mpfr_float(z.real()), mpfr_float(z.imag()));
+	}
+
+
+	template <> struct NumTraits<dd_real>
+	{
+		inline static unsigned NumDigits()
+		{
+			return DoubleDoublePrecision();
+		}
+
+		inline static unsigned NumFuzzyDigits()
+		{
+			return DoubleDoublePrecision()-2;
+		}
+
+		inline
+		static unsigned TolToDigits(dd_real tol)
+		{
+			return std::ceil(-std::log10(double(tol)));
+		}
+	};
+
+	template <> struct NumTraits<dd_complex>
+	{
+		inline static unsigned NumDigits()
+		{
+			return DoubleDoublePrecision();
+		}
+
+		inline static unsigned NumFuzzyDigits()
+		{
+			return DoubleDoublePrecision()-2;
+		}
+	};
+
+} // re: namespace bertini
+
+
+
+namespace Eigen {
+
+	/**
+	\brief Permits the use of dd_real in Eigen matrices.  std::complex<dd_real> is then handled by Eigen's own traits for std::complex.
+	*/
+	template<> struct NumTraits<bertini::dd_real> : GenericNumTraits<bertini::dd_real>
+	{
+		typedef bertini::dd_real Real;
+		typedef bertini::dd_real NonInteger;
+		typedef bertini::dd_real Nested;
+		typedef bertini::dd_real Literal;
+		enum {
+			IsComplex = 0,
+			IsInteger = 0,
+			IsSigned = 1,
+			RequireInitialization = 1,
+			ReadCost = 2,
+			AddCost = 20,
+			MulCost = 25
+		};
+
+		inline static Real epsilon()
+		{
+			return Real(4.93038065763132e-32); // 2^-104
+		}
+
+		inline static Real dummy_precision()
+		{
+			return Real(1e-28);
+		}
+
+		inline static Real highest()
+		{
+			return Real(std::numeric_limits<double>::max());
+		}
+
+		inline static Real lowest()
+		{
+			return -highest();
+		}
+
+		inline static Real infinity()
+		{
+			return Real(std::numeric_limits<double>::infinity());
+		}
+
+		inline static Real quiet_NaN()
+		{
+			return Real(std::numeric_limits<double>::quiet_NaN());
+		}
+
+		inline static int digits10()
+		{
+			return 31;
+		}
+
+		inline static int digits()
+		{
+			return 106;
+		}
+	};
+
+} // re: namespace Eigen
+
+#endif
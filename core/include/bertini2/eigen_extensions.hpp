@@ -295,11 +295,15 @@ namespace Eigen {
 #include <Eigen/Eigenvalues>
 #include <Eigen/SVD>
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include "bertini2/double_double.hpp"
 
 namespace bertini {
 
 	template<typename NumType> using Vec = Eigen::Matrix<NumType, Eigen::Dynamic, 1>;
 	template<typename NumType> using Mat = Eigen::Matrix<NumType, Eigen::Dynamic, Eigen::Dynamic>;
+	template<typename NumType> using SparseMat = Eigen::SparseMatrix<NumType>;
 
 	template<typename Derived>
 	unsigned Precision(Eigen::MatrixBase<Derived> const & v)
@@ -429,6 +433,72 @@ namespace bertini {
 		return MatrixSuccessCode::Success;
 	}
 
+	/**
+	\brief Estimate the 1-norm of the inverse of a matrix, from its LU factorization, without forming the inverse.
+
+	This is Hager's method, in the form of Higham's Algorithm 4.1, as in LAPACK's xLACON.  It maximizes \f$\|A^{-1}x\|_1\f$ over \f$\|x\|_1 = 1\f$ by a few steps of gradient ascent, each costing a solve with the factorization and one with its adjoint.  The result is a lower bound, in practice almost always within a factor of a few of the true norm, and often equal to it.
+
+	The work vectors are resized if need be, so passing the same ones call after call avoids allocating.
+
+	\param LU The factorization of the matrix, a PartialPivLU or a SparseLU.
+	\param x A work vector.
+	\param y A work vector.
+	\param max_iterations The number of steps of ascent after the first solve.  Two or three suffice nearly always.
+	\return The estimate of \f$\|A^{-1}\|_1\f$.
+
+	\tparam NumberType The number type of the matrix.
+	\tparam Decomposition The type of the factorization.  Not const for SparseLU, whose adjoint solve needs a mutable factorization.
+	*/
+	template <typename Decomposition, typename NumberType>
+	typename Eigen::NumTraits<NumberType>::Real EstimateInverseNorm(Decomposition & LU,
+	                                                               Vec<NumberType> & x, Vec<NumberType> & y,
+	                                                               unsigned max_iterations = 2)
+	{
+		using RealType = typename Eigen::NumTraits<NumberType>::Real;
+		using std::abs;
+
+		const auto n = LU.rows();
+		x.resize(n);
+		y.resize(n);
+
+		x.setConstant(NumberType(RealType(1)/RealType(n)));
+		y = LU.solve(x);
+		RealType estimate = y.template lpNorm<1>();
+
+		Eigen::Index previous_j = -1;
+		for (unsigned ii = 0; ii < max_iterations; ++ii)
+		{
+			// the signs of y are the gradient of the 1-norm there
+			for (Eigen::Index kk = 0; kk < n; ++kk)
+			{
+				RealType a = abs(y(kk));
+				if (a > RealType(0))
+					x(kk) = y(kk)/a;
+				else
+					x(kk) = NumberType(1);
+			}
+			y = LU.adjoint().solve(x);
+
+			// the best vertex of the unit ball to move to.  landing on the same one twice means a local maximum
+			Eigen::Index j;
+			y.cwiseAbs().maxCoeff(&j);
+			if (j==previous_j)
+				break;
+			previous_j = j;
+
+			x.setZero();
+			x(j) = NumberType(1);
+			y = LU.solve(x);
+
+			RealType next_estimate = y.template lpNorm<1>();
+			if (!(next_estimate > estimate))
+				break;
+			estimate = next_estimate;
+		}
+
+		return estimate;
+	}
+
 	/**
 	\brief Make a Kahan matrix with a given number type.
 	*/
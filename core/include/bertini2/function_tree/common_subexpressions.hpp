@@ -0,0 +1,126 @@
+//This file is part of Bertini 2.
+//
+//common_subexpressions.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//common_subexpressions.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with common_subexpressions.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2015, 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+
+/**
+\file common_subexpressions.hpp
+
+\brief Provides hash-consing of function tree nodes, for the elimination of common subexpressions.
+*/
+
+#ifndef BERTINI_FUNCTION_TREE_COMMON_SUBEXPRESSIONS_HPP
+#define BERTINI_FUNCTION_TREE_COMMON_SUBEXPRESSIONS_HPP
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "bertini2/function_tree.hpp"
+
+namespace bertini {
+namespace node {
+
+	/**
+	\brief A node factory which keeps a single node for each structurally distinct subtree.
+
+	Nodes are keyed on their type, the identities of their children (which are themselves canonical), and the data particular to their type, such as the value of a number, the signs of a sum, or the exponent of an integer power.  A node whose key has been seen before is replaced by the node first seen with that key.  Since the children are canonical before their parent is keyed, structural identity of whole subtrees reduces to identity of keys.
+
+	Variables, functions, and Jacobians are keyed on their own identity, so that distinct ones are never merged, though the trees beneath functions and Jacobians are.  Sums and products are not reordered, so `x*y` and `y*x` remain distinct; reordering would change the order of floating point operations, and hence the computed values.
+
+	\code{.cpp}
+	HashConsingFactory factory;
+	auto a = factory.Make<IntegerPowerOperator>(x, 2);
+	auto b = factory.Make<IntegerPowerOperator>(x, 2); // a==b
+	f->SetRoot(factory.Canonicalize(f->entry_node())); // merges subtrees within f, and with those made previously
+	\endcode
+	*/
+	class HashConsingFactory
+	{
+	public:
+
+		/**
+		\brief Construct a node from the given arguments, and return its canonical representative.
+
+		The arguments should themselves come from this factory, so that they are canonical.
+		*/
+		template<typename NodeT, typename... Args>
+		std::shared_ptr<Node> Make(Args&&... args)
+		{
+			return Canonicalize(std::make_shared<NodeT>(std::forward<Args>(args)...));
+		}
+
+		/**
+		\brief Get the canonical representative of a tree.
+
+		The children of the nodes of the tree are replaced in place by their canonical representatives, so after this call the tree shares all its repeated structure, both internally and with every other tree passed through this factory.  Each node is examined only once per factory, so canonicalizing many trees which share subtrees costs time proportional to their total number of distinct nodes.
+
+		\param n The root of the tree to canonicalize.
+		\return The canonical node structurally identical to n.  This may be n itself.
+		*/
+		std::shared_ptr<Node> Canonicalize(std::shared_ptr<Node> const& n);
+
+		/**
+		\brief The number of distinct nodes the factory has stored, including those keyed on identity.
+		*/
+		size_t NumDistinctNodes() const
+		{
+			return by_structure_.size() + num_keyed_on_identity_;
+		}
+
+		/**
+		\brief Forget all nodes seen so far.
+		*/
+		void Clear()
+		{
+			seen_.clear();
+			by_structure_.clear();
+			num_keyed_on_identity_ = 0;
+		}
+
+	private:
+
+		using Key = std::tuple<std::type_index, std::vector<Node const*>, std::string>;
+
+		std::unordered_map<Node const*, std::pair<std::shared_ptr<Node>, std::shared_ptr<Node> > > seen_; ///< Every node seen, and its canonical representative.
+		std::map<Key, std::shared_ptr<Node> > by_structure_; ///< The canonical nodes, keyed on structure.
+		size_t num_keyed_on_identity_ = 0; ///< The number of variables, functions, and Jacobians seen.
+	};
+
+
+
+	/**
+	\brief Count the distinct nodes reachable from a collection of roots.
+
+	A node reachable along several paths, whether within one tree or from several roots, is counted once.  This is the number of nodes which are evaluated when the roots are evaluated after a Reset.
+	*/
+	size_t CountDistinctNodes(std::vector< std::shared_ptr<Node> > const& roots);
+
+} // namespace node
+} // namespace bertini
+
+
+#endif
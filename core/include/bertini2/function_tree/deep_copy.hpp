@@ -0,0 +1,83 @@
+//This file is part of Bertini 2.
+//
+//deep_copy.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//deep_copy.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with deep_copy.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2015, 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+
+/**
+\file deep_copy.hpp
+
+\brief Provides deep copying of function trees, so that the copies share no nodes, and hence no stored values, with the originals.
+*/
+
+#ifndef BERTINI_FUNCTION_TREE_DEEP_COPY_HPP
+#define BERTINI_FUNCTION_TREE_DEEP_COPY_HPP
+
+#include <unordered_map>
+
+#include "bertini2/function_tree.hpp"
+
+namespace bertini {
+namespace node {
+
+	/**
+	\brief Makes deep copies of function trees.
+
+	Every node reachable from a copied node is copied, variables included.  The copier remembers what it has copied, so a node shared among several trees, or referred to several times within one, is copied once, and the copies share it just as the originals did.  Copy all the trees which should refer to one another, such as a system's functions, subfunctions, and variables, with a single copier.
+
+	\code{.cpp}
+	DeepCopier copier;
+	auto x_copy = copier.Copy(x);
+	auto f_copy = copier.Copy(f); // refers to x_copy wherever f refers to x
+	\endcode
+	*/
+	class DeepCopier
+	{
+	public:
+
+		/**
+		\brief Copy a tree.
+
+		\param n The root of the tree to copy.  May be null, in which case null is returned.
+		\return The copy of n.  Its stored values are copied too, but marked as needing a fresh evaluation.
+		*/
+		std::shared_ptr<Node> Copy(std::shared_ptr<Node> const& n);
+
+		/**
+		\brief Copy a tree, keeping the type of its root.
+		*/
+		template<typename NodeT>
+		std::shared_ptr<NodeT> Copy(std::shared_ptr<NodeT> const& n)
+		{
+			return std::dynamic_pointer_cast<NodeT>(Copy(std::shared_ptr<Node>(n)));
+		}
+
+	private:
+
+		std::unordered_map<Node const*, std::shared_ptr<Node> > copies_; ///< The copy of every node copied so far.
+	};
+
+} // namespace node
+} // namespace bertini
+
+
+#endif
@@ -0,0 +1,87 @@
+//This file is part of Bertini 2.
+//
+//dependencies.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//dependencies.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with dependencies.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2015, 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+
+/**
+\file dependencies.hpp
+
+\brief Provides functions for walking function trees without regard to the types of their nodes, and for finding which nodes depend on which variables.
+*/
+
+#ifndef BERTINI_FUNCTION_TREE_DEPENDENCIES_HPP
+#define BERTINI_FUNCTION_TREE_DEPENDENCIES_HPP
+
+#include <vector>
+
+#include "bertini2/function_tree.hpp"
+
+namespace bertini {
+namespace node {
+
+	/**
+	\brief Get the children of a node, of whatever type.
+
+	For a function or Jacobian, this is its entry node.  Leaves have no children.
+	*/
+	std::vector< std::shared_ptr<Node> > Children(Node const& n);
+
+
+	/**
+	\brief Gather the nodes of a collection of trees, each once, however many roots or paths reach it.
+
+	\param roots The roots of the trees.
+	\return The distinct nodes, in no particular order.
+	*/
+	std::vector< std::shared_ptr<const Node> > DistinctNodes(std::vector< std::shared_ptr<Node> > const& roots);
+
+
+	/**
+	\brief Sort the nodes of a collection of trees by the groups of variables on which they depend.
+
+	A node depends on a group if some variable of the group appears in the tree beneath it.  Nodes depending on no variable at all, such as numbers and sums of numbers, appear in no list, and their values may be kept from one evaluation to the next.  A node reachable from several roots, or along several paths, is found once.
+
+	\param roots The roots of the trees.
+	\param groups The groups of variables.  A variable should appear in at most one group.
+	\return One list per group, holding the nodes which depend on that group, and a final list holding the nodes which depend on variables in none of the groups.  A node depending on several groups appears in each of their lists.
+	*/
+	std::vector< std::vector< std::shared_ptr<const Node> > > DependentNodes(std::vector< std::shared_ptr<Node> > const& roots, std::vector<VariableGroup> const& groups);
+
+
+
+	/**
+	\brief Find which variables appear in each of a collection of trees.
+
+	This is the structural sparsity of the Jacobian of the trees: the derivative of a tree with respect to a variable not appearing in it is identically zero.  The converse need not hold, as in \f$x - x\f$, so the pattern may have a few more entries than the true nonzeros, but never fewer.
+
+	\param roots The roots of the trees.
+	\param variables The variables, in order.
+	\return One list per root, holding in increasing order the indices into `variables` of the variables appearing in that tree.  Variables not in `variables` are ignored.
+	*/
+	std::vector< std::vector<int> > VariablesOccurring(std::vector< std::shared_ptr<Node> > const& roots, VariableGroup const& variables);
+
+} // namespace node
+} // namespace bertini
+
+
+#endif
@@ -0,0 +1,163 @@
+//This file is part of Bertini 2.
+//
+//native_program.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//native_program.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with native_program.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+
+/**
+\file native_program.hpp
+
+\brief Provides the NativeCompiler, which generates C++ source from a StraightLineProgram, compiles it into a shared object, and loads it, and the NativeProgram it produces.
+*/
+
+#ifndef BERTINI_FUNCTION_TREE_NATIVE_PROGRAM_HPP
+#define BERTINI_FUNCTION_TREE_NATIVE_PROGRAM_HPP
+
+#include <array>
+#include <memory>
+#include <string>
+
+#include "bertini2/eigen_extensions.hpp"
+
+namespace bertini {
+
+	class StraightLineProgram;
+
+	/**
+	\brief The instructions of a StraightLineProgram, as machine code loaded from a shared object.
+
+	There is one function per segment of the program: the functions, the Jacobian, and the time derivatives.  Each runs the instructions of its segment on an array of numbers laid out as the memory of the program, with the inputs and constants already in place, so the loading of inputs and the evaluation of constants stay with the StraightLineProgram.  Only double precision is compiled.
+
+	The shared object stays loaded as long as any copy of the pointer to the NativeProgram lives.  Produced by a NativeCompiler.
+	*/
+	class NativeProgram
+	{
+		friend class NativeCompiler;
+
+	public:
+
+		/**
+		\brief Run the instructions of one segment of the program.
+
+		\param segment 0 for the functions, 1 for the Jacobian, 2 for the time derivatives.
+		\param values The memory of the program, with at least NumMemoryLocations() entries.
+		*/
+		void RunSegment(unsigned segment, dbl* values) const
+		{
+			segments_[segment](values);
+		}
+
+		/**
+		\brief The structural hash of the program, under which its shared object is cached.
+		*/
+		std::string const& Hash() const
+		{
+			return hash_;
+		}
+
+		/**
+		\brief The path of the loaded shared object.
+		*/
+		std::string const& LibraryPath() const
+		{
+			return library_path_;
+		}
+
+	private:
+
+		using Segment = void (*)(dbl*);
+
+		std::shared_ptr<void> handle_; ///< From dlopen.  Closes the shared object when the last copy goes.
+		std::array<Segment, 3> segments_;
+		std::string hash_;
+		std::string library_path_;
+	};
+
+
+
+
+	/**
+	\brief Generates straight-line C++ from a StraightLineProgram, compiles it into a shared object with the local compiler, and loads it.
+
+	The generated source has one statement per instruction, with the locations of the operands written in as constants, so the compiled code does no dispatch on the operation and no lookup of operands.  It depends only on the structure of the program: the values of the constants are read from the memory of the program at run time.  Systems which differ only in their coefficients, as in a sweep over parameters, hence share their compiled code.
+
+	Shared objects are cached on disk, in a directory named for the library, under a hash of their source.  Compiling a program whose shared object is already in the cache, from this or an earlier run, only loads it.
+
+	\code{.cpp}
+	auto native = NativeCompiler().Compile(slp);
+	slp.SetNativeProgram(native);
+	\endcode
+	*/
+	class NativeCompiler
+	{
+	public:
+
+		/**
+		\brief Use the cache directory `bertini2_native` in the temporary directory of the system, and the compiler with which Bertini2 was built.
+		*/
+		NativeCompiler();
+
+		/**
+		\param cache_directory The directory in which to keep generated source and shared objects.  Created if it does not exist.
+		\param compiler The command invoking the C++ compiler, with any flags.  Flags for optimization and for making a shared object are added.
+		*/
+		NativeCompiler(std::string const& cache_directory, std::string const& compiler);
+
+		/**
+		\brief Produce the NativeProgram for a StraightLineProgram, loading it from the cache if there, and otherwise generating, compiling, and caching it.
+
+		\throws std::runtime_error if the compiler fails, or the shared object cannot be loaded.
+		*/
+		std::shared_ptr<const NativeProgram> Compile(StraightLineProgram const& slp) const;
+
+		/**
+		\brief The C++ source for a program, as it would be compiled.
+		*/
+		static std::string GenerateSource(StraightLineProgram const& slp);
+
+		/**
+		\brief The structural hash of a program.  Programs with equal hashes compile to the same code.
+		*/
+		static std::string StructuralHash(StraightLineProgram const& slp);
+
+		/**
+		\brief The path at which the shared object for a program is, or would be, cached.
+		*/
+		std::string CachedLibraryPath(StraightLineProgram const& slp) const;
+
+	private:
+
+		/**
+		\brief The generated code, without its first line, which records the hash of the rest.
+		*/
+		static std::string GenerateBody(StraightLineProgram const& slp);
+
+		static std::string HashOf(std::string const& body);
+
+		std::string cache_directory_;
+		std::string compiler_;
+	};
+
+} // namespace bertini
+
+
+#endif
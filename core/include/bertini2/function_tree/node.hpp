@@ -50,6 +50,7 @@
 #include <boost/type_index.hpp>
 
 #include "bertini2/num_traits.hpp"
+#include "bertini2/detail/visitable.hpp"
 
 
 #include <boost/archive/text_oarchive.hpp>
@@ -130,9 +131,11 @@ An interface for all nodes in a function tree, and for a function object as well
 
  Bertini function trees are created using std::shared_ptr's to Node base class, generally. 
 
+ Nodes are visitable, so that operations which need to know the concrete type of every node in a tree, such as compilation into a StraightLineProgram, can be written as visitors rather than as yet more virtual methods.
+
  \brief Abstract base class for the Bertini hybrid-precision (double-multiple) expression tree. 
  */
-class Node
+class Node : public virtual VisitableBase<>
 {
 	friend detail::FreshEvalSelector<dbl>;
 	friend detail::FreshEvalSelector<mpfr>;
@@ -148,8 +151,16 @@ public:
 	 Tells code to run a fresh eval on node next time.
 	*/
 	virtual void Reset() const = 0;
-	
+
 	///////// END PUBLIC PURE METHODS /////////////////
+
+	/**
+	 Tells code to run a fresh eval on this node next time, leaving its children alone.  For resetting only those nodes which depend on changed inputs, rather than whole trees.
+	*/
+	void ResetSelf() const
+	{
+		ResetStoredValues();
+	}
 	
 	
 
@@ -277,6 +288,16 @@ public:
 	 */
 	virtual void precision(unsigned int prec) const = 0;
 
+	/**
+	 Change the precision of the values stored in this node, leaving its children alone.  For changing the precision of a collection of trees node by node, visiting shared nodes once, rather than tree by tree.
+
+	 \param prec the number of digits to change precision to.
+	 */
+	virtual void PrecisionSelf(unsigned int prec) const
+	{
+		std::get< std::pair<mpfr,bool> >(current_value_).first.precision(prec);
+	}
+
 	unsigned precision() const
 	{
 		return std::get<std::pair<mpfr,bool> >(current_value_).first.precision();
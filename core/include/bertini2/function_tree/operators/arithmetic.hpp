@@ -77,6 +77,7 @@ namespace node{
 	class SumOperator : public virtual NaryOperator
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		virtual ~SumOperator() = default;
 		
 		
@@ -132,6 +133,16 @@ namespace node{
 			NaryOperator::AddChild(std::move(child));
 			children_sign_.push_back(sign);
 		}
+
+
+
+		/**
+		 Get the signs of the terms, in correspondence with the children.  true = add, false = subtract.
+		 */
+		std::vector<bool> const& children_sign() const
+		{
+			return children_sign_;
+		}
 		
 		
 		/**
@@ -259,6 +270,7 @@ namespace node{
 	class NegateOperator : public virtual UnaryOperator
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		NegateOperator(const std::shared_ptr<Node> & N) : UnaryOperator(N)
 		{};
@@ -338,6 +350,7 @@ namespace node{
 	class MultOperator : public virtual NaryOperator
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 
 		/**
 		 single-node instantiation.  
@@ -384,6 +397,16 @@ namespace node{
 			NaryOperator::AddChild(std::move(child));
 			children_mult_or_div_.push_back(mult);
 		}
+
+
+
+		/**
+		 Get whether each factor multiplies or divides, in correspondence with the children.  true = mult, false = divide.
+		 */
+		std::vector<bool> const& children_mult_or_div() const
+		{
+			return children_mult_or_div_;
+		}
 		
 		
 		/**
@@ -482,6 +505,7 @@ namespace node{
 	{
 		
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		
 		PowerOperator(const std::shared_ptr<Node> & new_base, const std::shared_ptr<Node> & new_exponent) : base_(new_base), exponent_(new_exponent)
@@ -499,6 +523,23 @@ namespace node{
 		{
 			exponent_ = new_exponent;
 		}
+
+
+		/**
+		 Get the base of the power.
+		 */
+		std::shared_ptr<Node> base() const
+		{
+			return base_;
+		}
+
+		/**
+		 Get the exponent of the power.
+		 */
+		std::shared_ptr<Node> exponent() const
+		{
+			return exponent_;
+		}
 		
 		
 		void Reset() const override;
@@ -612,6 +653,7 @@ namespace node{
 	class IntegerPowerOperator : public virtual UnaryOperator
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		
 		
@@ -650,6 +692,12 @@ namespace node{
 		 Compute the degree of a node.  For integer power functions, the degree is the product of the degree of the argument, and the power.
 		 */
 		int Degree(std::shared_ptr<Variable> const& v = nullptr) const override;
+
+
+		/**
+		 Compute the degree with respect to a variable group.  As for a single variable, the product of the degree of the argument and the power, rather than the sum of the degrees in the variables, which is too large when the argument is not a monomial.
+		 */
+		int Degree(VariableGroup const& vars) const override;
 		
 		
 		bool IsHomogeneous(std::shared_ptr<Variable> const& v = nullptr) const override
@@ -749,6 +797,7 @@ namespace node{
 	class SqrtOperator : public  virtual UnaryOperator
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		SqrtOperator(const std::shared_ptr<Node> & N) : UnaryOperator(N)
 		{};
@@ -816,6 +865,7 @@ namespace node{
 	class ExpOperator : public  virtual UnaryOperator
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		ExpOperator(const std::shared_ptr<Node> & N) : UnaryOperator(N)
 		{};
@@ -871,6 +921,7 @@ namespace node{
 	class LogOperator : public  virtual UnaryOperator
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		LogOperator(const std::shared_ptr<Node> & N) : UnaryOperator(N)
 		{};
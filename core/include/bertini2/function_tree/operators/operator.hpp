@@ -255,11 +255,28 @@ namespace node{
 		{
 			return children_.size();
 		}
+
+		/**
+		 Replace the child at the given index.
+		 */
+		void SetChild(size_t index, std::shared_ptr<Node> new_child)
+		{
+			children_[index] = std::move(new_child);
+		}
 		
 		std::shared_ptr<Node> first_child() const
 		{
 			return children_[0];
 		}
+
+
+		/**
+		 Get the children of this operator, in the order in which they were added.
+		 */
+		std::vector< std::shared_ptr<Node> > const& children() const
+		{
+			return children_;
+		}
 		
 		
 		
@@ -280,6 +297,15 @@ namespace node{
 				iter->precision(prec);
 		}
 
+		/**
+		 Change the precision of the values stored in this operator, including its temporaries, leaving its children alone.
+		 */
+		void PrecisionSelf(unsigned int prec) const override
+		{
+			Node::PrecisionSelf(prec);
+			this->PrecisionChangeSpecific(prec);
+		}
+
 		
 		
 	protected:
@@ -96,6 +96,7 @@ namespace node{
 	class SinOperator : public virtual TrigOperator
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		SinOperator(const std::shared_ptr<Node> & N) : TrigOperator(N), UnaryOperator(N)
 		{};
@@ -162,6 +163,7 @@ namespace node{
 	class ArcSinOperator : public  virtual TrigOperator
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		
 		
@@ -234,6 +236,7 @@ namespace node{
 	class CosOperator : public  virtual TrigOperator
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		
 		
@@ -305,6 +308,7 @@ namespace node{
 	class ArcCosOperator : public  virtual TrigOperator
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		
 		
@@ -383,6 +387,7 @@ namespace node{
 	class TanOperator : public  virtual TrigOperator
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		
 		
@@ -453,6 +458,7 @@ namespace node{
 	class ArcTanOperator : public  virtual TrigOperator
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		
 		
@@ -59,6 +59,7 @@ namespace node{
 	class Function : public virtual NamedSymbol
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		
 		
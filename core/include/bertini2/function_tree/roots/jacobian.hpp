@@ -62,6 +62,7 @@ namespace node{
 			friend detail::FreshEvalSelector<dbl>;
 			friend detail::FreshEvalSelector<mpfr>;
 		public:
+			BERTINI_DEFAULT_VISITABLE()
 				
 				
 				
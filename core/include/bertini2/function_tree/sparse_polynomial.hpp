@@ -0,0 +1,476 @@
+//This file is part of Bertini 2.
+//
+//sparse_polynomial.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//sparse_polynomial.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with sparse_polynomial.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+
+/**
+\file sparse_polynomial.hpp
+
+\brief Provides the SparsePolynomialSystem, the functions of a polynomial system expanded into sums of monomials, and the PolynomialExpander which produces one.
+*/
+
+#ifndef BERTINI_FUNCTION_TREE_SPARSE_POLYNOMIAL_HPP
+#define BERTINI_FUNCTION_TREE_SPARSE_POLYNOMIAL_HPP
+
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "bertini2/eigen_extensions.hpp"
+#include "bertini2/function_tree.hpp"
+
+namespace bertini {
+
+	/**
+	\brief The functions of a system, polynomial in its variables and path variable, expanded into sums of monomials, for fast evaluation.
+
+	Each function is stored as a list of terms, each term a coefficient and a list of (input, exponent) pairs for the inputs appearing in it, the inputs being the variables followed by the path variable.  Evaluation first tabulates the powers of each input, up to the largest exponent with which it appears anywhere in the system.  The table is shared by all the terms of all the functions, so that each term costs one multiplication per input appearing in it.
+
+	The functions, the Jacobian, and the derivatives with respect to the path variable are computed together in one pass over the terms.  Only the entries of the Jacobian for the variables appearing in each function are stored, so that its cost grows with the number of those, rather than with the product of the numbers of functions and variables.  For each term, the products of its leading and of its trailing factors give, with one more multiplication each, its derivatives with respect to all its inputs, without dividing by them.  Functions requested after derivatives at the same point are not recomputed.
+
+	The coefficients are constant expressions formed from the numbers of the original trees, and are evaluated from these, in double precision once, and in multiple precision whenever the program is at a new precision.  As for the StraightLineProgram, the multiple-precision coefficients at each precision are kept, so that returning to a precision costs nothing.
+
+	Input values are read from the variable nodes, whenever evaluation begins after a call to Invalidate.  It is the responsibility of the owner (typically a System) to Invalidate when the values of the variables change.
+
+	The memory of evaluation is mutable, so a single SparsePolynomialSystem may not be evaluated by two threads at once.
+	*/
+	class SparsePolynomialSystem
+	{
+		friend class PolynomialExpander;
+
+	public:
+
+		/**
+		\brief The number of functions.
+		*/
+		size_t NumFunctions() const
+		{
+			return function_term_ends_.size();
+		}
+
+		/**
+		\brief The number of variables.  Does not include the path variable.
+		*/
+		size_t NumVariables() const
+		{
+			return num_variables_;
+		}
+
+		/**
+		\brief The total number of terms, over all the functions.
+		*/
+		size_t NumTerms() const
+		{
+			return term_factor_ends_.size();
+		}
+
+		/**
+		\brief Whether the last input is the path variable.
+		*/
+		bool HavePathVariable() const
+		{
+			return inputs_.size() > num_variables_;
+		}
+
+
+		/**
+		\brief Mark the values stored in the memory as stale, so that the next evaluation reads the inputs afresh from their nodes.
+		*/
+		void Invalidate() const
+		{
+			std::get<Memory<dbl> >(memory_).Invalidate();
+			std::get<Memory<mpfr> >(memory_).Invalidate();
+		}
+
+
+		/**
+		\brief Evaluate the functions, at the values of the inputs in their nodes.
+
+		\param function_values The values.  Must have at least NumFunctions() entries.  Only the first NumFunctions() are written.
+		*/
+		template<typename Derived>
+		void EvalInPlace(Eigen::MatrixBase<Derived> & function_values) const
+		{
+			using T = typename Derived::Scalar;
+			RunValues<T>();
+
+			const auto& values = std::get<Memory<T> >(memory_).values;
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+				function_values(ii) = values[ii];
+		}
+
+		/**
+		\brief Evaluate the Jacobian of the functions with respect to the variables.
+
+		\param J The Jacobian.  Must have at least NumFunctions() rows and NumVariables() columns.  Only those are written.
+		*/
+		template<typename Derived>
+		void JacobianInPlace(Eigen::MatrixBase<Derived> & J) const
+		{
+			using T = typename Derived::Scalar;
+			RunDerivatives<T>();
+
+			const auto& memory = std::get<Memory<T> >(memory_);
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+			{
+				for (size_t jj = 0; jj < num_variables_; ++jj)
+					J(ii,jj) = memory.zero;
+				for (size_t kk = ii==0 ? 0 : jacobian_row_ends_[ii-1]; kk < jacobian_row_ends_[ii]; ++kk)
+					J(ii,jacobian_columns_[kk]) = memory.jacobian[kk];
+			}
+		}
+
+		/**
+		\brief Evaluate the Jacobian of the functions with respect to the variables, into a sparse matrix, touching only its nonzero entries.
+
+		\param J The Jacobian.  Must have at least NumFunctions() rows and NumVariables() columns, and its sparsity pattern must contain that of the polynomials, which holds for patterns computed from the trees the polynomials were expanded from.  Entries of the pattern outside that of the polynomials are not written.
+		*/
+		template<typename T>
+		void SparseJacobianInPlace(SparseMat<T> & J) const
+		{
+			RunDerivatives<T>();
+
+			const auto& jacobian = std::get<Memory<T> >(memory_).jacobian;
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+				for (size_t kk = ii==0 ? 0 : jacobian_row_ends_[ii-1]; kk < jacobian_row_ends_[ii]; ++kk)
+					J.coeffRef(ii,jacobian_columns_[kk]) = jacobian[kk];
+		}
+
+		/**
+		\brief The number of entries of the Jacobian which are not identically zero.
+		*/
+		size_t NumJacobianNonzeros() const
+		{
+			return jacobian_columns_.size();
+		}
+
+		/**
+		\brief The exponents of the variables in the terms of a function, its support.
+
+		\param function_index The function.
+		\return One vector of NumVariables() exponents per term, in the order of the terms.  The path variable is left out.
+		*/
+		std::vector<std::vector<unsigned> > Exponents(size_t function_index) const
+		{
+			std::vector<std::vector<unsigned> > exponents;
+			for (size_t term = function_index==0 ? 0 : function_term_ends_[function_index-1]; term < function_term_ends_[function_index]; ++term)
+			{
+				exponents.emplace_back(num_variables_, 0);
+				for (size_t factor = term==0 ? 0 : term_factor_ends_[term-1]; factor < term_factor_ends_[term]; ++factor)
+					if (factor_inputs_[factor] < num_variables_)
+						exponents.back()[factor_inputs_[factor]] = factor_exponents_[factor];
+			}
+			return exponents;
+		}
+
+		/**
+		\brief Evaluate the derivatives of the functions with respect to the path variable.
+
+		\param ds_dt The derivatives.  Must have at least NumFunctions() entries.  Only the first NumFunctions() are written.
+		\throws std::runtime_error if there is no path variable.
+		*/
+		template<typename Derived>
+		void TimeDerivativeInPlace(Eigen::MatrixBase<Derived> & ds_dt) const
+		{
+			if (!HavePathVariable())
+				throw std::runtime_error("computing time derivatives of sparse polynomials with no path variable");
+
+			using T = typename Derived::Scalar;
+			RunDerivatives<T>();
+
+			const auto& time_derivatives = std::get<Memory<T> >(memory_).time_derivatives;
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+				ds_dt(ii) = time_derivatives[ii];
+		}
+
+
+		/**
+		\brief Change the precision of the multiple-precision memory.
+
+		The coefficients are evaluated from their expressions at the new precision, the first time the polynomials are at it, and kept for a return to it later.
+		*/
+		void precision(unsigned new_precision) const;
+
+		/**
+		\brief Get the precision of the multiple-precision memory.
+		*/
+		unsigned precision() const
+		{
+			return precision_;
+		}
+
+	private:
+
+		/**
+		\brief The memory for evaluation in one number type.
+		*/
+		template<typename T>
+		struct Memory
+		{
+			std::vector<T> coefficients; ///< One per term.
+			std::vector<T> exponents; ///< The exponent of each factor, as a number, to multiply its derivative.
+			std::vector<T> powers; ///< The powers of the inputs, from the zeroth up, consecutively by input.
+			std::vector<T> values; ///< The values of the functions.
+			std::vector<T> jacobian; ///< The entries of the Jacobian which are not identically zero, row by row.  See jacobian_row_ends_.
+			std::vector<T> time_derivatives; ///< The derivatives with respect to the path variable.
+			std::vector<T> leading_products; ///< For a term, the products of the coefficient and its leading factors.
+			T term; ///< A temporary.
+			T trailing_product; ///< A temporary.
+			T zero; ///< Zero, at the precision of the memory.
+			T one; ///< One, at the precision of the memory.
+			bool values_are_current = false;
+			bool derivatives_are_current = false;
+
+			void Invalidate()
+			{
+				values_are_current = false;
+				derivatives_are_current = false;
+			}
+		};
+
+
+		/**
+		\brief Size the memory of one number type, and fill in the entries which never change: the zeroth powers, and the exponents.
+		*/
+		template<typename T>
+		void SetUpMemory() const
+		{
+			auto& memory = std::get<Memory<T> >(memory_);
+			memory.zero = T(0);
+			memory.one = T(1);
+
+			memory.powers.assign(power_offsets_.back(), memory.zero);
+			for (size_t ii = 0; ii < inputs_.size(); ++ii)
+				memory.powers[power_offsets_[ii]] = memory.one;
+
+			memory.exponents.resize(factor_exponents_.size());
+			for (size_t ii = 0; ii < factor_exponents_.size(); ++ii)
+				memory.exponents[ii] = T(factor_exponents_[ii]);
+
+			memory.values.assign(NumFunctions(), memory.zero);
+			memory.jacobian.assign(jacobian_columns_.size(), memory.zero);
+			memory.time_derivatives.assign(NumFunctions(), memory.zero);
+			memory.leading_products.assign(max_factors_per_term_+1, memory.zero);
+			memory.term = memory.zero;
+			memory.trailing_product = memory.zero;
+			memory.Invalidate();
+		}
+
+
+		/**
+		\brief Tabulate the powers of the inputs, reading the inputs from their nodes.
+		*/
+		template<typename T>
+		void TabulatePowers() const
+		{
+			auto& powers = std::get<Memory<T> >(memory_).powers;
+			for (size_t ii = 0; ii < inputs_.size(); ++ii)
+			{
+				const auto first = power_offsets_[ii];
+				inputs_[ii]->EvalInPlace<T>(powers[first+1]);
+				for (auto jj = first+2; jj < power_offsets_[ii+1]; ++jj)
+				{
+					powers[jj] = powers[jj-1];
+					powers[jj] *= powers[first+1];
+				}
+			}
+		}
+
+
+		/**
+		\brief Compute the values of the functions, if not already current.
+		*/
+		template<typename T>
+		void RunValues() const
+		{
+			auto& memory = std::get<Memory<T> >(memory_);
+			if (memory.values_are_current)
+				return;
+
+			TabulatePowers<T>();
+
+			size_t term = 0, factor = 0;
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+			{
+				auto& value = memory.values[ii];
+				value = memory.zero;
+				for (; term < function_term_ends_[ii]; ++term)
+				{
+					memory.term = memory.coefficients[term];
+					for (; factor < term_factor_ends_[term]; ++factor)
+						memory.term *= memory.powers[factor_power_locations_[factor]];
+					value += memory.term;
+				}
+			}
+
+			memory.values_are_current = true;
+		}
+
+
+		/**
+		\brief Compute the values of the functions, their Jacobian, and their derivatives with respect to the path variable, in one pass, if not already current.
+		*/
+		template<typename T>
+		void RunDerivatives() const
+		{
+			auto& memory = std::get<Memory<T> >(memory_);
+			if (memory.derivatives_are_current)
+				return;
+
+			TabulatePowers<T>();
+
+			for (auto& iter : memory.jacobian)
+				iter = memory.zero;
+			for (auto& iter : memory.time_derivatives)
+				iter = memory.zero;
+
+			auto& leading = memory.leading_products;
+			size_t term = 0;
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+			{
+				auto& value = memory.values[ii];
+				value = memory.zero;
+				for (; term < function_term_ends_[ii]; ++term)
+				{
+					const auto first = term==0 ? 0 : term_factor_ends_[term-1];
+					const auto num_factors = term_factor_ends_[term] - first;
+
+					leading[0] = memory.coefficients[term];
+					for (size_t jj = 0; jj < num_factors; ++jj)
+					{
+						leading[jj+1] = leading[jj];
+						leading[jj+1] *= memory.powers[factor_power_locations_[first+jj]];
+					}
+					value += leading[num_factors];
+
+					// the derivative with respect to the input of factor jj is the product of the leading factors, the trailing factors, and the derivative of factor jj itself
+					memory.trailing_product = memory.one;
+					for (size_t jj = num_factors; jj-- > 0; )
+					{
+						const auto factor = first+jj;
+						memory.term = leading[jj];
+						memory.term *= memory.trailing_product;
+						memory.term *= memory.powers[factor_power_locations_[factor]-1];
+						memory.term *= memory.exponents[factor];
+
+						const auto input = factor_inputs_[factor];
+						if (input < num_variables_)
+							memory.jacobian[factor_jacobian_locations_[factor]] += memory.term;
+						else
+							memory.time_derivatives[ii] += memory.term;
+
+						memory.trailing_product *= memory.powers[factor_power_locations_[factor]];
+					}
+				}
+			}
+
+			memory.values_are_current = true;
+			memory.derivatives_are_current = true;
+		}
+
+
+		std::vector<size_t> function_term_ends_; ///< For each function, one past its last term.
+		std::vector<size_t> term_factor_ends_; ///< For each term, one past its last factor.
+		std::vector<unsigned> factor_inputs_; ///< For each factor, the index of its input.
+		std::vector<unsigned> factor_exponents_; ///< For each factor, the exponent of its input.
+		std::vector<size_t> factor_power_locations_; ///< For each factor, the location of its power in the table of powers.
+		std::vector<size_t> power_offsets_; ///< For each input, where its powers begin in the table, and one more entry, for the size of the table.
+		std::vector<size_t> factor_jacobian_locations_; ///< For each factor in a variable, the location of the entry of the Jacobian to which its derivative contributes.
+		std::vector<size_t> jacobian_row_ends_; ///< For each function, one past the last of its entries of the Jacobian.
+		std::vector<unsigned> jacobian_columns_; ///< For each entry of the Jacobian, its column, increasing within each row.
+		size_t max_factors_per_term_ = 0;
+
+		std::vector< std::shared_ptr<const node::Node> > coefficients_; ///< The expression for the coefficient of each term.
+		std::vector< std::shared_ptr<const node::Variable> > inputs_; ///< The variables, then the path variable if there is one.
+		size_t num_variables_ = 0;
+
+		mutable std::tuple< Memory<dbl>, Memory<mpfr> > memory_;
+		mutable unsigned precision_ = DefaultPrecision();
+		mutable std::map<unsigned, std::vector<mpfr> > coefficients_at_precision_; ///< The multiple-precision coefficients at the precisions the polynomials have left, by precision.
+		mutable bool have_mpfr_coefficients_ = false; ///< Whether the multiple-precision coefficients have been computed, at precision_.
+	};
+
+
+
+
+	/**
+	\brief Expands the functions of a system into a SparsePolynomialSystem, if they are polynomial in the variables and path variable.
+
+	Sums, products, negations, integer powers with nonnegative exponents, and powers by constant nonnegative integers, of the inputs and of constants, are expanded.  Any subtree not involving an input is a constant, whatever its operators, and becomes part of a coefficient.  Division is allowed only by constants.  The subtrees of shared nodes, such as subfunctions and explicit parameters, are expanded once.
+
+	Expansion fails, rather than throws, if a function involves an input non-polynomially, involves a variable which is not an input (such as an implicit parameter), or would expand to more than a given number of terms.
+
+	\code{.cpp}
+	SparsePolynomialSystem polynomials;
+	if (PolynomialExpander().Expand(functions, variables, path_variable, polynomials))
+		polynomials.EvalInPlace(f);
+	\endcode
+	*/
+	class PolynomialExpander
+	{
+	public:
+
+		/**
+		\param max_terms The largest number of terms an expansion may have, in any function or intermediate expression.  Guards against expansions of products of sums growing out of hand.
+		*/
+		PolynomialExpander(size_t max_terms = 10000) : max_terms_(max_terms)
+		{}
+
+		/**
+		\brief Expand a collection of functions.
+
+		\param functions The functions to expand.
+		\param variables The variables, in the order of the columns of the Jacobian.
+		\param path_variable The path variable, if any.  May be nullptr.
+		\param[out] result The expanded functions, with multiple-precision memory at the current default precision.  Unchanged if expansion fails.
+		\return Whether the functions were expanded.
+		*/
+		bool Expand(std::vector< std::shared_ptr<node::Function> > const& functions,
+		            VariableGroup const& variables,
+		            std::shared_ptr<node::Variable> const& path_variable,
+		            SparsePolynomialSystem & result);
+
+	private:
+
+		using Monomial = std::vector< std::pair<unsigned, unsigned> >; ///< (input, exponent) pairs, by increasing input.
+		using Polynomial = std::map< Monomial, std::shared_ptr<node::Node> >; ///< Coefficients, by monomial.
+
+		Polynomial const& ExpandNode(std::shared_ptr<node::Node> const& n);
+		bool IsConstant(std::shared_ptr<node::Node> const& n);
+
+		Polynomial Sum(std::vector< std::pair<Polynomial const*, bool> > const& summands) const;
+		Polynomial Product(Polynomial const& a, Polynomial const& b) const;
+		Polynomial Power(Polynomial const& a, unsigned exponent) const;
+
+		size_t max_terms_;
+		std::shared_ptr<node::Node> one_;
+		std::unordered_map<node::Variable const*, unsigned> input_index_;
+		std::unordered_map<node::Node const*, Polynomial> expanded_;
+		std::unordered_map<node::Node const*, bool> is_constant_;
+	};
+
+} // re: namespace bertini
+
+
+#endif
@@ -0,0 +1,1218 @@
+//This file is part of Bertini 2.
+//
+//straight_line_program.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//straight_line_program.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with straight_line_program.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2015, 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+
+/**
+\file straight_line_program.hpp
+
+\brief Provides the StraightLineProgram, a flattened form of a collection of function trees, and the SLPCompiler which produces one.
+*/
+
+#ifndef BERTINI_FUNCTION_TREE_STRAIGHT_LINE_PROGRAM_HPP
+#define BERTINI_FUNCTION_TREE_STRAIGHT_LINE_PROGRAM_HPP
+
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "bertini2/eigen_extensions.hpp"
+#include "bertini2/function_tree.hpp"
+#include "bertini2/function_tree/native_program.hpp"
+
+namespace bertini {
+
+	/**
+	\brief A compiled, flat form of a collection of function trees, for fast repeated evaluation.
+
+	A straight-line program is a topologically sorted list of instructions, each of which reads from one or two locations in a contiguous array of numbers, and writes its result into another location of the array.  Evaluation is a single loop over the instructions, in contrast to the recursive evaluation of a function tree, which pays for a virtual call, a pointer chase, and a check of the cached value at every node.
+
+	A program is produced by the SLPCompiler from the functions of a system, and optionally from their Jacobian trees.  Shared subtrees and repeated instructions appear only once on the tape, and the zeros and ones produced by differentials are folded away when compiling Jacobian entries.
+
+	The instructions are arranged in three consecutive segments:
+
+	1. the functions,
+	2. the Jacobian entries, and
+	3. the derivatives with respect to the path variable.
+
+	Each segment may read values computed in an earlier one, so computing the Jacobian also computes the function values, and these are re-used if the functions are subsequently requested at the same point.
+
+	Derivatives may also be computed without the second and third segments, by forward-mode or reverse-mode automatic differentiation of the first.  See ForwardJacobianInPlace and ReverseJacobianInPlace.
+
+	Input values are read from the variable nodes of the compiled trees, whenever evaluation begins after a call to Invalidate.  It is the responsibility of the owner of the program (typically a System) to Invalidate it when the values of the variables change.
+
+	Like the nodes of a function tree, the program stores its values in mutable memory, so a single program may not be evaluated by two threads at once.
+	*/
+	class StraightLineProgram
+	{
+		friend class SLPCompiler;
+		friend class NativeCompiler;
+
+	public:
+
+		/**
+		\brief The operations which may appear on the tape.
+		*/
+		enum class Operation : unsigned char
+		{
+			Add, Subtract, Multiply, Divide, Negate, IntegerPower, Power,
+			Sqrt, Exp, Log, Sin, Cos, Tan, ArcSin, ArcCos, ArcTan
+		};
+
+		/**
+		\brief A single instruction.  Writes `op(in1, in2)` into location `out`.
+
+		For unary operations, `in2` is unused.  `exponent` is used only by IntegerPower.
+		*/
+		struct Instruction
+		{
+			Operation op;
+			size_t out;
+			size_t in1;
+			size_t in2;
+			int exponent;
+		};
+
+		static constexpr size_t ZeroLocation = 0; ///< The location of the constant zero.
+		static constexpr size_t OneLocation = 1; ///< The location of the constant one.
+
+
+		/**
+		\brief The number of functions compiled into the program.
+		*/
+		size_t NumFunctions() const
+		{
+			return function_locations_.size();
+		}
+
+		/**
+		\brief The number of variables with respect to which the program was compiled.  Does not include the path variable.
+		*/
+		size_t NumVariables() const
+		{
+			return variable_locations_.size();
+		}
+
+		/**
+		\brief The total number of instructions on the tape, across all segments.
+		*/
+		size_t NumInstructions() const
+		{
+			return instructions_.size();
+		}
+
+		/**
+		\brief The number of locations in the memory of the program.  This includes the inputs, the constants, and all intermediate results.
+		*/
+		size_t NumMemoryLocations() const
+		{
+			return num_locations_;
+		}
+
+		/**
+		\brief Whether the Jacobian of the functions was compiled into the program.
+		*/
+		bool HaveJacobian() const
+		{
+			return have_jacobian_;
+		}
+
+		/**
+		\brief Whether the derivatives of the functions with respect to the path variable were compiled into the program.
+		*/
+		bool HaveTimeDerivative() const
+		{
+			return have_time_derivative_;
+		}
+
+		/**
+		\brief Whether a path variable was given when compiling the program.  If so, forward-mode differentiation computes the time derivatives together with the Jacobian.
+		*/
+		bool HavePathVariable() const
+		{
+			return have_path_variable_;
+		}
+
+		/**
+		\brief Get read access to the tape.
+		*/
+		std::vector<Instruction> const& Instructions() const
+		{
+			return instructions_;
+		}
+
+
+		/**
+		\brief Run the instructions in double precision through compiled code, rather than by interpreting the tape.
+
+		The program must be the one from which the NativeProgram was compiled, or one of the same structure.  Multiple precision still interprets the tape.
+
+		\param native The compiled code, from a NativeCompiler.  nullptr returns to interpreting the tape.
+		*/
+		void SetNativeProgram(std::shared_ptr<const NativeProgram> const& native)
+		{
+			native_program_ = native;
+			Invalidate();
+		}
+
+		/**
+		\brief Whether double precision evaluation runs through compiled code.
+		*/
+		bool HaveNativeProgram() const
+		{
+			return static_cast<bool>(native_program_);
+		}
+
+
+		/**
+		\brief Indicate that the values of the input variables have changed, so that the next evaluation must start from the beginning of the tape.
+		*/
+		void Invalidate() const
+		{
+			std::get<Memory<dbl> >(memory_).Invalidate();
+			std::get<Memory<mpfr> >(memory_).Invalidate();
+		}
+
+
+		/**
+		\brief Evaluate the functions, at the current values of the variables.
+
+		\param function_values The vector into which to write.  Must have at least NumFunctions() entries.
+		*/
+		template<typename Derived>
+		void EvalInPlace(Eigen::MatrixBase<Derived> & function_values) const
+		{
+			using T = typename Derived::Scalar;
+
+			RunThrough<T>(function_segment_end_);
+
+			const auto& values = std::get<Memory<T> >(memory_).values;
+			for (size_t ii = 0; ii < function_locations_.size(); ++ii)
+				function_values(ii) = values[function_locations_[ii]];
+		}
+
+
+		/**
+		\brief Evaluate the Jacobian of the functions with respect to the variables, at the current values of the variables.
+
+		\param J The matrix into which to write.  Must have at least NumFunctions() rows, and NumVariables() columns.
+		\throws std::runtime_error if the Jacobian was not compiled into the program.
+		*/
+		template<typename Derived>
+		void JacobianInPlace(Eigen::MatrixBase<Derived> & J) const
+		{
+			using T = typename Derived::Scalar;
+
+			if (!have_jacobian_)
+				throw std::runtime_error("evaluating jacobian of straight line program, but the jacobian was not compiled");
+
+			RunThrough<T>(jacobian_segment_end_);
+
+			const auto& values = std::get<Memory<T> >(memory_).values;
+			const auto num_vars = NumVariables();
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+				for (size_t jj = 0; jj < num_vars; ++jj)
+					J(ii,jj) = values[jacobian_locations_[ii*num_vars+jj]];
+		}
+
+
+		/**
+		\brief Evaluate the Jacobian of the functions, at the current values of the variables, into the nonzero entries of a sparse matrix.
+
+		Only the entries in the sparsity pattern of J are written, and of those, only the ones in its first NumFunctions() rows.
+
+		\param J The matrix into which to write.  Must have at least NumFunctions() rows and exactly NumVariables() columns.
+		\throws std::runtime_error if the Jacobian was not compiled into the program.
+		*/
+		template<typename T>
+		void SparseJacobianInPlace(SparseMat<T> & J) const
+		{
+			if (!have_jacobian_)
+				throw std::runtime_error("evaluating jacobian of straight line program, but the jacobian was not compiled");
+
+			RunThrough<T>(jacobian_segment_end_);
+
+			const auto& values = std::get<Memory<T> >(memory_).values;
+			const auto num_vars = NumVariables();
+			for (Eigen::Index jj = 0; jj < J.outerSize(); ++jj)
+				for (typename SparseMat<T>::InnerIterator iter(J,jj); iter; ++iter)
+					if (static_cast<size_t>(iter.row()) < NumFunctions())
+						iter.valueRef() = values[jacobian_locations_[iter.row()*num_vars+jj]];
+		}
+
+
+		/**
+		\brief Evaluate the derivatives of the functions with respect to the path variable, at the current values of the variables.
+
+		\param ds_dt The vector into which to write.  Must have at least NumFunctions() entries.
+		\throws std::runtime_error if the time derivatives were not compiled into the program.
+		*/
+		template<typename Derived>
+		void TimeDerivativeInPlace(Eigen::MatrixBase<Derived> & ds_dt) const
+		{
+			using T = typename Derived::Scalar;
+
+			if (!have_time_derivative_)
+				throw std::runtime_error("evaluating time derivative of straight line program, but the time derivative was not compiled");
+
+			RunThrough<T>(time_derivative_segment_end_);
+
+			const auto& values = std::get<Memory<T> >(memory_).values;
+			for (size_t ii = 0; ii < time_derivative_locations_.size(); ++ii)
+				ds_dt(ii) = values[time_derivative_locations_[ii]];
+		}
+
+
+		/**
+		\brief Evaluate the Jacobian of the functions by forward-mode automatic differentiation, at the current values of the variables.
+
+		A tangent vector, with one entry per variable and one for the path variable, is carried along with the value of each instruction of the function segment.  A single sweep over the tape thus computes the values of the functions, the Jacobian, and the time derivatives, without the symbolic Jacobian trees.  The sweep is done once per point, so a call to ForwardTimeDerivativeInPlace at the same point costs nothing more.
+
+		The program need not have been compiled with the Jacobian.
+
+		\param J The matrix into which to write.  Must have at least NumFunctions() rows, and NumVariables() columns.
+		*/
+		template<typename Derived>
+		void ForwardJacobianInPlace(Eigen::MatrixBase<Derived> & J) const
+		{
+			using T = typename Derived::Scalar;
+
+			RunTangents<T>();
+
+			const auto& tangents = std::get<Memory<T> >(memory_).tangents;
+			const auto num_directions = NumTangentDirections();
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+				for (size_t jj = 0; jj < NumVariables(); ++jj)
+					J(ii,jj) = tangents[function_locations_[ii]*num_directions + jj];
+		}
+
+
+		/**
+		\brief Evaluate the derivatives of the functions with respect to the path variable by forward-mode automatic differentiation, at the current values of the variables.
+
+		\param ds_dt The vector into which to write.  Must have at least NumFunctions() entries.
+		\throws std::runtime_error if the program was compiled without a path variable.
+		*/
+		template<typename Derived>
+		void ForwardTimeDerivativeInPlace(Eigen::MatrixBase<Derived> & ds_dt) const
+		{
+			using T = typename Derived::Scalar;
+
+			if (!have_path_variable_)
+				throw std::runtime_error("evaluating time derivative of straight line program by forward mode, but no path variable was compiled");
+
+			RunTangents<T>();
+
+			const auto& tangents = std::get<Memory<T> >(memory_).tangents;
+			const auto num_directions = NumTangentDirections();
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+				ds_dt(ii) = tangents[function_locations_[ii]*num_directions + NumVariables()];
+		}
+
+
+		/**
+		\brief Evaluate the Jacobian of the functions by reverse-mode (adjoint) automatic differentiation, at the current values of the variables.
+
+		After a forward sweep to compute the values of the intermediates, the adjoints are swept backward over the tape once per function, starting from the instruction which computes that function.  Each sweep produces a whole row of the Jacobian, together with the derivative with respect to the path variable.  For systems with many more variables than functions, this is much cheaper than forward mode.  As for forward mode, the sweeps are done once per point, and the program need not have been compiled with the Jacobian.
+
+		\param J The matrix into which to write.  Must have at least NumFunctions() rows, and NumVariables() columns.
+		*/
+		template<typename Derived>
+		void ReverseJacobianInPlace(Eigen::MatrixBase<Derived> & J) const
+		{
+			using T = typename Derived::Scalar;
+
+			RunAdjoints<T>();
+
+			const auto& gradients = std::get<Memory<T> >(memory_).gradients;
+			const auto num_directions = NumTangentDirections();
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+				for (size_t jj = 0; jj < NumVariables(); ++jj)
+					J(ii,jj) = gradients[ii*num_directions + jj];
+		}
+
+
+		/**
+		\brief Evaluate the derivatives of the functions with respect to the path variable by reverse-mode automatic differentiation, at the current values of the variables.
+
+		\param ds_dt The vector into which to write.  Must have at least NumFunctions() entries.
+		\throws std::runtime_error if the program was compiled without a path variable.
+		*/
+		template<typename Derived>
+		void ReverseTimeDerivativeInPlace(Eigen::MatrixBase<Derived> & ds_dt) const
+		{
+			using T = typename Derived::Scalar;
+
+			if (!have_path_variable_)
+				throw std::runtime_error("evaluating time derivative of straight line program by reverse mode, but no path variable was compiled");
+
+			RunAdjoints<T>();
+
+			const auto& gradients = std::get<Memory<T> >(memory_).gradients;
+			const auto num_directions = NumTangentDirections();
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+				ds_dt(ii) = gradients[ii*num_directions + NumVariables()];
+		}
+
+
+		/**
+		\brief Evaluate the functions at many points at once, in a single sweep over the tape.
+
+		The memory for a batch is laid out structure-of-arrays: the values of a location at all the points are consecutive.  Each instruction is hence dispatched once per batch rather than once per point, and its loop over the points runs over contiguous memory, which the compiler can vectorize in double precision.
+
+		The memory used for single points, by EvalInPlace and the like, is left alone, as are the values of the variable nodes.
+
+		Besides dbl and mpfr, batches may be evaluated in dd_complex, double-double precision, for which they are the only means of evaluation.  The constants are rounded to double-double from multiple precision when the program is compiled.
+
+		\param points The points, one per column, with NumVariables() rows.
+		\param times The values of the path variable, one per point.  Ignored if the program was compiled without a path variable.
+		\param function_values The matrix into which to write, with one column per point.  Must have at least NumFunctions() rows.
+
+		\throws std::runtime_error if the number of rows of points is not NumVariables(), or there is a path variable and the number of times differs from the number of points.
+		*/
+		template<typename T, typename Derived>
+		void EvalBatch(Mat<T> const& points, Vec<T> const& times, Eigen::MatrixBase<Derived> & function_values) const
+		{
+			RunBatch(points, times);
+
+			const auto& values = std::get<BatchMemory<T> >(batch_memory_).values;
+			const size_t num_points = points.cols();
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+				for (size_t kk = 0; kk < num_points; ++kk)
+					function_values(ii,kk) = values[function_locations_[ii]*num_points + kk];
+		}
+
+
+		/**
+		\brief Evaluate the Jacobian of the functions at many points at once, by forward-mode automatic differentiation in a single sweep over the tape.
+
+		As EvalBatch, with a tangent vector carried along with the values, as for ForwardJacobianInPlace.  The program need not have been compiled with the Jacobian.
+
+		\param points The points, one per column, with NumVariables() rows.
+		\param times The values of the path variable, one per point.  Ignored if the program was compiled without a path variable.
+		\param jacobians The matrices into which to write, one per point.  Each must have at least NumFunctions() rows, and NumVariables() columns.
+
+		\throws std::runtime_error as EvalBatch, or if the number of matrices differs from the number of points.
+		*/
+		template<typename T>
+		void JacobianBatch(Mat<T> const& points, Vec<T> const& times, std::vector<Mat<T> > & jacobians) const
+		{
+			if (jacobians.size()!=static_cast<size_t>(points.cols()))
+				throw std::runtime_error("evaluating jacobian of straight line program at a batch of points, but the number of jacobians (" + std::to_string(jacobians.size()) + ") doesn't match the number of points (" + std::to_string(points.cols()) + ")");
+
+			RunBatch(points, times);
+			RunTangentBatch<T>(points.cols());
+
+			const auto& tangents = std::get<BatchMemory<T> >(batch_memory_).tangents;
+			const size_t num_points = points.cols();
+			const auto num_directions = NumTangentDirections();
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+				for (size_t jj = 0; jj < NumVariables(); ++jj)
+				{
+					const T* d = &tangents[(function_locations_[ii]*num_directions + jj)*num_points];
+					for (size_t kk = 0; kk < num_points; ++kk)
+						jacobians[kk](ii,jj) = d[kk];
+				}
+		}
+
+
+		/**
+		\brief As JacobianBatch, also writing the values of the functions, and their derivatives with respect to the path variable, all from the same sweep.
+
+		\param function_values The matrix into which to write the values, with one column per point.  Must have at least NumFunctions() rows.
+		\param time_derivatives The matrix into which to write the time derivatives, with one column per point.  Must have at least NumFunctions() rows.
+
+		\throws std::runtime_error as JacobianBatch, or if the program was compiled without a path variable.
+		*/
+		template<typename T, typename DerivedF, typename DerivedT>
+		void JacobianBatch(Mat<T> const& points, Vec<T> const& times, std::vector<Mat<T> > & jacobians,
+		                   Eigen::MatrixBase<DerivedF> & function_values, Eigen::MatrixBase<DerivedT> & time_derivatives) const
+		{
+			if (!have_path_variable_)
+				throw std::runtime_error("evaluating time derivative of straight line program at a batch of points, but no path variable was compiled");
+
+			JacobianBatch(points, times, jacobians);
+
+			const auto& memory = std::get<BatchMemory<T> >(batch_memory_);
+			const size_t num_points = points.cols();
+			const auto num_directions = NumTangentDirections();
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+			{
+				const T* d = &memory.tangents[(function_locations_[ii]*num_directions + NumVariables())*num_points];
+				for (size_t kk = 0; kk < num_points; ++kk)
+				{
+					function_values(ii,kk) = memory.values[function_locations_[ii]*num_points + kk];
+					time_derivatives(ii,kk) = d[kk];
+				}
+			}
+		}
+
+
+		/**
+		\brief Whether reverse-mode differentiation is expected to be cheaper than forward mode for this program.
+
+		Forward mode costs one pass over the function segment per variable (and path variable), while reverse mode costs, for each function, one pass over the part of the tape which precedes it.  The comparison is of these instruction counts, with the reverse sweeps weighted double, since forward mode dispatches each instruction once for all directions, and the reverse sweep once per function.  The weight was measured with the jacobian_crossover timing test.
+		*/
+		bool PreferReverseMode() const
+		{
+			return 2*reverse_sweep_length_ < NumTangentDirections()*function_segment_end_;
+		}
+
+
+		/**
+		\brief Change the precision of the multiple-precision memory of the program.
+
+		Constants are re-computed from their nodes at the new precision, the first time the program is at it.  The memory at each precision is kept when the program leaves it, and taken up again on return, so that changing among a few precisions, as adaptive precision tracking does, costs no more than a swap.
+		*/
+		void precision(unsigned new_precision) const;
+
+		/**
+		\brief Get the precision of the multiple-precision memory of the program.
+		*/
+		unsigned precision() const
+		{
+			return precision_;
+		}
+
+	private:
+
+		/**
+		\brief The memory for one number type, together with how far along the tape it has been evaluated.
+		*/
+		template<typename T>
+		struct Memory
+		{
+			std::vector<T> values;
+			size_t evaluated_through = 0;
+			bool is_current = false;
+
+			std::vector<T> tangents; ///< The tangent vectors for forward-mode differentiation, NumTangentDirections() per location.  Allocated on first use.
+			bool tangents_are_current = false;
+
+			std::vector<T> adjoints; ///< The adjoints for reverse-mode differentiation, one per location.  Allocated on first use.
+			std::vector<T> gradients; ///< The results of reverse-mode differentiation, NumTangentDirections() per function.
+			bool gradients_are_current = false;
+
+			void Invalidate()
+			{
+				is_current = false;
+				tangents_are_current = false;
+				gradients_are_current = false;
+			}
+		};
+
+
+		/**
+		\brief The memory for evaluating a batch of points of one number type.  Entries are stored location-major, with the entries for the points consecutive.
+		*/
+		template<typename T>
+		struct BatchMemory
+		{
+			std::vector<T> values; ///< The values, at NumMemoryLocations() locations.
+			std::vector<T> tangents; ///< The tangent vectors, NumTangentDirections() per location, for forward-mode differentiation.
+		};
+
+
+		/**
+		\brief The number of directions carried in forward-mode differentiation.  One for each variable, and one for the path variable if there is one.
+		*/
+		size_t NumTangentDirections() const
+		{
+			return NumVariables() + (have_path_variable_ ? 1 : 0);
+		}
+
+
+		/**
+		\brief Run the tape up to (but not including) instruction `end`, starting from wherever evaluation last stopped.
+		*/
+		template<typename T>
+		void RunThrough(size_t end) const
+		{
+			auto& memory = std::get<Memory<T> >(memory_);
+
+			if (!memory.is_current)
+			{
+				for (const auto& iter : inputs_)
+					iter.second->EvalInPlace<T>(memory.values[iter.first]);
+				memory.evaluated_through = 0;
+				memory.is_current = true;
+			}
+
+			auto& values = memory.values;
+			if (RunNative(values, memory.evaluated_through, end))
+				return;
+
+			for (; memory.evaluated_through < end; ++memory.evaluated_through)
+				Execute(instructions_[memory.evaluated_through], values);
+		}
+
+
+		/**
+		\brief Run the segments of the tape up to `end` through the NativeProgram, if there is one.  Only double precision is compiled.
+
+		\return Whether the segments were run.
+		*/
+		template<typename T>
+		bool RunNative(std::vector<T> &, size_t &, size_t) const
+		{
+			return false;
+		}
+
+		bool RunNative(std::vector<dbl> & values, size_t & evaluated_through, size_t end) const
+		{
+			if (!native_program_)
+				return false;
+
+			// evaluation always stops at the end of a segment
+			const size_t bounds[] = {0, function_segment_end_, jacobian_segment_end_, time_derivative_segment_end_};
+			for (unsigned segment = 0; segment < 3; ++segment)
+				if (evaluated_through <= bounds[segment] && bounds[segment] < bounds[segment+1] && bounds[segment+1] <= end)
+					native_program_->RunSegment(segment, values.data());
+
+			evaluated_through = std::max(evaluated_through, end);
+			return true;
+		}
+
+
+		/**
+		\brief Run the function segment of the tape, carrying tangent vectors along with the values.
+		*/
+		template<typename T>
+		void RunTangents() const
+		{
+			RunThrough<T>(function_segment_end_);
+
+			auto& memory = std::get<Memory<T> >(memory_);
+			if (memory.tangents_are_current)
+				return;
+
+			const auto num_directions = NumTangentDirections();
+			auto& tangents = memory.tangents;
+			if (tangents.size()!=num_locations_*num_directions)
+			{
+				// copying the zero from memory gives the tangents the precision of the program.  only the inputs have nonzero tangents which are not computed by the tape, and these never change, so are seeded only here.
+				tangents.assign(num_locations_*num_directions, memory.values[ZeroLocation]);
+				for (size_t jj = 0; jj < num_directions; ++jj)
+					tangents[inputs_[jj].first*num_directions + jj] = memory.values[OneLocation];
+			}
+
+			const auto& values = memory.values;
+			for (size_t ii = 0; ii < function_segment_end_; ++ii)
+				ExecuteTangent(instructions_[ii], values, tangents, num_directions);
+
+			memory.tangents_are_current = true;
+		}
+
+
+		/**
+		\brief Run the function segment of the tape forward, and then the adjoints backward from each function.
+		*/
+		template<typename T>
+		void RunAdjoints() const
+		{
+			RunThrough<T>(function_segment_end_);
+
+			auto& memory = std::get<Memory<T> >(memory_);
+			if (memory.gradients_are_current)
+				return;
+
+			const auto num_directions = NumTangentDirections();
+			const auto& values = memory.values;
+			const auto& zero = values[ZeroLocation];
+			auto& adjoints = memory.adjoints;
+			auto& gradients = memory.gradients;
+
+			if (adjoints.size()!=num_locations_)
+			{
+				adjoints.assign(num_locations_, zero);
+				gradients.assign(NumFunctions()*num_directions, zero);
+			}
+
+			for (size_t ii = 0; ii < NumFunctions(); ++ii)
+			{
+				// only the locations preceding the function can contribute to it.
+				const auto function_location = function_locations_[ii];
+				for (size_t jj = 0; jj <= function_location; ++jj)
+					adjoints[jj] = zero;
+				adjoints[function_location] = values[OneLocation];
+
+				for (auto kk = function_instruction_ends_[ii]; kk > 0; --kk)
+					ExecuteAdjoint(instructions_[kk-1], values, adjoints);
+
+				for (size_t jj = 0; jj < num_directions; ++jj)
+					gradients[ii*num_directions + jj] = inputs_[jj].first <= function_location ? adjoints[inputs_[jj].first] : zero;
+			}
+
+			memory.gradients_are_current = true;
+		}
+
+
+		/**
+		\brief Load a batch of points into the batch memory, together with the constants, and run the function segment of the tape on them.
+		*/
+		template<typename T>
+		void RunBatch(Mat<T> const& points, Vec<T> const& times) const
+		{
+			if (static_cast<size_t>(points.rows())!=NumVariables())
+				throw std::runtime_error("evaluating straight line program at a batch of points, but the number of rows of the points (" + std::to_string(points.rows()) + ") doesn't match the number of variables (" + std::to_string(NumVariables()) + ")");
+			if (have_path_variable_ && times.size()!=points.cols())
+				throw std::runtime_error("evaluating straight line program at a batch of points, but the number of times (" + std::to_string(times.size()) + ") doesn't match the number of points (" + std::to_string(points.cols()) + ")");
+
+			const size_t num_points = points.cols();
+			const auto& single = std::get<Memory<T> >(memory_).values;
+			auto& values = std::get<BatchMemory<T> >(batch_memory_).values;
+
+			// copying the zero from the memory for single points gives the batch the precision of the program
+			values.assign(num_locations_*num_points, single[ZeroLocation]);
+
+			auto broadcast = [&values, num_points](size_t location, T const& value)
+				{
+					for (size_t kk = 0; kk < num_points; ++kk)
+						values[location*num_points + kk] = value;
+				};
+
+			broadcast(OneLocation, single[OneLocation]);
+			for (const auto& iter : constants_)
+				broadcast(iter.first, single[iter.first]);
+
+			for (size_t jj = 0; jj < inputs_.size(); ++jj)
+			{
+				const auto location = inputs_[jj].first;
+				if (jj < NumVariables())
+					for (size_t kk = 0; kk < num_points; ++kk)
+						values[location*num_points + kk] = points(jj,kk);
+				else if (jj==NumVariables() && have_path_variable_)
+					for (size_t kk = 0; kk < num_points; ++kk)
+						values[location*num_points + kk] = times(kk);
+				else
+				{
+					T value = single[ZeroLocation];
+					InputValue(*inputs_[jj].second, value);
+					broadcast(location, value);
+				}
+			}
+
+			for (size_t ii = 0; ii < function_segment_end_; ++ii)
+				ExecuteBatch(instructions_[ii], values.data(), num_points);
+		}
+
+
+		/**
+		\brief Get the value of an input other than the variables and path variable, such as an implicit parameter, from its node.
+		*/
+		template<typename T>
+		static void InputValue(node::Variable const& input, T & value)
+		{
+			input.EvalInPlace<T>(value);
+		}
+
+		/**
+		\brief Nodes cannot be evaluated in double-double, so the value is rounded from multiple precision.
+		*/
+		static void InputValue(node::Variable const& input, dd_complex & value)
+		{
+			value = ToDoubleDouble(input.Eval<mpfr>());
+		}
+
+
+		/**
+		\brief Run the function segment of the tape on the batch memory, carrying tangent vectors along with the values.  The values must be current, by RunBatch.
+		*/
+		template<typename T>
+		void RunTangentBatch(size_t num_points) const
+		{
+			auto& memory = std::get<BatchMemory<T> >(batch_memory_);
+			const auto& values = memory.values;
+			auto& tangents = memory.tangents;
+			const auto num_directions = NumTangentDirections();
+
+			tangents.assign(num_locations_*num_directions*num_points, values[ZeroLocation*num_points]);
+			for (size_t jj = 0; jj < num_directions; ++jj)
+				for (size_t kk = 0; kk < num_points; ++kk)
+					tangents[(inputs_[jj].first*num_directions + jj)*num_points + kk] = values[OneLocation*num_points];
+
+			for (size_t ii = 0; ii < function_segment_end_; ++ii)
+				ExecuteTangentBatch(instructions_[ii], values.data(), tangents.data(), num_directions, num_points);
+		}
+
+
+		/**
+		\brief Execute a single instruction.  Results are computed in place in the output location, to avoid temporaries.
+		*/
+		template<typename T>
+		static void Execute(Instruction const& instruction, std::vector<T> & values)
+		{
+			T& out = values[instruction.out];
+			T const& a = values[instruction.in1];
+
+			switch (instruction.op)
+			{
+				case Operation::Add:
+					out = a; out += values[instruction.in2]; break;
+				case Operation::Subtract:
+					out = a; out -= values[instruction.in2]; break;
+				case Operation::Multiply:
+					out = a; out *= values[instruction.in2]; break;
+				case Operation::Divide:
+					out = a; out /= values[instruction.in2]; break;
+				case Operation::Negate:
+					out = -a; break;
+				case Operation::IntegerPower:
+					out = pow(a, instruction.exponent); break;
+				case Operation::Power:
+					out = pow(a, values[instruction.in2]); break;
+				case Operation::Sqrt:
+					out = sqrt(a); break;
+				case Operation::Exp:
+					out = exp(a); break;
+				case Operation::Log:
+					out = log(a); break;
+				case Operation::Sin:
+					out = sin(a); break;
+				case Operation::Cos:
+					out = cos(a); break;
+				case Operation::Tan:
+					out = tan(a); break;
+				case Operation::ArcSin:
+					out = asin(a); break;
+				case Operation::ArcCos:
+					out = acos(a); break;
+				case Operation::ArcTan:
+					out = atan(a); break;
+			}
+		}
+
+
+		/**
+		\brief Execute a single instruction at each point of a batch.  The switch is outside the loops over the points, so that it is paid once per batch.
+		*/
+		template<typename T>
+		static void ExecuteBatch(Instruction const& instruction, T* values, size_t num_points)
+		{
+			T* out = values + instruction.out*num_points;
+			T const* a = values + instruction.in1*num_points;
+			T const* b = values + instruction.in2*num_points;
+
+			switch (instruction.op)
+			{
+				case Operation::Add:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						{out[kk] = a[kk]; out[kk] += b[kk];}
+					break;
+				case Operation::Subtract:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						{out[kk] = a[kk]; out[kk] -= b[kk];}
+					break;
+				case Operation::Multiply:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						{out[kk] = a[kk]; out[kk] *= b[kk];}
+					break;
+				case Operation::Divide:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						{out[kk] = a[kk]; out[kk] /= b[kk];}
+					break;
+				case Operation::Negate:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						out[kk] = -a[kk];
+					break;
+				case Operation::IntegerPower:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						out[kk] = pow(a[kk], instruction.exponent);
+					break;
+				case Operation::Power:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						out[kk] = pow(a[kk], b[kk]);
+					break;
+				case Operation::Sqrt:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						out[kk] = sqrt(a[kk]);
+					break;
+				case Operation::Exp:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						out[kk] = exp(a[kk]);
+					break;
+				case Operation::Log:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						out[kk] = log(a[kk]);
+					break;
+				case Operation::Sin:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						out[kk] = sin(a[kk]);
+					break;
+				case Operation::Cos:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						out[kk] = cos(a[kk]);
+					break;
+				case Operation::Tan:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						out[kk] = tan(a[kk]);
+					break;
+				case Operation::ArcSin:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						out[kk] = asin(a[kk]);
+					break;
+				case Operation::ArcCos:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						out[kk] = acos(a[kk]);
+					break;
+				case Operation::ArcTan:
+					for (size_t kk = 0; kk < num_points; ++kk)
+						out[kk] = atan(a[kk]);
+					break;
+			}
+		}
+
+
+		/**
+		\brief The derivative of a unary operation (including IntegerPower, and Power with its constant exponent), at the value of its operand.
+
+		The rules are those of the Differentiate functions of the nodes, so that the results agree with those of the Jacobian trees.  In particular, as for PowerOperator, the exponent of a Power is taken to be constant.
+		*/
+		template<typename T>
+		static T UnaryDerivative(Instruction const& instruction, std::vector<T> const& values)
+		{
+			return UnaryDerivative(instruction, values[instruction.out], values[instruction.in1], values[instruction.in2]);
+		}
+
+
+		/**
+		\brief The derivative of a unary operation, given the values of its output and operands, rather than the memory holding them.
+		*/
+		template<typename T>
+		static T UnaryDerivative(Instruction const& instruction, T const& out, T const& a, T const& b)
+		{
+			switch (instruction.op)
+			{
+				case Operation::IntegerPower:
+					return T(instruction.exponent)*pow(a, instruction.exponent-1);
+				case Operation::Power:
+					return b*pow(a, b-T(1));
+				case Operation::Sqrt:
+					return T(1)/(T(2)*out);
+				case Operation::Exp:
+					return out;
+				case Operation::Log:
+					return T(1)/a;
+				case Operation::Sin:
+					return cos(a);
+				case Operation::Cos:
+					return -sin(a);
+				case Operation::Tan:
+					return T(1)/pow(cos(a),2);
+				case Operation::ArcSin:
+					return T(1)/sqrt(T(1) - pow(a,2));
+				case Operation::ArcCos:
+					return -T(1)/sqrt(T(1) - pow(a,2));
+				case Operation::ArcTan:
+					return T(1)/(T(1) + pow(a,2));
+				default:
+					throw std::runtime_error("requesting unary derivative of a binary straight line program operation");
+			}
+		}
+
+
+		/**
+		\brief Propagate the tangent vectors through a single instruction, whose value has already been computed.
+		*/
+		template<typename T>
+		static void ExecuteTangent(Instruction const& instruction, std::vector<T> const& values, std::vector<T> & tangents, size_t num_directions)
+		{
+			T* d_out = &tangents[instruction.out*num_directions];
+			T const* d_a = &tangents[instruction.in1*num_directions];
+			T const* d_b = &tangents[instruction.in2*num_directions];
+
+			T const& a = values[instruction.in1];
+			T const& b = values[instruction.in2];
+
+			switch (instruction.op)
+			{
+				case Operation::Add:
+					for (size_t kk = 0; kk < num_directions; ++kk)
+						{d_out[kk] = d_a[kk]; d_out[kk] += d_b[kk];}
+					break;
+				case Operation::Subtract:
+					for (size_t kk = 0; kk < num_directions; ++kk)
+						{d_out[kk] = d_a[kk]; d_out[kk] -= d_b[kk];}
+					break;
+				case Operation::Multiply:
+					for (size_t kk = 0; kk < num_directions; ++kk)
+						d_out[kk] = a*d_b[kk] + b*d_a[kk];
+					break;
+				case Operation::Divide:
+					for (size_t kk = 0; kk < num_directions; ++kk)
+						d_out[kk] = (d_a[kk] - values[instruction.out]*d_b[kk])/b;
+					break;
+				case Operation::Negate:
+					for (size_t kk = 0; kk < num_directions; ++kk)
+						d_out[kk] = -d_a[kk];
+					break;
+				default:
+				{
+					T scale = UnaryDerivative(instruction, values);
+					for (size_t kk = 0; kk < num_directions; ++kk)
+						d_out[kk] = scale*d_a[kk];
+				}
+			}
+		}
+
+
+		/**
+		\brief Propagate the tangent vectors through a single instruction, at each point of a batch.  Tangents are stored location-major, then direction, then point.
+		*/
+		template<typename T>
+		static void ExecuteTangentBatch(Instruction const& instruction, T const* values, T* tangents, size_t num_directions, size_t num_points)
+		{
+			const auto stride = num_directions*num_points;
+			T* d_out = tangents + instruction.out*stride;
+			T const* d_a = tangents + instruction.in1*stride;
+			T const* d_b = tangents + instruction.in2*stride;
+
+			T const* out = values + instruction.out*num_points;
+			T const* a = values + instruction.in1*num_points;
+			T const* b = values + instruction.in2*num_points;
+
+			switch (instruction.op)
+			{
+				case Operation::Add:
+					for (size_t ll = 0; ll < stride; ++ll)
+						{d_out[ll] = d_a[ll]; d_out[ll] += d_b[ll];}
+					break;
+				case Operation::Subtract:
+					for (size_t ll = 0; ll < stride; ++ll)
+						{d_out[ll] = d_a[ll]; d_out[ll] -= d_b[ll];}
+					break;
+				case Operation::Multiply:
+					for (size_t jj = 0; jj < num_directions; ++jj)
+						for (size_t kk = 0; kk < num_points; ++kk)
+							d_out[jj*num_points+kk] = a[kk]*d_b[jj*num_points+kk] + b[kk]*d_a[jj*num_points+kk];
+					break;
+				case Operation::Divide:
+					for (size_t jj = 0; jj < num_directions; ++jj)
+						for (size_t kk = 0; kk < num_points; ++kk)
+							d_out[jj*num_points+kk] = (d_a[jj*num_points+kk] - out[kk]*d_b[jj*num_points+kk])/b[kk];
+					break;
+				case Operation::Negate:
+					for (size_t ll = 0; ll < stride; ++ll)
+						d_out[ll] = -d_a[ll];
+					break;
+				default:
+					for (size_t kk = 0; kk < num_points; ++kk)
+					{
+						T scale = UnaryDerivative(instruction, out[kk], a[kk], b[kk]);
+						for (size_t jj = 0; jj < num_directions; ++jj)
+							d_out[jj*num_points+kk] = scale*d_a[jj*num_points+kk];
+					}
+			}
+		}
+
+
+		/**
+		\brief Propagate the adjoint of the output of a single instruction back to its operands.
+		*/
+		template<typename T>
+		static void ExecuteAdjoint(Instruction const& instruction, std::vector<T> const& values, std::vector<T> & adjoints)
+		{
+			T const& adjoint = adjoints[instruction.out];
+			T& a_bar = adjoints[instruction.in1];
+			T& b_bar = adjoints[instruction.in2];
+
+			switch (instruction.op)
+			{
+				case Operation::Add:
+					a_bar += adjoint; b_bar += adjoint; break;
+				case Operation::Subtract:
+					a_bar += adjoint; b_bar -= adjoint; break;
+				case Operation::Multiply:
+					a_bar += adjoint*values[instruction.in2]; b_bar += adjoint*values[instruction.in1]; break;
+				case Operation::Divide:
+					a_bar += adjoint/values[instruction.in2]; b_bar -= adjoint*values[instruction.out]/values[instruction.in2]; break;
+				case Operation::Negate:
+					a_bar -= adjoint; break;
+				default:
+					a_bar += adjoint*UnaryDerivative(instruction, values);
+			}
+		}
+
+
+		std::vector<Instruction> instructions_; ///< The tape.
+		size_t function_segment_end_ = 0; ///< One past the last instruction needed for the functions.
+		size_t jacobian_segment_end_ = 0; ///< One past the last instruction needed for the Jacobian.
+		size_t time_derivative_segment_end_ = 0; ///< One past the last instruction needed for the time derivatives.
+		bool have_jacobian_ = false;
+		bool have_time_derivative_ = false;
+		bool have_path_variable_ = false; ///< Whether the input following the variables is the path variable.
+
+		size_t num_locations_ = 2;
+
+		std::vector<size_t> variable_locations_; ///< The locations of the variables, in the order given at compile time.
+		std::vector<size_t> function_locations_; ///< The locations of the function values.
+		std::vector<size_t> jacobian_locations_; ///< The locations of the Jacobian entries, row-major.
+		std::vector<size_t> time_derivative_locations_; ///< The locations of the time derivatives of the functions.
+		std::vector<size_t> function_instruction_ends_; ///< For each function, one past the instruction which computes it.  The reverse sweep for the function starts here.
+		size_t reverse_sweep_length_ = 0; ///< The total number of instructions in the reverse sweeps over all functions.
+
+		std::vector< std::pair<size_t, std::shared_ptr<const node::Variable> > > inputs_; ///< Where to load the value of each variable.
+		std::vector< std::pair<size_t, std::shared_ptr<const node::Node> > > constants_; ///< Where to store the value of each constant.
+
+		mutable std::tuple< Memory<dbl>, Memory<mpfr>, Memory<dd_complex> > memory_; ///< The double-double memory holds only the constants, for batches.
+		mutable std::tuple< BatchMemory<dbl>, BatchMemory<mpfr>, BatchMemory<dd_complex> > batch_memory_; ///< For EvalBatch and JacobianBatch.
+		mutable unsigned precision_ = DefaultPrecision();
+		mutable std::map<unsigned, Memory<mpfr> > memory_at_precision_; ///< The multiple-precision memory at the precisions the program has left, by precision.
+		mutable bool have_mpfr_constants_ = false; ///< Whether the constants in the multiple-precision memory have been computed, at precision_.
+
+		std::shared_ptr<const NativeProgram> native_program_; ///< Compiled code for the tape, in double precision.  Optional.
+	};
+
+
+
+
+	/**
+	\brief Visitor which flattens function trees into a StraightLineProgram.
+
+	Nodes referred to more than once are compiled once.  In addition, each instruction is hashed on its operation and operands, so that identical instructions arising from distinct but equal subtrees are also emitted only once.
+
+	When compiling Jacobian trees, each tree is compiled once per variable, with differentials becoming the constants zero or one.  Operations on these constants are folded away, so that each Jacobian entry costs only the arithmetic which actually depends on its variable.
+
+	\code{.cpp}
+	SLPCompiler compiler;
+	StraightLineProgram slp = compiler.Compile(functions, variables, path_variable, jacobians);
+	\endcode
+	*/
+	class SLPCompiler : public VisitorBase,
+		public Visitor<node::Variable>,
+		public Visitor<node::Differential>,
+		public Visitor<node::Integer>,
+		public Visitor<node::Float>,
+		public Visitor<node::Rational>,
+		public Visitor<node::special_number::Pi>,
+		public Visitor<node::special_number::E>,
+		public Visitor<node::Function>,
+		public Visitor<node::Jacobian>,
+		public Visitor<node::SumOperator>,
+		public Visitor<node::MultOperator>,
+		public Visitor<node::NegateOperator>,
+		public Visitor<node::PowerOperator>,
+		public Visitor<node::IntegerPowerOperator>,
+		public Visitor<node::SqrtOperator>,
+		public Visitor<node::ExpOperator>,
+		public Visitor<node::LogOperator>,
+		public Visitor<node::SinOperator>,
+		public Visitor<node::ArcSinOperator>,
+		public Visitor<node::CosOperator>,
+		public Visitor<node::ArcCosOperator>,
+		public Visitor<node::TanOperator>,
+		public Visitor<node::ArcTanOperator>
+	{
+	public:
+		using Operation = StraightLineProgram::Operation;
+
+		/**
+		\brief Compile a collection of functions, and optionally their Jacobians, into a straight-line program.
+
+		\param functions The functions to compile.
+		\param variables The variables, in the order of the columns of the Jacobian.
+		\param path_variable The path variable, if any.  May be nullptr.
+		\param jacobians The Jacobian trees of the functions.  If empty, the Jacobian and time derivatives are not compiled.
+		\return The compiled program, with mpfr memory at the current default precision.
+		\throws std::runtime_error if the number of Jacobians is nonzero and differs from the number of functions, or if a node of an unknown type is encountered.
+		*/
+		StraightLineProgram Compile(std::vector< std::shared_ptr<node::Function> > const& functions,
+		                            VariableGroup const& variables,
+		                            std::shared_ptr<node::Variable> const& path_variable = nullptr,
+		                            std::vector< std::shared_ptr<node::Jacobian> > const& jacobians = {});
+
+		void Visit(node::Variable const& n) override;
+		void Visit(node::Differential const& n) override;
+		void Visit(node::Integer const& n) override;
+		void Visit(node::Float const& n) override;
+		void Visit(node::Rational const& n) override;
+		void Visit(node::special_number::Pi const& n) override;
+		void Visit(node::special_number::E const& n) override;
+		void Visit(node::Function const& n) override;
+		void Visit(node::Jacobian const& n) override;
+		void Visit(node::SumOperator const& n) override;
+		void Visit(node::MultOperator const& n) override;
+		void Visit(node::NegateOperator const& n) override;
+		void Visit(node::PowerOperator const& n) override;
+		void Visit(node::IntegerPowerOperator const& n) override;
+		void Visit(node::SqrtOperator const& n) override;
+		void Visit(node::ExpOperator const& n) override;
+		void Visit(node::LogOperator const& n) override;
+		void Visit(node::SinOperator const& n) override;
+		void Visit(node::ArcSinOperator const& n) override;
+		void Visit(node::CosOperator const& n) override;
+		void Visit(node::ArcCosOperator const& n) override;
+		void Visit(node::TanOperator const& n) override;
+		void Visit(node::ArcTanOperator const& n) override;
+
+	private:
+
+		/**
+		\brief Compile a node, or look up where it was already compiled.
+
+		\return The location in memory of the value of the node.
+		*/
+		size_t CompileNode(std::shared_ptr<node::Node> const& n);
+
+		/**
+		\brief Add an instruction to the tape, unless it folds away or duplicates an existing one.
+
+		\return The location in memory of the result of the instruction.
+		*/
+		size_t AddInstruction(Operation op, size_t in1, size_t in2 = 0, int exponent = 0);
+
+		/**
+		\brief Make a location for a constant leaf of a tree.
+		*/
+		void AddConstant();
+
+		/**
+		\brief Make a location for the input value of a variable.
+		*/
+		size_t AddInput(std::shared_ptr<const node::Variable> const& v);
+
+		/**
+		\brief Compile the child of a unary operator, and apply op to it.
+		*/
+		void UnaryOperation(node::UnaryOperator const& n, Operation op);
+
+
+		StraightLineProgram slp_; ///< The program being compiled.
+
+		std::shared_ptr<node::Node> current_node_; ///< The node currently being visited.
+		std::shared_ptr<node::Variable> diff_variable_; ///< The variable of differentiation for the Jacobian entry being compiled.
+		size_t result_; ///< The location of the result of the most recent visit.
+		bool have_result_;
+		bool depends_on_differential_; ///< Whether the node being compiled contains a differential, and hence must be recompiled for each variable.
+
+		std::map<node::Node const*, size_t> compiled_nodes_; ///< Nodes whose location does not depend on the variable of differentiation.
+		std::map<node::Node const*, size_t> compiled_differential_nodes_; ///< Nodes whose location depends on the current variable of differentiation.
+		std::map<node::Variable const*, size_t> input_locations_;
+		std::map<std::tuple<Operation, size_t, size_t, int>, size_t> instruction_locations_; ///< For de-duplicating instructions.
+	};
+
+} // namespace bertini
+
+
+#endif
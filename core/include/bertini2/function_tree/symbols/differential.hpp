@@ -62,6 +62,7 @@ namespace node{
 	class Differential : public virtual NamedSymbol
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 
 
@@ -220,18 +221,20 @@ namespace node{
 		void save(Archive & ar, const unsigned int version) const
 		{
 			ar & boost::serialization::base_object<NamedSymbol>(*this);
-			ar & differential_variable_;
-			// ar & const_cast<std::shared_ptr<const Variable> >(differential_variable_);
+			auto v = std::const_pointer_cast<Variable>(differential_variable_);
+			ar & v;
 		}
 		
 		template<class Archive>
 		void load(Archive & ar, const unsigned int version)
 		{
 			ar & boost::serialization::base_object<NamedSymbol>(*this);
-			ar & std::const_pointer_cast<Variable>(differential_variable_);
+			std::shared_ptr<Variable> v;
+			ar & v;
+			differential_variable_ = v;
 		}
 		
-		// BOOST_SERIALIZATION_SPLIT_MEMBER()
+		BOOST_SERIALIZATION_SPLIT_MEMBER()
 
 	};
 
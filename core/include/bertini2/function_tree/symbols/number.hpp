@@ -153,6 +153,7 @@ namespace node{
 	class Integer : public virtual Number
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 		
 		explicit
 		Integer(int val) : true_value_(val)
@@ -239,6 +240,7 @@ namespace node{
 	class Float : public virtual Number
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 
 		explicit
 		Float(mpfr const& val) : highest_precision_value_(val)
@@ -325,6 +327,7 @@ namespace node{
 	class Rational : public virtual Number
 	{
 	public:
+		BERTINI_DEFAULT_VISITABLE()
 
 		using mpq_rational = bertini::mpq_rational;
 
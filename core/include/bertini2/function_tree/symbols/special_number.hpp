@@ -68,6 +68,8 @@ namespace node{
 		class Pi : public virtual NamedSymbol
 		{
 		public:
+			BERTINI_DEFAULT_VISITABLE()
+
 			Pi() : NamedSymbol("pi")
 			{}
 
@@ -185,6 +187,8 @@ namespace node{
 		class E : public virtual NamedSymbol
 		{
 		public:
+			BERTINI_DEFAULT_VISITABLE()
+
 			E() : NamedSymbol("e")
 			{}
 
@@ -0,0 +1,74 @@
+//This file is part of Bertini 2.
+//
+//limb_pool.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//limb_pool.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with limb_pool.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+/**
+\file limb_pool.hpp
+
+\brief Pooled allocation of the limbs of multiple precision numbers.
+
+Every mpfr_float made, whether a variable or a temporary in an expression, allocates its limbs on the heap, and frees them when it dies.  At a fixed precision, the blocks are all of one size, so a pool of freed blocks, keyed by size, can serve every allocation after the first few.
+*/
+
+#ifndef BERTINI_LIMB_POOL_HPP
+#define BERTINI_LIMB_POOL_HPP
+
+#include <cstddef>
+
+namespace bertini {
+
+	/**
+	\brief Route the allocations of GMP and MPFR through per-thread pools of freed blocks.
+
+	Blocks are pooled by their exact size, which the number of limbs, and so the precision, determines.  Allocating takes a block of the right size from the calling thread's pool if there is one, and otherwise from the system.  Freeing puts the block in the calling thread's pool, unless the pool holds enough blocks of its size already.  Tracking at a fixed precision hence makes no system allocations for limbs, once the pool is warm.  Eigen's arrays of numbers are not affected, only the limbs of the numbers in them.
+
+	Blocks are obtained with malloc, as GMP's own allocator does, so the pool may be turned on and off while numbers are alive.  Pools are emptied back to the system when their threads exit.
+
+	Replaces the memory functions of GMP, with mp_set_memory_functions, for the whole process.  Calling this more than once is harmless.
+
+	Without thread_local (./configure --disable-thread_local), the pool is shared by all threads, and is not thread safe.
+	*/
+	void EnableLimbPool();
+
+	/**
+	\brief Restore GMP's default memory functions.
+
+	Blocks already in pools remain there until their threads exit.
+	*/
+	void DisableLimbPool();
+
+	/**
+	\brief Whether the memory functions of GMP are those of the limb pool.
+	*/
+	bool LimbPoolEnabled();
+
+	/**
+	\brief The number of allocations the calling thread's pool passed on to the system, because it held no block of the size asked for.
+
+	For checking that the pool is doing its job.  Counts since the thread started.
+	*/
+	std::size_t LimbPoolMisses();
+
+} // re: namespace bertini
+
+#endif
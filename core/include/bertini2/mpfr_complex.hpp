@@ -309,6 +309,17 @@ namespace bertini {
 			imag_ = 0;
 			return *this;
 		}
+
+		/**
+		 Assignment from an integer, as Eigen's sparse solvers do to zero their workspaces.  Only for integral types, so that doubles do not convert to int through it.
+		 */
+		template<typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+		complex& operator=(T other)
+		{
+			real_ = other;
+			imag_ = 0;
+			return *this;
+		}
 		
 		
 		
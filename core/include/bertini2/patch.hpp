@@ -132,6 +132,8 @@ namespace bertini {
 					assert(coefficients_highest_precision_[ii](jj) == other.coefficients_highest_precision_[ii](jj));
 				}
 			}
+
+			SetDoubleDoubleCoefficients();
 		}
 
 
@@ -172,6 +174,8 @@ namespace bertini {
 
 				assert(Precision(coefficients_mpfr[ii](0))==precision_);
 			}
+
+			SetDoubleDoubleCoefficients();
 		}
 
 
@@ -220,6 +224,7 @@ namespace bertini {
 					coefficients_dbl[ii](jj) = dbl(p.coefficients_highest_precision_[ii](jj));
 			}
 
+			p.SetDoubleDoubleCoefficients();
 			return p;
 		}
 
@@ -287,7 +292,7 @@ namespace bertini {
 
 			#ifndef BERTINI_DISABLE_ASSERTS
 			assert(function_values.size()>=NumVariableGroups() && "function values must be of length at least as long as the number of variable groups");
-//			assert((bertini::Precision(x(0))==DoublePrecision() || bertini::Precision(x(0)) == Precision())
+//			assert((bertini::Precision(x(0))==DoublePrecision() || bertini::Precision(x(0))==DoubleDoublePrecision() || bertini::Precision(x(0)) == Precision())
 //			 		&& "precision of input vector must match current working precision of patch during evaluation"
 //			 	  );
 			#endif
@@ -343,7 +348,7 @@ namespace bertini {
 			assert(jacobian.rows()>=NumVariableGroups() && "input jacobian must have at least as many rows as variable groups");
 			assert(jacobian.cols()==NumVariables() && "input jacobian must have as many columns as the patch has variables");
 			assert(
-			       (bertini::Precision(x(0))==DoublePrecision() || bertini::Precision(x(0)) == Precision())  
+			       (bertini::Precision(x(0))==DoublePrecision() || bertini::Precision(x(0))==DoubleDoublePrecision() || bertini::Precision(x(0)) == Precision())  
 			       	    && "precision of input vector must match current working precision of patch during evaluation"
 			       );
 			#endif
@@ -351,12 +356,39 @@ namespace bertini {
 			const std::vector<Vec<T> >& coefficients = std::get<std::vector<Vec<T> > >(coefficients_working_);
 
 			unsigned offset(jacobian.rows() - NumVariableGroups()); // by precondition this number is at least 0.  the precondition is ensured by the public wrapper
+			// the entries for the variables of other groups are zero, and are set so, as the matrix passed in may hold anything
+			jacobian.bottomRows(NumVariableGroups()).setZero();
 			unsigned counter(0);
 			for (unsigned ii = 0; ii < NumVariableGroups(); ++ii)
 				for (unsigned jj=0; jj<variable_group_sizes_[ii]; ++jj)
 					jacobian(ii+offset,counter++) = coefficients[ii](jj);
 		}
 
+		/**
+		\brief Evaluate the Jacobian matrix, in place, into a sparse matrix.
+
+		The entry in row ii of the patch, for each variable of group ii, must already be in the sparsity pattern of the matrix, as the rows of System::JacobianSparsity for the patch are.
+
+		\param jacobian Matrix to populate with the Jacobian.  The patch goes in its last NumVariableGroups rows, and first NumVariables columns.
+		\param x Point at which to evaluate.  As for JacobianInPlace, not technically needed.
+		*/
+		template<typename T>
+		void SparseJacobianInPlace(SparseMat<T> & jacobian, Vec<T> const& x) const
+		{
+			#ifndef BERTINI_DISABLE_ASSERTS
+			assert(jacobian.rows()>=NumVariableGroups() && "input jacobian must have at least as many rows as variable groups");
+			assert(jacobian.cols()==NumVariables() && "input jacobian must have as many columns as the patch has variables");
+			#endif
+
+			const std::vector<Vec<T> >& coefficients = std::get<std::vector<Vec<T> > >(coefficients_working_);
+
+			unsigned offset(jacobian.rows() - NumVariableGroups());
+			unsigned counter(0);
+			for (unsigned ii = 0; ii < NumVariableGroups(); ++ii)
+				for (unsigned jj=0; jj<variable_group_sizes_[ii]; ++jj)
+					jacobian.coeffRef(ii+offset,counter++) = coefficients[ii](jj);
+		}
+
 		/**
 		\brief Evaluate the Jacobian matrix, in place.
 
@@ -387,7 +419,7 @@ namespace bertini {
 		{
 			#ifndef BERTINI_DISABLE_ASSERTS
 				assert(x.size() == NumVariables() && "input point for rescaling to fit a patch must have same length as total number of variables being patched, in all variable groups.");
-				assert((bertini::Precision(x(0))==DoublePrecision() || bertini::Precision(x(0)) == Precision())
+				assert((bertini::Precision(x(0))==DoublePrecision() || bertini::Precision(x(0))==DoubleDoublePrecision() || bertini::Precision(x(0)) == Precision())
 						&& "precision of input vector must match current working precision of patch during rescaling"
 					   );
 			#endif
@@ -429,6 +461,15 @@ namespace bertini {
 		}
 
 
+		/**
+		\brief Get the sizes of the variable groups, in order.  Row ii of the patch involves only the variables of group ii.
+		*/
+		std::vector<unsigned> const& VariableGroupSizes() const
+		{
+			return variable_group_sizes_;
+		}
+
+
 		/**
 		\brief Get the number of variables in the patch.  
 		*/
@@ -485,6 +526,22 @@ namespace bertini {
 
 	private:
 
+		/**
+		\brief Round the highest precision coefficients to double-double.  Like the doubles, these are only set at creation.
+		*/
+		void SetDoubleDoubleCoefficients()
+		{
+			std::vector<Vec<dd_complex> >& coefficients_dd = std::get<std::vector<Vec<dd_complex> > >(coefficients_working_);
+
+			coefficients_dd.resize(coefficients_highest_precision_.size());
+			for (unsigned ii = 0; ii < coefficients_highest_precision_.size(); ++ii)
+			{
+				coefficients_dd[ii].resize(coefficients_highest_precision_[ii].size());
+				for (unsigned jj = 0; jj < coefficients_highest_precision_[ii].size(); ++jj)
+					coefficients_dd[ii](jj) = ToDoubleDouble(coefficients_highest_precision_[ii](jj));
+			}
+		}
+
 		/////////////////
 		//
 		//    Data members
@@ -493,7 +550,7 @@ namespace bertini {
 
 		std::vector< Vec< mpfr > > coefficients_highest_precision_; ///< the highest-precision coefficients for the patch
 
-		mutable std::tuple< std::vector< Vec< mpfr > >, std::vector< Vec< dbl > > > coefficients_working_; ///< the current working coefficients of the patch.  changing precision affects these, particularly the mpfr coefficients, which are down-sampled from the highest_precision coefficients.  the doubles are only down-sampled at time of creation or modification.
+		mutable std::tuple< std::vector< Vec< mpfr > >, std::vector< Vec< dbl > >, std::vector< Vec< dd_complex > > > coefficients_working_; ///< the current working coefficients of the patch.  changing precision affects these, particularly the mpfr coefficients, which are down-sampled from the highest_precision coefficients.  the doubles and double-doubles are only down-sampled at time of creation or modification.
 
 		std::vector<unsigned> variable_group_sizes_; ///< the sizes of the groups.  In principle, these must be at least 2.
 
@@ -512,7 +569,10 @@ namespace bertini {
 			ar & std::get<0>(coefficients_working_);
 			ar & std::get<1>(coefficients_working_);
 			ar & variable_group_sizes_;
-			
+
+			// the double-doubles are not saved, but re-made from the highest precision coefficients
+			if (Archive::is_loading::value)
+				SetDoubleDoubleCoefficients();
 		}
 
 	};
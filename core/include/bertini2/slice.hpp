@@ -160,6 +160,25 @@ namespace bertini {
 		}
 
 
+		/**
+		\brief Make a function tree for one of the linears of the slice, in the sliced variables, so that it may be used as a function of a System.
+
+		The coefficients are those of highest precision.
+
+		\param index The index of the linear.  It is up to you to make sure it is less than Dimension().
+		*/
+		std::shared_ptr<node::Node> Linear(unsigned index) const
+		{
+			std::shared_ptr<node::Node> result = std::make_shared<node::Float>(coefficients_highest_precision_(index,0))*sliced_vars_[0];
+			for (unsigned jj=1; jj<NumVariables(); ++jj)
+				result = result + std::make_shared<node::Float>(coefficients_highest_precision_(index,jj))*sliced_vars_[jj];
+
+			if (!is_homogeneous_)
+				result = result + std::make_shared<node::Float>(constants_highest_precision_(index));
+			return result;
+		}
+
+
 		unsigned Dimension() const
 		{
 			return num_dims_sliced_;
@@ -249,7 +268,7 @@ namespace bertini {
 
 
 		// the constructor for linear slices.  private because want to use the static public methods to construct them.
-		LinearSlice(VariableGroup const& v, unsigned dim, bool homogeneous) : sliced_vars_(v), precision_(DefaultPrecision()), num_dims_sliced_(dim), coefficients_highest_precision_(dim, v.size()), is_homogeneous_(homogeneous), constants_highest_precision_(dim)
+		LinearSlice(VariableGroup const& v, unsigned dim, bool homogeneous) : sliced_vars_(v), precision_(DefaultPrecision()), num_dims_sliced_(dim), coefficients_highest_precision_(dim, v.size()), is_homogeneous_(homogeneous), constants_highest_precision_(homogeneous ? 0 : dim)
 		{ 
 			std::get<Mat<dbl> > (coefficients_working_).resize(Dimension(), NumVariables());
 			std::get<Mat<mpfr> >(coefficients_working_).resize(Dimension(), NumVariables());
@@ -279,6 +298,7 @@ namespace bertini {
 	};
 
 
+	inline
 	std::ostream& operator<<(std::ostream& out, LinearSlice const& s)
 	{
 		out << "linear slice on " << s.NumVariables() << " variables:\n";
@@ -35,6 +35,8 @@
 #include "bertini2/system.hpp"
 #include "bertini2/limbo.hpp"
 
+#include <boost/serialization/utility.hpp>
+
 
 namespace bertini 
 {
@@ -91,6 +93,8 @@ namespace bertini
 		Note that the corresponding target system MUST be square -- have the same number of functions and variables.  The start system cannot be constructed otherwise, particularly because it is written to throw at the moment if not square.
 
 		The start points are accesses by index (mpz_int), instead of being generated all at once.
+
+		For systems with more than one variable group, see MHomogeneous.  For sparse systems, see Polyhedral.
 		*/
 		class TotalDegree : public StartSystem
 		{
@@ -166,6 +170,354 @@ namespace bertini
 			}
 
 		};
+
+
+
+
+
+
+		/**
+		\brief StartSystem for multihomogeneous polynomial systems, those with several affine variable groups.
+
+		For a system whose variables are partitioned into groups, the number of paths needed is the m-homogeneous Bezout number, which is often far below the total degree.  Let \f$d_{ij}\f$ be the degree of function \f$i\f$ in the variables of group \f$j\f$, and \f$n_j\f$ be the size of group \f$j\f$.  The m-homogeneous Bezout number is the sum, over the assignments of the functions to groups such that each group \f$j\f$ gets \f$n_j\f$ functions, of the products \f$\prod_i d_{i,j(i)}\f$.
+
+		The start functions are \f$\prod_j (\ell_{ij}(x_j)^{d_{ij}} - 1)\f$, over the groups \f$j\f$ in which function \f$i\f$ has positive degree, where the \f$\ell_{ij}\f$ are linear forms in the variables of group \f$j\f$, with random coefficients.  Each start point is had by choosing an assignment of functions to groups, and for each function \f$i\f$ a root of unity \f$\omega\f$ of order \f$d_{i,j(i)}\f$, and then solving the linear systems \f$\ell_{ij}(x_j) = \omega\f$ group by group.
+
+		As for TotalDegree, the target system must be square, polynomial, without a path variable, and without homogeneous variable groups or ungrouped variables.  The start points are accessed by index (mpz_int), instead of being generated all at once.  The valid assignments, and the number of start points for each, are enumerated once at construction.
+		*/
+		class MHomogeneous : public StartSystem
+		{
+		public:
+			MHomogeneous() = default;
+			virtual ~MHomogeneous() = default;
+
+			/**
+			 Constructor for making a multihomogeneous start system from a polynomial system
+
+			 \throws std::runtime_error, if the input target system is not square, is not polynomial, has a path variable already, has ungrouped variables or homogeneous variable groups, or has a function of degree 0.
+			*/
+			MHomogeneous(System const& s);
+
+
+			/**
+			Get the degrees of the functions of the target system in each variable group.  The degree of function i in group j is entry [i][j].
+			*/
+			std::vector<std::vector<int> > const& GroupDegrees() const
+			{
+				return degrees_;
+			}
+
+
+			/**
+			Get the number of start points for this multihomogeneous start system.  This is the m-homogeneous Bezout number for the target system, with respect to its variable groups.
+			*/
+			mpz_int NumStartPoints() const override;
+
+			MHomogeneous& operator+=(System const& sys) = delete;
+
+		private:
+
+			/**
+			Get the ith start point, in double precision.
+
+			Called by the base StartSystem's StartPoint(index) method.
+			*/
+			Vec<dbl> GenerateStartPoint(dbl,mpz_int index) const override;
+
+			/**
+			Get the ith start point, in current default precision.
+
+			Called by the base StartSystem's StartPoint(index) method.
+			*/
+			Vec<mpfr> GenerateStartPoint(mpfr,mpz_int index) const override;
+
+			/**
+			Solve the linear systems for the start point of an index, in either precision.
+			*/
+			template<typename T>
+			Vec<T> StartPointFromIndex(mpz_int index) const;
+
+			std::vector<std::vector<int> > degrees_; ///< degrees_[i][j] is the degree of function i in variable group j.
+			std::vector<std::vector<std::vector<std::shared_ptr<node::Rational> > > > coefficients_; ///< coefficients_[i][j] are the coefficients of the linear form for function i and variable group j.  Empty if the degree is 0.
+			std::vector<std::vector<unsigned> > assignments_; ///< The assignments of functions to variable groups which give start points.  assignments_[a][i] is the group of function i.
+			std::vector<mpz_int> cumulative_num_start_points_; ///< The number of start points from assignments 0 through a, at a.
+
+
+			friend class boost::serialization::access;
+
+			template <typename Archive>
+			void serialize(Archive& ar, const unsigned version) {
+				ar & boost::serialization::base_object<StartSystem>(*this);
+				ar & degrees_;
+				ar & coefficients_;
+				ar & assignments_;
+				ar & cumulative_num_start_points_;
+			}
+
+		};
+
+
+
+
+
+
+		/**
+		\brief StartSystem with a linear-product structure, read from which variables of each variable group occur in each function.
+
+		Where MHomogeneous takes each factor of a start function over a whole variable group, LinearProduct takes it over only the variables of the group which occur in the function, and with a constant term.  Start function \f$i\f$ is the product, over the groups \f$j\f$, of \f$d_{ij}\f$ affine linear factors in those variables, each with its own random coefficients.  Each target function lies in the span of the products of such factors, so the linear-product homotopy from this start system reaches all the isolated solutions of the target.
+
+		A start point is had by choosing one factor of each start function, and solving the linear systems so made, group by group.  Choosing the factors from the groups such that each group \f$j\f$ gets \f$n_j\f$ of them, as for MHomogeneous, the linear system for a group is nonsingular exactly when its functions can be matched to distinct variables occurring in their factors.  NumStartPoints counts only the choices for which all are nonsingular, so is at most the m-homogeneous Bezout number, and less when functions leave out variables of the groups.
+
+		The matchings are checked once, at construction.  The linear systems are solved only when a start point is asked for, by index.  The requirements on the target system are those of MHomogeneous.
+		*/
+		class LinearProduct : public StartSystem
+		{
+		public:
+			LinearProduct() = default;
+			virtual ~LinearProduct() = default;
+
+			/**
+			 Constructor for making a linear-product start system from a polynomial system
+
+			 \throws std::runtime_error, if the input target system is not square, is not polynomial, has a path variable already, has ungrouped variables or homogeneous variable groups, or has a function of degree 0.
+			*/
+			LinearProduct(System const& s);
+
+
+			/**
+			Get the degrees of the functions of the target system in each variable group.  The degree of function i in group j is entry [i][j].
+			*/
+			std::vector<std::vector<int> > const& GroupDegrees() const
+			{
+				return degrees_;
+			}
+
+
+			/**
+			Get the variables of each group occurring in each function, as indices into the group.  Those of function i in group j are entry [i][j].
+			*/
+			std::vector<std::vector<std::vector<unsigned> > > const& Supports() const
+			{
+				return supports_;
+			}
+
+
+			/**
+			Get the number of start points for this linear-product start system.  This is the linear-product bound for the target system.
+			*/
+			mpz_int NumStartPoints() const override;
+
+			LinearProduct& operator+=(System const& sys) = delete;
+
+		private:
+
+			/**
+			Get the ith start point, in double precision.
+
+			Called by the base StartSystem's StartPoint(index) method.
+			*/
+			Vec<dbl> GenerateStartPoint(dbl,mpz_int index) const override;
+
+			/**
+			Get the ith start point, in current default precision.
+
+			Called by the base StartSystem's StartPoint(index) method.
+			*/
+			Vec<mpfr> GenerateStartPoint(mpfr,mpz_int index) const override;
+
+			/**
+			Solve the linear systems for the start point of an index, in either precision.
+			*/
+			template<typename T>
+			Vec<T> StartPointFromIndex(mpz_int index) const;
+
+			std::vector<std::vector<int> > degrees_; ///< degrees_[i][j] is the degree of function i in variable group j.
+			std::vector<std::vector<std::vector<unsigned> > > supports_; ///< supports_[i][j] are the indices in variable group j of the variables occurring in function i.
+			std::vector<std::vector<std::vector<std::vector<std::shared_ptr<node::Rational> > > > > coefficients_; ///< coefficients_[i][j][k] are the coefficients of factor k of function i in variable group j, on the variables of supports_[i][j], and then the constant term.
+			std::vector<std::vector<unsigned> > assignments_; ///< The assignments of functions to variable groups whose linear systems are nonsingular.  assignments_[a][i] is the group of function i.
+			std::vector<mpz_int> cumulative_num_start_points_; ///< The number of start points from assignments 0 through a, at a.
+
+
+			friend class boost::serialization::access;
+
+			template <typename Archive>
+			void serialize(Archive& ar, const unsigned version) {
+				ar & boost::serialization::base_object<StartSystem>(*this);
+				ar & degrees_;
+				ar & supports_;
+				ar & coefficients_;
+				ar & assignments_;
+				ar & cumulative_num_start_points_;
+			}
+
+		};
+
+
+
+
+
+
+		/**
+		\brief StartSystem for sparse polynomial systems, whose number of start points is the mixed volume of the Newton polytopes of the target, rather than a Bezout number.
+
+		The start system \f$g\f$ has, for each function of the target, a random complex coefficient on each monomial of the target function, and on the constant monomial.  The supports so made, \f$A_i\f$, each with the origin, have a mixed volume which bounds the number of isolated solutions of the target in affine space (the BKK bound, as strengthened by Li and Wang), and is the number of solutions of \f$g\f$.  For sparse systems it is far below the total degree.  Tracking from \f$g\f$ to the target with the gamma trick homotopy of Solve is then a coefficient-parameter homotopy, within the family of systems with these supports.
+
+		The solutions of \f$g\f$ are found by polyhedral homotopies, in two stages:
+
+		1. At construction, each point \f$a \in A_i\f$ is given a random integer lifting \f$\omega(a)\f$, and the mixed cells of the induced subdivision are found.  A mixed cell picks a pair \f$\{a_i,b_i\}\subset A_i\f$ of each support, such that some \f$\alpha\f$ has \f$\langle a,\alpha\rangle + \omega(a)\f$ least over \f$A_i\f$ exactly at \f$a_i\f$ and \f$b_i\f$, for all \f$i\f$.  Its volume is \f$|\det V|\f$, \f$V\f$ having the rows \f$b_i-a_i\f$, and the mixed volume is the sum of these.  The candidate pairs are enumerated exhaustively, pruned to those with independent differences, and tested in exact rational arithmetic.  The pairs of the first support are divided among threads.  If the lifting is not generic, so that a cell has extra points attaining the least value, the lifting is drawn again.
+
+		2. tracking::TrackPolyhedralHomotopies solves, for each cell, the binomial system \f$c_{a_i} y^{a_i} + c_{b_i} y^{b_i} = 0\f$ (see BinomialSolutions), and tracks each of its \f$|\det V|\f$ solutions along the cell's homotopy (see CellHomotopy) to a solution of \f$g\f$, recording them with SetStartPoints.
+
+		Only then does the start system have start points.  NumStartPoints is the number recorded, which is MixedVolume unless some paths failed.
+
+		\code{.cpp}
+		sys.Homogenize();
+		sys.AutoPatch();
+
+		start_system::Polyhedral P(sys);
+		config::Solver<double> settings;
+		tracking::TrackPolyhedralHomotopies<tracking::DoublePrecisionTracker>(P, settings);
+		auto results = tracking::Solve<tracking::DoublePrecisionTracker>(sys, P, settings);
+		\endcode
+
+		The exhaustive enumeration of cells costs the product over the functions of the squares of the numbers of their terms, so is meant for systems with modest supports.  The requirements on the target system are those of MHomogeneous.  The supports are taken over all the variables together, in the order of the variable groups.
+		*/
+		class Polyhedral : public StartSystem
+		{
+		public:
+			Polyhedral() = default;
+			virtual ~Polyhedral() = default;
+
+			/**
+			 Constructor for making a polyhedral start system from a polynomial system, finding the mixed cells, but not yet the start points.
+
+			 \param s The target system.
+			 \param num_threads The number of threads among which to divide the enumeration of mixed cells.  0 for one per hardware thread.
+
+			 \throws std::runtime_error, if the input target system is not square, is not polynomial, has a path variable already, has ungrouped variables or homogeneous variable groups, or cannot be expanded into monomials.
+			*/
+			Polyhedral(System const& s, unsigned num_threads = 0);
+
+
+			/**
+			Get the supports of the start functions, the target's with the origin.  The exponent of variable k in term a of function i is entry [i][a][k].
+			*/
+			std::vector<std::vector<std::vector<int> > > const& Supports() const
+			{
+				return supports_;
+			}
+
+
+			/**
+			Get the lifting of the supports.  That of term a of function i is entry [i][a].
+			*/
+			std::vector<std::vector<int> > const& Lifting() const
+			{
+				return lifting_;
+			}
+
+
+			/**
+			Get the mixed cells.  Entry [c][i] is the pair of indices of the terms of function i in cell c.
+			*/
+			std::vector<std::vector<std::pair<unsigned, unsigned> > > const& MixedCells() const
+			{
+				return cells_;
+			}
+
+
+			/**
+			Get the mixed volume of the supports, the number of solutions of the start system, and a bound on the number of isolated solutions of the target in affine space.
+			*/
+			mpz_int MixedVolume() const;
+
+
+			/**
+			Get the solutions, at time 0, of the homotopy of a mixed cell, which are those of its binomial system.  There are as many as the volume of the cell.
+
+			\param cell The index of the cell.
+			*/
+			std::vector<Vec<dbl> > BinomialSolutions(size_t cell) const;
+
+
+			/**
+			Make the polyhedral homotopy of a mixed cell, \f$h_i(y,t) = \sum_{a\in A_i} c_a y^a t^{e_a}\f$, with \f$e_a = (\langle a,\alpha\rangle + \omega(a) - \beta_i) / e_{\min}\f$, where \f$\alpha\f$ is the inner normal of the cell, \f$\beta_i\f$ the least value over \f$A_i\f$, and \f$e_{\min}\f$ the least positive exponent, so that the exponents of the cell's pairs are 0, and the others at least 1.
+
+			At \f$t=1\f$ it is the start system, in the affine variables, and at \f$t=0\f$ the binomial system of the cell.  The homotopy is made from new nodes, sharing none with this system or with other cells' homotopies, so that cells may be tracked in separate threads.
+
+			\param cell The index of the cell.
+			\return The homotopy, in one affine variable group, with path variable t.
+			*/
+			System CellHomotopy(size_t cell) const;
+
+
+			/**
+			Record the solutions of the start system, in the affine variables, found by tracking the homotopies of the cells.
+			*/
+			void SetStartPoints(std::vector<Vec<dbl> > const& affine_start_points)
+			{
+				start_points_ = affine_start_points;
+			}
+
+
+			/**
+			Get the number of start points recorded by SetStartPoints.  0 until they are.
+			*/
+			mpz_int NumStartPoints() const override;
+
+			Polyhedral& operator+=(System const& sys) = delete;
+
+		private:
+
+			/**
+			Get the ith start point, in double precision.
+
+			Called by the base StartSystem's StartPoint(index) method.
+			*/
+			Vec<dbl> GenerateStartPoint(dbl,mpz_int index) const override;
+
+			/**
+			Get the ith start point, in current default precision, refined from the recorded one by Newton's method.
+
+			Called by the base StartSystem's StartPoint(index) method.
+			*/
+			Vec<mpfr> GenerateStartPoint(mpfr,mpz_int index) const override;
+
+			/**
+			Put a recorded affine start point into the coordinates of this system, homogenized and patched as the target was.
+			*/
+			template<typename T>
+			Vec<T> FromAffine(Vec<T> const& affine) const;
+
+			/**
+			Draw a lifting, and find the mixed cells it induces.
+
+			\return Whether the lifting was generic.  If not, the cells found are to be discarded.
+			*/
+			bool FindMixedCells(unsigned num_threads);
+
+			std::vector<std::vector<std::vector<int> > > supports_; ///< supports_[i][a][k] is the exponent of variable k in term a of function i.  The last term of each function is the constant one.
+			std::vector<std::vector<std::shared_ptr<node::Rational> > > coefficients_; ///< coefficients_[i][a] is the coefficient of term a of function i.
+			std::vector<std::vector<int> > lifting_; ///< lifting_[i][a] is the lifting of term a of function i.
+			std::vector<std::vector<std::pair<unsigned, unsigned> > > cells_; ///< The mixed cells, as the pairs of terms of each function.
+			std::vector<mpz_int> cell_volumes_; ///< The volume of each mixed cell.
+			std::vector<Vec<dbl> > start_points_; ///< The solutions of the start system in the affine variables, once recorded.
+
+
+			friend class boost::serialization::access;
+
+			template <typename Archive>
+			void serialize(Archive& ar, const unsigned version) {
+				ar & boost::serialization::base_object<StartSystem>(*this);
+				ar & supports_;
+				ar & coefficients_;
+				ar & lifting_;
+				ar & cells_;
+				ar & cell_volumes_;
+				ar & start_points_;
+			}
+
+		};
 	}
 }
 
@@ -32,6 +32,7 @@
 #define BERTINI_SYSTEM_HPP
 
 #include <assert.h>
+#include <array>
 #include <vector>
 
 
@@ -49,6 +50,9 @@
 
 
 #include "bertini2/function_tree.hpp"
+#include "bertini2/function_tree/straight_line_program.hpp"
+#include "bertini2/function_tree/sparse_polynomial.hpp"
+#include "bertini2/function_tree/common_subexpressions.hpp"
 #include "bertini2/patch.hpp"
 
 #include "bertini2/limbo.hpp"
@@ -60,6 +64,35 @@ namespace bertini {
 
 	
 
+	/**
+	\brief The methods by which a System may evaluate its functions, Jacobian, and time derivatives.
+
+	\see System::SetEvalMethod
+	*/
+	enum class EvalMethod
+	{
+		FunctionTree, ///< Recursive evaluation of the function and Jacobian trees.
+		StraightLine, ///< Evaluation of a StraightLineProgram compiled from the function and Jacobian trees.
+		Native, ///< As StraightLine, with the program in double precision run as C++ generated from it, compiled into a shared object, and loaded.  See NativeCompiler.
+		Polynomial, ///< Evaluation of the functions expanded into sums of monomials, a SparsePolynomialSystem.  Only for systems polynomial in their variables and path variable.
+		Automatic ///< Polynomial if the system is polynomial in its variables and path variable, and otherwise FunctionTree.  The default.
+	};
+
+
+	/**
+	\brief The methods by which a System may compute its Jacobian and time derivatives.
+
+	\see System::SetJacobianMethod
+	*/
+	enum class JacobianMethod
+	{
+		Symbolic, ///< Evaluation of the Jacobian trees produced by differentiating the functions, or, when the system evaluates its expanded polynomials, differentiation of these.  The default.
+		ForwardMode, ///< Forward-mode automatic differentiation of the functions, in a single sweep over their StraightLineProgram.  No Jacobian trees are made.
+		ReverseMode, ///< Reverse-mode (adjoint) automatic differentiation of the functions, with one backward sweep over their StraightLineProgram per function.  No Jacobian trees are made.
+		Automatic ///< Forward or reverse mode, whichever is cheaper for the numbers of variables and functions in the system.
+	};
+
+
 	/**
 	\brief The fundamental polynomial system class for Bertini2.
 	
@@ -115,9 +148,22 @@ namespace bertini {
 		*/
 		friend void swap(System & a, System & b);
 
+		/**
+		\brief Make a deep copy of the system, sharing no nodes with the original.
+
+		The copy constructor shares the nodes of the function trees between the copy and the original, and since the nodes store their own values, evaluating one changes the stored values of the other.  The clone has its own copy of every node, variables included, so it may be evaluated, differentiated, and changed in precision independently of the original.  Hence each of several threads may track paths on its own clone of one homotopy, without locking.
+
+		The values of the variables are not carried over, so set them on the clone before evaluating it.  Clone in one thread, before handing out the clones, and do not change the original while cloning.
+
+		\return A system structurally identical to this one, at the same precision, with the same evaluation and differentiation methods.
+		*/
+		System Clone() const;
+
 		/**
 		Change the precision of the entire system's functions, subfunctions, and all other nodes.
 
+		The variables, and the memory of the straight-line program if compiled, change at once.  The program keeps its memory for each precision it has been at, so that returning to a precision costs no re-computation of its constants.  The function and Jacobian trees are brought to the new precision when next evaluated, each distinct node once, so that a system evaluating through its straight-line program never pays for them.
+
 		\param new_precision The new precision, in digits, to work in.  This only affects the mpfr types, not double.  To use low-precision (doubles), use that number type in the templated functions.
 		*/
 		void precision(unsigned new_precision) const;
@@ -136,6 +182,94 @@ namespace bertini {
 		void Differentiate() const;
 
 
+		/**
+		\brief Merge structurally identical subtrees across all functions, subfunctions, explicit parameters, and Jacobian entries.
+
+		Parsed systems and symbolic derivatives contain a great deal of repeated structure, such as the same power of a variable appearing in many terms, or the same subtree copied into many Jacobian entries.  After this pass each distinct subtree is a single node, so its value is computed once per evaluation.  The trees are modified in place.
+
+		If the Jacobian is computed symbolically, the system is differentiated first, so that the Jacobian entries take part.  If the system is later differentiated again, for instance after a change in its structure, the new Jacobian does not share structure until this is called again.
+
+		\return The number of distinct nodes in the system before and after the pass.
+		\see NumDistinctNodes
+		*/
+		std::pair<size_t, size_t> EliminateCommonSubexpressions();
+
+
+		/**
+		\brief The number of distinct nodes in the trees of the system, including the Jacobian if it has been computed.
+
+		A node shared among several trees, or referred to several times within one, is counted once.
+		*/
+		size_t NumDistinctNodes() const;
+
+
+		/**
+		\brief Choose how the system evaluates its functions, Jacobian, and time derivatives.
+
+		With EvalMethod::StraightLine, the function and Jacobian trees are compiled into a StraightLineProgram the first time the system is evaluated after a change in its structure, and evaluation then runs the compiled program.  This is much faster for repeated evaluation, at the cost of the one-time compilation.
+
+		When using the compiled program, variable values must be set through the System (SetVariables, SetPathVariable, SetImplicitParameters, or the Eval functions which take values), not by setting the values of the variable nodes directly.
+
+		With EvalMethod::Native, the StraightLineProgram is further turned into C++, one statement per instruction, which is compiled by the compiler Bertini2 was built with, into a shared object which is then loaded.  Double precision evaluation then runs this code, while multiple precision runs the program.  The shared objects are cached on disk under a hash of the structure of the program, so that systems evaluated in later runs, or differing only in their coefficients, are not compiled again.  This pays off for systems solved many times over, such as in parameter sweeps.
+
+		With EvalMethod::Polynomial, the functions are expanded into sums of monomials, a SparsePolynomialSystem, the first time the system is evaluated after a change in its structure.  The functions, Jacobian, and time derivatives are then computed together, from a table of powers of the variables shared by all the terms.  The same caution about setting variable values applies.  Unless the Jacobian method is other than Symbolic, the Jacobian trees are never made.  Evaluation throws if the system is not polynomial in its variables and path variable.  With EvalMethod::Automatic, the default, such systems are evaluated through their trees instead.
+
+		\param method The method to use.
+		*/
+		void SetEvalMethod(EvalMethod method)
+		{
+			// the native code is attached to the program when it is compiled
+			if ((method==EvalMethod::Native) != (eval_method_==EvalMethod::Native))
+				is_compiled_ = false;
+			eval_method_ = method;
+		}
+
+		/**
+		\brief Get the method by which the system evaluates itself.
+		*/
+		EvalMethod GetEvalMethod() const
+		{
+			return eval_method_;
+		}
+
+		/**
+		\brief Choose how the system computes its Jacobian and time derivatives.
+
+		With JacobianMethod::ForwardMode, the values of the functions and all their partial derivatives are computed in one forward sweep over the StraightLineProgram of the functions, carrying a tangent vector with each intermediate value.  The functions are never symbolically differentiated, which avoids both the growth of the Jacobian trees, and the per-variable traversals needed to evaluate them.  The results agree with those of JacobianMethod::Symbolic.
+
+		With JacobianMethod::ReverseMode, the functions are evaluated once, and then the adjoints are swept backward once per function, each sweep producing a row of the Jacobian.  This is preferable for systems with many more variables than functions.  JacobianMethod::Automatic chooses between the two, by comparing the number of instructions each would execute.
+
+		This choice is independent of the EvalMethod, which continues to govern evaluation of the functions alone.
+
+		\param method The method to use.
+		*/
+		void SetJacobianMethod(JacobianMethod method)
+		{
+			jacobian_method_ = method;
+			is_compiled_ = false;
+		}
+
+		/**
+		\brief Get the method by which the system computes its Jacobian and time derivatives.
+		*/
+		JacobianMethod GetJacobianMethod() const
+		{
+			return jacobian_method_;
+		}
+
+		/**
+		\brief Get the straight-line program for the system, compiling it if necessary.
+
+		With JacobianMethod::Symbolic, the program includes the Jacobian and, if the system has a path variable, the time derivatives.  Otherwise it contains only the functions, which are differentiated in forward mode.  The patch is not part of the program.
+		*/
+		StraightLineProgram const& GetStraightLineProgram() const
+		{
+			if (!is_compiled_)
+				CompileStraightLineProgram();
+			return straight_line_program_;
+		}
+
+
 		
 		
 
@@ -145,6 +279,8 @@ namespace bertini {
 
 		It is up to YOU to ensure that the system's variables (and path variable) has been set prior to this function call.
 
+		Only those nodes which depend on inputs set since the previous evaluation are evaluated afresh.  Nodes depending on no input, such as constant subfunctions, keep their values from one evaluation to the next, until the precision or the structure of the system changes.  Hence the inputs must be set through the System (SetVariables, SetPathVariable, SetImplicitParameters), not by setting the values of the variable nodes directly.
+
 		\return The function values of the system
 		*/ 
 		template<typename Derived>
@@ -159,15 +295,18 @@ namespace bertini {
 				throw std::runtime_error(ss.str());
 			}
 
-			// the Reset() function call traverses the entire tree, resetting everything.
-			// TODO: it has the unfortunate side effect of resetting constant functions, too.
-			for (const auto& iter : functions_) 
-				iter->Reset();
-
+			if (UsePolynomialForm())
+				polynomial_form_.EvalInPlace(function_values);
+			else if (UseStraightLineProgram())
+				GetStraightLineProgram().EvalInPlace(function_values);
+			else
+			{
+				ResetFunctionTrees();
 
-			unsigned counter(0);
-			for (auto iter=functions_.begin(); iter!=functions_.end(); iter++, counter++) {
-				(*iter)->EvalInPlace<T>(function_values(counter));
+				unsigned counter(0);
+				for (auto iter=functions_.begin(); iter!=functions_.end(); iter++, counter++) {
+					(*iter)->EvalInPlace<T>(function_values(counter));
+				}
 			}
 
 			if (IsPatched())
@@ -282,8 +421,6 @@ namespace bertini {
 		 
 		 \param variable_values The values of the variables, for the evaluation.
 		 \param path_variable_value The current value of the path variable.
-
-		 \todo The Eval() function for systems has the unfortunate side effect of resetting constant functions.  Modify the System class so that only certain parts of the tree get reset.
 		 */
 		template<typename Derived, typename OtherDerived, typename T>
 		void EvalInPlace(Eigen::MatrixBase<Derived> & function_values, const Eigen::MatrixBase<OtherDerived>& variable_values, const T & path_variable_value) const
@@ -318,8 +455,6 @@ namespace bertini {
 		 
 		 \param variable_values The values of the variables, for the evaluation.
 		 \param path_variable_value The current value of the path variable.
-
-		 \todo The Eval() function for systems has the unfortunate side effect of resetting constant functions.  Modify the System class so that only certain parts of the tree get reset.
 		 */
 		template<typename Derived, typename T>
 		Vec<T> Eval(const Eigen::MatrixBase<Derived>& variable_values, const T & path_variable_value) const
@@ -361,17 +496,32 @@ namespace bertini {
 				throw std::runtime_error("trying to evaluate jacobian of system in place, but input J doesn't have right number of columns or rows");
 			}
 			
-			const auto& vars = Variables();
-
-			if (!is_differentiated_)
-				Differentiate();
+			if (jacobian_method_!=JacobianMethod::Symbolic)
+			{
+				if (UseReverseMode())
+					GetStraightLineProgram().ReverseJacobianInPlace(J);
+				else
+					GetStraightLineProgram().ForwardJacobianInPlace(J);
+			}
+			else if (UsePolynomialForm())
+				polynomial_form_.JacobianInPlace(J);
+			else if (UseStraightLineProgram())
+				GetStraightLineProgram().JacobianInPlace(J);
 			else
-				for (const auto& iter : jacobian_) 
-					iter->Reset();
-
-			for (int ii = 0; ii < NumFunctions(); ++ii)
-				for (int jj = 0; jj < NumVariables(); ++jj)
-					jacobian_[ii]->EvalJInPlace<T>(J(ii,jj),vars[jj]);
+			{
+				const auto& vars = Variables();
+
+				if (!is_differentiated_)
+					Differentiate();
+				else
+					for (const auto& iter : jacobian_) 
+						iter->Reset();
+				SyncTreePrecision();
+
+				for (int ii = 0; ii < NumFunctions(); ++ii)
+					for (int jj = 0; jj < NumVariables(); ++jj)
+						jacobian_[ii]->EvalJInPlace<T>(J(ii,jj),vars[jj]);
+			}
 				
 			if (IsPatched())
 				patch_.JacobianInPlace(J,std::get<Vec<T> >(current_variable_values_));
@@ -400,9 +550,284 @@ namespace bertini {
 			return J;
 		}
 
+
+
+		/**
+		\brief Find the structurally nonzero entries of the Jacobian.
+
+		An entry of a row for a function is structurally nonzero if its variable appears in the tree of the function, and of a row of the patch, if its variable is in the group of the patch.  The derivative with respect to a variable not appearing in a function is identically zero.  The pattern is a superset of the true nonzeros, since a variable may appear and yet cancel.
+
+		The rows for the functions are found once per structure of the system, and kept.
+
+		\return For each row of the Jacobian, the columns of its structurally nonzero entries, in increasing order.
+		*/
+		std::vector< std::vector<int> > JacobianSparsity() const;
+
+		/**
+		\brief The number of structurally nonzero entries of the Jacobian.  See JacobianSparsity.
+		*/
+		size_t NumJacobianNonzeros() const;
+
+		/**
+		\brief The fraction of the entries of the Jacobian which are structurally nonzero.  See JacobianSparsity.
+		*/
+		double JacobianDensity() const;
+
+		/**
+		\brief Set the density of the Jacobian below which predictors and correctors use sparse linear algebra.
+
+		\param threshold The fraction of the entries of the Jacobian, between 0 and 1.  0 turns sparse linear algebra off.
+		\see UseSparseLinearAlgebra
+		*/
+		void SetSparseDensityThreshold(double threshold)
+		{
+			if (threshold < 0 || threshold > 1)
+				throw std::runtime_error("sparse density threshold must be between 0 and 1");
+			sparse_density_threshold_ = threshold;
+		}
+
+		/**
+		\brief Get the density of the Jacobian below which predictors and correctors use sparse linear algebra.
+		*/
+		double GetSparseDensityThreshold() const
+		{
+			return sparse_density_threshold_;
+		}
+
+		/**
+		\brief Whether predictors and correctors should evaluate the Jacobian by SparseJacobianInPlace, and solve with a sparse LU factorization, rather than densely.
+
+		True for square systems of at least MinSparseSize variables, the density of whose Jacobian is below the threshold set by SetSparseDensityThreshold, 0.1 by default.  Below that size, dense factorization is as fast, and its pivoting is more robust.
+		*/
+		bool UseSparseLinearAlgebra() const
+		{
+			return sparse_density_threshold_ > 0 && NumVariables() >= MinSparseSize &&
+			       NumTotalFunctions()==NumVariables() && JacobianDensity() < sparse_density_threshold_;
+		}
+
+		/**
+		\brief The least number of variables of a system for which UseSparseLinearAlgebra holds.
+		*/
+		static constexpr unsigned MinSparseSize = 50;
+
+
+		/**
+		\brief Evaluate the Jacobian matrix of the system, using the previous space and time values, in place, into a sparse matrix.
+
+		The structurally nonzero entries are evaluated, and no others.  Evaluating through the expanded polynomials, the StraightLineProgram, or the Jacobian trees, this costs in proportion to the number of those entries, rather than to the size of the Jacobian.  With a JacobianMethod other than Symbolic, the Jacobian is computed densely and the nonzeros gathered from it.
+
+		If J does not have the sparsity pattern of JacobianSparsity, it is given it, so that passing the same matrix evaluation after evaluation sets the pattern only once.
+
+		\param J The matrix into which to write.
+		\tparam T The number type, dbl or mpfr.
+		*/
+		template<typename T>
+		void SparseJacobianInPlace(SparseMat<T> & J) const
+		{
+			if (J.rows()!=static_cast<Eigen::Index>(NumTotalFunctions()) || J.cols()!=static_cast<Eigen::Index>(NumVariables())
+			    || !J.isCompressed() || static_cast<size_t>(J.nonZeros())!=NumJacobianNonzeros())
+				SetJacobianSparsityPattern(J);
+
+			if (jacobian_method_!=JacobianMethod::Symbolic)
+			{
+				Mat<T> dense(NumTotalFunctions(), NumVariables());
+				JacobianInPlace(dense);
+				for (Eigen::Index jj = 0; jj < J.outerSize(); ++jj)
+					for (typename SparseMat<T>::InnerIterator iter(J,jj); iter; ++iter)
+						iter.valueRef() = dense(iter.row(),jj);
+				return;
+			}
+
+			const T zero(0);
+			for (Eigen::Index kk = 0; kk < J.nonZeros(); ++kk)
+				J.valuePtr()[kk] = zero;
+
+			if (UsePolynomialForm())
+				polynomial_form_.SparseJacobianInPlace(J);
+			else if (UseStraightLineProgram())
+				GetStraightLineProgram().SparseJacobianInPlace(J);
+			else
+			{
+				const auto& vars = Variables();
+
+				if (!is_differentiated_)
+					Differentiate();
+				else
+					for (const auto& iter : jacobian_)
+						iter->Reset();
+				SyncTreePrecision();
+
+				for (Eigen::Index jj = 0; jj < J.outerSize(); ++jj)
+					for (typename SparseMat<T>::InnerIterator iter(J,jj); iter; ++iter)
+						if (iter.row() < static_cast<Eigen::Index>(NumFunctions()))
+							jacobian_[iter.row()]->template EvalJInPlace<T>(iter.valueRef(),vars[jj]);
+			}
+
+			if (IsPatched())
+				patch_.SparseJacobianInPlace(J,std::get<Vec<T> >(current_variable_values_));
+		}
+
+
+		/**
+		\brief Evaluate the Jacobian of the system into a sparse matrix, provided the system has no path variable defined.  See SparseJacobianInPlace(SparseMat<T>&).
+
+		\throws std::runtime_error, if a path variable IS defined, or the number of variables doesn't match.
+		*/
+		template<typename T>
+		void SparseJacobianInPlace(SparseMat<T> & J, const Vec<T> & variable_values) const
+		{
+			if (variable_values.size()!=NumVariables())
+				throw std::runtime_error("trying to evaluate jacobian, but number of variables doesn't match.");
+
+			if (HavePathVariable())
+				throw std::runtime_error("not using a time value for computation of jacobian, but a path variable is defined.");
+
+			SetVariables(variable_values);
+			SparseJacobianInPlace(J);
+		}
+
+
+		/**
+		\brief Evaluate the Jacobian of the system into a sparse matrix, provided a path variable is defined for the system.  See SparseJacobianInPlace(SparseMat<T>&).
+
+		\throws std::runtime_error, if a path variable is NOT defined, or the number of variables doesn't match.
+		*/
+		template<typename Derived, typename T>
+		void SparseJacobianInPlace(SparseMat<T> & J, const Eigen::MatrixBase<Derived> & variable_values, const T & path_variable_value) const
+		{
+			static_assert(std::is_same<typename Derived::Scalar, T>::value, "scalar types must be the same");
+
+			if (variable_values.size()!=NumVariables())
+				throw std::runtime_error("trying to evaluate jacobian, but number of variables doesn't match.");
+
+			if (!HavePathVariable())
+				throw std::runtime_error("trying to use a time value for computation of jacobian, but no path variable defined.");
+
+			SetVariables(variable_values.eval());
+			SetPathVariable(path_variable_value);
+
+			SparseJacobianInPlace(J);
+		}
+
 		
 
 		
+		/**
+		\brief Evaluate the system at many points at once.
+
+		The points are run through the StraightLineProgram of the system together, in one sweep over its tape, with the values of each instruction at all the points stored consecutively.  The dispatch of each instruction is paid once per batch rather than once per point, and in double precision the loops over the points vectorize.  Useful for evaluating at all the start points, all the samples of an endgame, or all the endpoints in post-processing.
+
+		The values of the variables set in the system are neither used nor changed.
+
+		\param function_values The matrix into which to write.  Resized to NumTotalFunctions() rows, and one column per point.
+		\param points The values of the variables, one point per column, with NumVariables() rows.
+		\param times The values of the path variable, one per point.  Ignored if the system has no path variable.
+
+		\throws std::runtime_error if the number of rows of points is not NumVariables(), or the system has a path variable and the number of times differs from the number of points.
+		*/
+		template<typename T>
+		void EvalBatch(Mat<T> & function_values, Mat<T> const& points, Vec<T> const& times = Vec<T>()) const
+		{
+			if (points.rows()!=NumVariables())
+				throw std::runtime_error("trying to evaluate system at a batch of points, but number of variables doesn't match.");
+			if (HavePathVariable() && times.size()!=points.cols())
+				throw std::runtime_error("trying to evaluate system at a batch of points, but number of time values doesn't match number of points.");
+
+			function_values.resize(NumTotalFunctions(), points.cols());
+			GetStraightLineProgram().EvalBatch(points, times, function_values);
+
+			if (IsPatched())
+				for (int kk = 0; kk < points.cols(); ++kk)
+				{
+					Vec<T> x = points.col(kk);
+					auto values = function_values.col(kk);
+					patch_.EvalInPlace(values, x);
+				}
+		}
+
+
+		/**
+		\brief Evaluate the Jacobian of the system at many points at once.
+
+		As EvalBatch, with the Jacobian computed by forward-mode automatic differentiation during the sweep, regardless of the JacobianMethod of the system.
+
+		\param jacobians The matrices into which to write.  Resized to one per point, each NumTotalFunctions() by NumVariables().
+		\param points The values of the variables, one point per column, with NumVariables() rows.
+		\param times The values of the path variable, one per point.  Ignored if the system has no path variable.
+
+		\throws std::runtime_error as EvalBatch.
+		*/
+		template<typename T>
+		void JacobianBatch(std::vector<Mat<T> > & jacobians, Mat<T> const& points, Vec<T> const& times = Vec<T>()) const
+		{
+			if (points.rows()!=NumVariables())
+				throw std::runtime_error("trying to evaluate jacobian at a batch of points, but number of variables doesn't match.");
+			if (HavePathVariable() && times.size()!=points.cols())
+				throw std::runtime_error("trying to evaluate jacobian at a batch of points, but number of time values doesn't match number of points.");
+
+			jacobians.resize(points.cols());
+			for (auto& J : jacobians)
+				J.resize(NumTotalFunctions(), NumVariables());
+
+			GetStraightLineProgram().JacobianBatch(points, times, jacobians);
+
+			if (IsPatched())
+				for (int kk = 0; kk < points.cols(); ++kk)
+				{
+					Vec<T> x = points.col(kk);
+					patch_.JacobianInPlace(jacobians[kk], x);
+				}
+		}
+
+
+
+
+		/**
+		\brief Evaluate the system, its Jacobian, and its derivative with respect to the path variable, at many points at once, from a single sweep.
+
+		As JacobianBatch.  This is what a predictor or corrector working on a batch of points needs.
+
+		\param jacobians The matrices into which to write the Jacobians.  Resized to one per point, each NumTotalFunctions() by NumVariables().
+		\param function_values The matrix into which to write the values.  Resized to NumTotalFunctions() rows, and one column per point.
+		\param time_derivatives The matrix into which to write the time derivatives.  Resized as function_values.
+		\param points The values of the variables, one point per column, with NumVariables() rows.
+		\param times The values of the path variable, one per point.
+
+		\throws std::runtime_error as EvalBatch, or if the system has no path variable.
+		*/
+		template<typename T>
+		void JacobianBatch(std::vector<Mat<T> > & jacobians, Mat<T> & function_values, Mat<T> & time_derivatives, Mat<T> const& points, Vec<T> const& times) const
+		{
+			if (!HavePathVariable())
+				throw std::runtime_error("trying to evaluate time derivative at a batch of points, but no path variable is defined.");
+			if (points.rows()!=NumVariables())
+				throw std::runtime_error("trying to evaluate jacobian at a batch of points, but number of variables doesn't match.");
+			if (times.size()!=points.cols())
+				throw std::runtime_error("trying to evaluate jacobian at a batch of points, but number of time values doesn't match number of points.");
+
+			jacobians.resize(points.cols());
+			for (auto& J : jacobians)
+				J.resize(NumTotalFunctions(), NumVariables());
+			function_values.resize(NumTotalFunctions(), points.cols());
+			time_derivatives.resize(NumTotalFunctions(), points.cols());
+
+			GetStraightLineProgram().JacobianBatch(points, times, jacobians, function_values, time_derivatives);
+
+			if (IsPatched())
+				for (int kk = 0; kk < points.cols(); ++kk)
+				{
+					Vec<T> x = points.col(kk);
+					auto values = function_values.col(kk);
+					patch_.EvalInPlace(values, x);
+					patch_.JacobianInPlace(jacobians[kk], x);
+					for (auto ii = NumFunctions(); ii < NumTotalFunctions(); ++ii)
+						time_derivatives(ii,kk) = T(0);
+				}
+		}
+
+
+
+
 		/**
 		 Evaluate the Jacobian matrix of the system, provided the system has no path variable defined.
 		 
@@ -558,15 +983,29 @@ namespace bertini {
 			if (!HavePathVariable())
 				throw std::runtime_error("computing time derivative of system with no path variable defined");
 
-			if (!is_differentiated_)
-				Differentiate();
-
 			SetVariables(variable_values.eval()); //TODO: remove this eval()
 			SetPathVariable(path_variable_value);
 
-			
-			for (int ii = 0; ii < NumFunctions(); ++ii)
-				ds_dt(ii) = jacobian_[ii]->EvalJ<T>(path_variable_);
+			if (jacobian_method_!=JacobianMethod::Symbolic)
+			{
+				if (UseReverseMode())
+					GetStraightLineProgram().ReverseTimeDerivativeInPlace(ds_dt);
+				else
+					GetStraightLineProgram().ForwardTimeDerivativeInPlace(ds_dt);
+			}
+			else if (UsePolynomialForm())
+				polynomial_form_.TimeDerivativeInPlace(ds_dt);
+			else if (UseStraightLineProgram())
+				GetStraightLineProgram().TimeDerivativeInPlace(ds_dt);
+			else
+			{
+				if (!is_differentiated_)
+					Differentiate();
+				SyncTreePrecision();
+
+				for (int ii = 0; ii < NumFunctions(); ++ii)
+					ds_dt(ii) = jacobian_[ii]->EvalJ<T>(path_variable_);
+			}
 
 			if (IsPatched())
 				for (int ii = 0; ii < NumTotalVariableGroups(); ++ii)
@@ -754,6 +1193,9 @@ namespace bertini {
 			}
 
 			std::get<Vec<T> >(current_variable_values_) = new_values;
+			straight_line_program_.Invalidate();
+			polynomial_form_.Invalidate();
+			changed_inputs_[VariableInput] = true;
 		}
 
 
@@ -773,6 +1215,9 @@ namespace bertini {
 				throw std::runtime_error("trying to set the value of the path variable, but one is not defined for this system");
 
 			path_variable_->set_current_value(new_value);
+			straight_line_program_.Invalidate();
+			polynomial_form_.Invalidate();
+			changed_inputs_[PathVariableInput] = true;
 		}
 
 
@@ -794,6 +1239,10 @@ namespace bertini {
 			for (auto iter=implicit_parameters_.begin(); iter!=implicit_parameters_.end(); iter++, counter++)
 				(*iter)->set_current_value(new_values(counter));
 
+			straight_line_program_.Invalidate();
+			polynomial_form_.Invalidate();
+			changed_inputs_[ImplicitParameterInput] = true;
+
 		}
 
 
@@ -1027,6 +1476,16 @@ namespace bertini {
 			return functions_[index];
 		}
 
+		/**
+		 Get an explicit parameter by its index.
+
+		 As for Function, it is up to you to make sure the parameter at this index exists.
+		*/
+		auto Parameter(unsigned index) const
+		{
+			return explicit_parameters_[index];
+		}
+
 		
 
 		/**
@@ -1207,6 +1666,14 @@ namespace bertini {
 		Can be used for defining a coupling of a target and start system through a path variable.  Does not affect path variable declaration, or anything else.  It is up to you to ensure the system depends on this node properly.
 		*/
 		friend const System operator*(Nd const&  N, System const& s);
+
+	protected:
+
+		/**
+		 Bring the nodes of all the trees of the system to its precision, if a change in precision or structure has left them behind.  Called before the trees are evaluated.
+		*/
+		void SyncTreePrecision() const;
+
 	private:
 
 		/**
@@ -1292,6 +1759,99 @@ namespace bertini {
 	    */
 	    void ConstructOrdering() const;
 
+		/**
+		 Gather the roots of all the trees of the system: the functions, subfunctions, explicit parameters, constant subfunctions, and Jacobians if they have been computed.
+		*/
+		std::vector< std::shared_ptr<node::Node> > Roots() const;
+
+		/**
+		 Compile the functions, and the Jacobian if it is computed symbolically, into the straight-line program, and store it internally.
+		*/
+		void CompileStraightLineProgram() const;
+
+		/**
+		 Expand the functions into sums of monomials, if they are polynomial in the variables and path variable, and store the result internally.
+		*/
+		void ExpandPolynomials() const;
+
+		/**
+		 Whether evaluation runs the StraightLineProgram, either interpreted or as native code.
+		*/
+		bool UseStraightLineProgram() const
+		{
+			return eval_method_==EvalMethod::StraightLine || eval_method_==EvalMethod::Native;
+		}
+
+		/**
+		 Whether evaluation goes through the expanded polynomials, expanding them if necessary.
+
+		 \throws std::runtime_error if the evaluation method is Polynomial, and the system is not polynomial.
+		*/
+		bool UsePolynomialForm() const
+		{
+			if (eval_method_!=EvalMethod::Polynomial && eval_method_!=EvalMethod::Automatic)
+				return false;
+
+			if (!is_expanded_)
+				ExpandPolynomials();
+
+			if (eval_method_==EvalMethod::Polynomial && !have_polynomial_form_)
+				throw std::runtime_error("system is not polynomial in its variables and path variable, so cannot be evaluated by EvalMethod::Polynomial");
+			return have_polynomial_form_;
+		}
+
+		/**
+		 Mark the function trees as needing a fresh evaluation, where they depend on inputs which have changed since the last evaluation.  The dependencies of the nodes on the inputs are found on first use after a change in structure.
+		*/
+		void ResetFunctionTrees() const;
+
+		/**
+		 Forget everything computed from the structure of the system: the straight-line program, and the dependencies of the nodes on the inputs.  The next evaluation resets the function trees entirely, since new nodes may carry values from elsewhere.  Called whenever the functions or variables change.
+		*/
+		void InvalidateStructure() const
+		{
+			is_compiled_ = false;
+			have_dependencies_ = false;
+			reset_all_nodes_ = true;
+			have_distinct_nodes_ = false;
+			trees_at_system_precision_ = false;
+			is_expanded_ = false;
+			have_jacobian_sparsity_ = false;
+		}
+
+		/**
+		 The columns of the structurally nonzero entries of the rows of the Jacobian for the functions, finding them if not found since the structure last changed.
+		*/
+		std::vector< std::vector<int> > const& FunctionJacobianSparsity() const;
+
+		/**
+		 Give a sparse matrix the size and sparsity pattern of the Jacobian, in compressed form.
+		*/
+		template<typename T>
+		void SetJacobianSparsityPattern(SparseMat<T> & J) const
+		{
+			const auto sparsity = JacobianSparsity();
+
+			std::vector< Eigen::Triplet<T> > entries;
+			entries.reserve(NumJacobianNonzeros());
+			for (size_t ii = 0; ii < sparsity.size(); ++ii)
+				for (auto jj : sparsity[ii])
+					entries.emplace_back(ii, jj, T(0));
+
+			J.resize(NumTotalFunctions(), NumVariables());
+			J.setFromTriplets(entries.begin(), entries.end());
+			J.makeCompressed();
+		}
+
+		/**
+		 Whether derivatives are computed by reverse-mode differentiation of the straight-line program, either by request, or by automatic choice.
+		*/
+		bool UseReverseMode() const
+		{
+			return jacobian_method_==JacobianMethod::ReverseMode ||
+			       (jacobian_method_==JacobianMethod::Automatic && GetStraightLineProgram().PreferReverseMode());
+		}
+
 
 		VariableGroup ungrouped_variables_; ///< ungrouped variable nodes.  Not in an affine variable group, not in a projective group.  Just hanging out, being a variable.
 		std::vector< VariableGroup > variable_groups_; ///< Affine variable groups.  When system is homogenized, will have a corresponding homogenizing variable.
@@ -1326,6 +1886,37 @@ namespace bertini {
 
 		mutable unsigned precision_; ///< the current working precision of the system 
 
+		EvalMethod eval_method_ = EvalMethod::Automatic; ///< How the system evaluates itself.
+		JacobianMethod jacobian_method_ = JacobianMethod::Symbolic; ///< How the system computes its derivatives.
+		mutable StraightLineProgram straight_line_program_; ///< The compiled form of the functions and jacobian.  Used when eval_method_ is StraightLine, or jacobian_method_ is ForwardMode.
+		mutable bool is_compiled_ = false; ///< Whether straight_line_program_ is current with respect to the function and jacobian trees.
+		mutable SparsePolynomialSystem polynomial_form_; ///< The functions expanded into sums of monomials.  Used when eval_method_ is Polynomial, or Automatic and the system is polynomial.
+		mutable bool is_expanded_ = false; ///< Whether expansion of the functions has been attempted since the structure last changed.
+		mutable bool have_polynomial_form_ = false; ///< Whether that expansion succeeded, so that polynomial_form_ is current.
+		mutable std::vector< std::vector<int> > function_jacobian_sparsity_; ///< For each function, the columns of the structurally nonzero entries of its row of the Jacobian.
+		mutable size_t num_function_jacobian_nonzeros_ = 0; ///< The total size of function_jacobian_sparsity_.
+		mutable bool have_jacobian_sparsity_ = false; ///< Whether function_jacobian_sparsity_ is current with respect to the function trees.
+		double sparse_density_threshold_ = 0.1; ///< The density of the Jacobian below which predictors and correctors use sparse linear algebra.
+
+		/**
+		\brief The kinds of input to the system, as indices into changed_inputs_ and dependent_nodes_.  Nodes depending on variables of none of these kinds come last in dependent_nodes_, and are always reset.
+		*/
+		enum InputKind
+		{
+			VariableInput,
+			PathVariableInput,
+			ImplicitParameterInput,
+			NumInputKinds
+		};
+
+		mutable std::vector< std::vector< std::shared_ptr<const node::Node> > > dependent_nodes_; ///< The nodes of the function trees depending on each kind of input, and last, those depending on other variables.
+		mutable bool have_dependencies_ = false; ///< Whether dependent_nodes_ is current with respect to the function trees.
+		mutable std::array<bool, NumInputKinds> changed_inputs_ = {{true, true, true}}; ///< Which kinds of input have been set since the function trees were last reset.
+		mutable bool reset_all_nodes_ = true; ///< Whether the next evaluation must reset the function trees entirely, as after a change in precision or structure.
+		mutable std::vector< std::shared_ptr<const node::Node> > distinct_nodes_; ///< The nodes of all the trees of the system, each once, for changing their precision.
+		mutable bool have_distinct_nodes_ = false; ///< Whether distinct_nodes_ is current with respect to the trees.
+		mutable bool trees_at_system_precision_ = false; ///< Whether the nodes of the trees are at precision_.  If not, they are brought there before they are next evaluated.
+
 
 		friend class boost::serialization::access;
 
@@ -44,6 +44,26 @@ namespace bertini{
 			using AdaptiveMultiplePrecisionConfig = config::AdaptiveMultiplePrecisionConfig;
 
 
+			/**
+			\brief Evaluate the right hand side of the inequality of Criterion A
+
+			From \cite AMP1, \cite AMP2.
+
+			\param norm_J The matrix norm of the Jacoabian matrix
+			\param norm_J_inverse An estimate on the norm of the inverse of the Jacobian matrix.
+			\param AMP_config The settings for adaptive multiple precision.
+
+			\tparam RealType The real number type
+
+			\return The number of digits Criterion A requires.
+			*/
+			template<typename RealType>
+			RealType CriterionARHS(RealType const& norm_J, RealType const& norm_J_inverse, AdaptiveMultiplePrecisionConfig const& AMP_config)
+			{
+				return AMP_config.safety_digits_1 + log10(norm_J_inverse * RealType(AMP_config.epsilon) * (norm_J + RealType(AMP_config.Phi) ) );
+			}
+
+
 			/**
 			\brief Check AMP Criterion A.
 
@@ -62,7 +82,7 @@ namespace bertini{
 			template<typename RealType>
 			bool CriterionA(RealType const& norm_J, RealType const& norm_J_inverse, AdaptiveMultiplePrecisionConfig const& AMP_config)
 			{
-				return NumTraits<RealType>::NumDigits()  > AMP_config.safety_digits_1 + log10(norm_J_inverse * RealType(AMP_config.epsilon) * (norm_J + RealType(AMP_config.Phi) ) );
+				return NumTraits<RealType>::NumDigits()  > CriterionARHS(norm_J, norm_J_inverse, AMP_config);
 			}
 			
 
@@ -199,6 +219,42 @@ namespace bertini{
 
 				return NumTraits<RealType>::NumDigits() > CriterionCRHS(norm_J_inverse, z, tracking_tolerance, AMP_config);
 			}
+
+
+
+			/**
+			\brief The tiers of precision, from cheapest to most expensive.
+			*/
+			enum class PrecisionTier
+			{
+				Double, ///< Hardware double precision, 16 digits.
+				DoubleDouble, ///< Pairs of doubles, 32 digits.  See dd_real.
+				Multiple ///< Arbitrary precision, with mpfr.
+			};
+
+
+			/**
+			\brief Choose the cheapest precision in which Criteria A and C both hold.
+
+			The digits needed are the larger of the right hand sides of Criterion A and Criterion C, and the tier is the first whose digits exceed them.  Criterion B depends on the Newton iteration, and is left to the tracker.
+
+			\param norm_J The matrix norm of the Jacoabian matrix
+			\param norm_J_inverse An estimate on the norm of the inverse of the Jacobian matrix.
+			\param norm_z The norm of the current space point.
+			\param tracking_tolerance The tightness to which the path should be tracked.
+			\param AMP_config The settings for adaptive multiple precision.
+			*/
+			template<typename RealType>
+			PrecisionTier CheapestSufficientTier(RealType const& norm_J, RealType const& norm_J_inverse, RealType const& norm_z, RealType const& tracking_tolerance, AdaptiveMultiplePrecisionConfig const& AMP_config)
+			{
+				using std::max;
+				RealType digits_needed = max(CriterionARHS(norm_J, norm_J_inverse, AMP_config),
+				                             CriterionCRHS(norm_J_inverse, norm_z, tracking_tolerance, AMP_config));
+
+				if (!(digits_needed < NumTraits<double>::NumDigits())) // written so that NaN goes to the top
+					return digits_needed < NumTraits<dd_real>::NumDigits() ? PrecisionTier::DoubleDouble : PrecisionTier::Multiple;
+				return PrecisionTier::Double;
+			}
 		}
 	}
 	
@@ -34,6 +34,8 @@
 #ifndef BERTINI_AMP_TRACKER_HPP
 #define BERTINI_AMP_TRACKER_HPP
 
+#include <chrono>
+
 #include "bertini2/tracking/base_tracker.hpp"
 
 
@@ -344,6 +346,25 @@ namespace bertini{
 				preserve_precision_ = should_preseve_precision;
 			}
 
+
+			/**
+			\brief See how many times precision has changed during the current or most recent track.
+			*/
+			unsigned NumPrecisionChanges() const
+			{
+				return num_precision_changes_;
+			}
+
+			/**
+			\brief See how long, in seconds, changing precision has taken during the current or most recent track.
+
+			This is the time to convert the system, predictor, corrector, and temporaries to the new precision, not including the refinement of the current point after an increase.
+			*/
+			double SecondsChangingPrecision() const
+			{
+				return seconds_changing_precision_;
+			}
+
 			
 			virtual ~AMPTracker() = default;
 
@@ -455,6 +476,8 @@ namespace bertini{
 			{
 				Tracker::ResetCountersBase();
 				num_precision_decreases_ = 0;
+				num_precision_changes_ = 0;
+				seconds_changing_precision_ = 0;
 				num_successful_steps_since_stepsize_increase_ = 0;
 				num_successful_steps_since_precision_decrease_ = 0;
 				// initialize to the frequency so guaranteed to compute it the first try 	
@@ -1303,6 +1326,7 @@ namespace bertini{
 
 				NotifyObservers(PrecisionChanged<EmitterType>(*this,current_precision_,new_precision));
 				
+				const auto change_started = std::chrono::steady_clock::now();
 
 				bool upsampling_needed = new_precision > current_precision_;
 				// reset the counter for estimating the condition number.  
@@ -1329,6 +1353,8 @@ namespace bertini{
 				assert(PrecisionSanityCheck() && "precision sanity check failed.  some internal variable is not in correct precision");
 				#endif
 
+				++num_precision_changes_;
+				seconds_changing_precision_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - change_started).count();
 
 				if (refine_if_necessary && upsampling_needed)
 					return RefineStoredPoint();
@@ -1619,6 +1645,8 @@ namespace bertini{
 			mutable unsigned num_precision_decreases_; ///< The number of times precision has decreased this track.
 			mutable unsigned initial_precision_; ///< The precision at the start of tracking.
 			mutable unsigned num_successful_steps_since_precision_decrease_; ///< The number of successful steps since decreased precision.
+			mutable unsigned num_precision_changes_ = 0; ///< The number of times precision has changed this track.
+			mutable double seconds_changing_precision_ = 0; ///< The time spent changing precision this track, excluding refinement.
 
 			mutable mpfr endtime_highest_precision_;
 
@@ -348,6 +348,16 @@ namespace bertini{
 				return num_failed_steps_taken_ + num_successful_steps_taken_;
 			}
 
+			/**
+			\brief See how many factorizations of the Jacobian the corrector has skipped.
+
+			Nonzero only if config::Newton::reuse_factorization is set.  Counts since the tracker was made.  See NewtonCorrector.
+			*/
+			unsigned long long NumFactorizationsSkipped() const
+			{
+				return corrector_->NumFactorizationsSkipped();
+			}
+
 			/**
 			\brief Set how large the stepsize should be.
 
@@ -0,0 +1,328 @@
+//This file is part of Bertini 2.
+//
+//distributed_solve.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//distributed_solve.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with distributed_solve.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+/**
+\file distributed_solve.hpp
+
+\brief Provides DistributedSolve, which tracks every path from a start system to a target system, on a set of worker processes managed by the calling process.
+*/
+
+#ifndef BERTINI_TRACKING_DISTRIBUTED_SOLVE_HPP
+#define BERTINI_TRACKING_DISTRIBUTED_SOLVE_HPP
+
+#include <deque>
+#include <functional>
+
+#include "bertini2/tracking/solve.hpp"
+
+namespace bertini {
+
+	namespace tracking {
+
+		/**
+		\namespace distributed
+
+		\brief The communication between the manager and worker processes of DistributedSolve.
+
+		Messages are strings, sent over a socket with their length in front.  Systems are serialized with SaveSystem, and everything else with Pack.
+		*/
+		namespace distributed {
+
+			/**
+			\brief A worker process, and the socket the manager uses to talk to it.
+			*/
+			struct WorkerProcess
+			{
+				int pid = -1;
+				int socket = -1;
+			};
+
+			/**
+			\brief Fork a worker process, connected to this one by a socket.
+
+			The child closes the given sockets, which belong to other workers, runs worker_main on its end of the new socket, and exits, without returning from Spawn.  It exits with status 1 if worker_main throws.
+
+			\param worker_main The body of the worker.
+			\param close_in_child The sockets of other workers, which the child should not hold open.
+			\return The process, and the manager's end of the socket.
+
+			\throws std::runtime_error if the socket or the process cannot be made.
+			*/
+			WorkerProcess Spawn(std::function<void(int)> const& worker_main, std::vector<int> const& close_in_child);
+
+			/**
+			\brief Close the manager's socket to a worker, and wait for the worker to exit.
+			*/
+			void Retire(WorkerProcess & worker);
+
+			/**
+			\brief Kill a worker, and wait for it to exit.
+			*/
+			void Kill(WorkerProcess & worker);
+
+			/**
+			\brief Send a message over a socket.
+
+			\return Whether the whole message was sent.  False if the other end is gone.
+			*/
+			bool Send(int socket, std::string const& message);
+
+			/**
+			\brief Receive a message sent by Send.
+
+			\return Whether a whole message was received.  False if the other end is gone.
+			*/
+			bool Receive(int socket, std::string & message);
+
+			/**
+			\brief Wait until one of the sockets has a message, or has been closed at the other end.
+
+			\return The position in sockets of one such socket.
+			*/
+			size_t WaitForAny(std::vector<int> const& sockets);
+
+
+			/**
+			\brief A set of consecutive start points, handed to a worker at once.
+			*/
+			template<typename ComplexType>
+			struct Batch
+			{
+				unsigned long long first_index = 0; ///< The index of the first start point.
+				std::vector<Vec<ComplexType> > start_points;
+
+				template <typename Archive>
+				void serialize(Archive& ar, const unsigned version)
+				{
+					ar & first_index;
+					ar & start_points;
+				}
+			};
+
+
+			/**
+			\brief The body of a worker process.
+
+			Receives the homotopy, then batch after batch of start points, replying to each with the results of tracking them.  Returns when it receives an empty batch, or the manager goes away.
+
+			\param socket The worker's end of the socket to the manager.
+			\param settings The settings for tracking.
+			\param before_each_path Called with the index of each start point, before tracking it.  May be empty.
+			*/
+			template<typename TrackerType, typename EndgameType>
+			void RunWorker(int socket, config::Solver<typename TrackerTraits<TrackerType>::BaseRealType> const& settings, std::function<void(unsigned long long)> const& before_each_path)
+			{
+				using BCT = typename TrackerTraits<TrackerType>::BaseComplexType;
+
+				std::string message;
+				if (!Receive(socket, message))
+					return;
+
+				System homotopy;
+				LoadSystem(message, homotopy);
+				PathSolver<TrackerType, EndgameType> solver(homotopy, settings);
+
+				while (Receive(socket, message))
+				{
+					Batch<BCT> batch;
+					Unpack(message, batch);
+					if (batch.start_points.empty())
+						return;
+
+					std::vector<SolveResult<BCT> > results;
+					for (unsigned ii = 0; ii < batch.start_points.size(); ++ii)
+					{
+						auto index = batch.first_index + ii;
+						if (before_each_path)
+							before_each_path(index);
+
+						solver.ResetPrecision();
+						results.push_back(solver.Run(index, batch.start_points[ii]));
+					}
+
+					if (!Send(socket, Pack(results)))
+						return;
+				}
+			}
+
+		} // re: namespace distributed
+
+
+
+		/**
+		\brief Track every path from a start system to a target system, on a set of worker processes.
+
+		The calling process is the manager.  It builds the homotopy with GammaTrickHomotopy, serializes it once, and forks the workers, sending each the serialized homotopy.  It then hands out batches of consecutive start points, and gathers the results.  The workers track in one thread each, and since each has its own mpfr default precision, multiple precision trackers run in parallel here, unlike in Solve.
+
+		If a worker dies, its batch is handed out again, to a new worker taking its place.  A batch on which workers die settings.max_attempts times is given up on, and its paths reported with tracking_success SuccessCode::Failure.  Exceptions thrown by the tracker or endgame in a worker kill the worker, and so are handled the same way.
+
+		The workers are local processes, connected to the manager by sockets.  The messages are plain strings, so the workers could as well be remote.
+
+		\param target The system to solve.  Homogenized and patched, as the start system must be.
+		\param start_system The start system, providing NumStartPoints() and StartPoint<T>(index).  Start points are generated by the manager.
+		\param settings The number of workers, the batch size, and the settings for tracking.
+		\param before_each_path Called in the worker process, with the index of each start point, before tracking it.  For monitoring, and for testing recovery from crashes.  May be empty.
+		\return One result per start point, in order of start point index.
+
+		\tparam TrackerType The type of tracker to use, such as AMPTracker or DoublePrecisionTracker.
+		\tparam EndgameType The type of endgame to run at the end of each path.
+		\tparam StartSystemType The type of the start system.
+		*/
+		template<typename TrackerType, typename EndgameType = typename EndgameSelector<TrackerType>::Cauchy, typename StartSystemType>
+		std::vector<SolveResult<typename TrackerTraits<TrackerType>::BaseComplexType> >
+		DistributedSolve(System const& target, StartSystemType const& start_system, config::Distributed<typename TrackerTraits<TrackerType>::BaseRealType> const& settings, std::function<void(unsigned long long)> const& before_each_path = {})
+		{
+			using BCT = typename TrackerTraits<TrackerType>::BaseComplexType;
+			using namespace distributed;
+
+			if (settings.num_workers==0 || settings.batch_size==0 || settings.max_attempts==0)
+				throw std::runtime_error("distributed solve requires positive numbers of workers, paths per batch, and attempts per batch");
+
+			auto num_paths = static_cast<unsigned long long>(start_system.NumStartPoints());
+			std::vector<SolveResult<BCT> > results(num_paths);
+
+			const auto serialized_homotopy = SaveSystem(GammaTrickHomotopy(target, start_system));
+
+			struct Assignment
+			{
+				unsigned long long first_index, num_paths;
+				unsigned attempts;
+			};
+
+			std::deque<Assignment> pending;
+			for (unsigned long long ii = 0; ii < num_paths; ii += settings.batch_size)
+				pending.push_back({ii, std::min<unsigned long long>(settings.batch_size, num_paths-ii), 0});
+
+			struct Slot
+			{
+				WorkerProcess process;
+				bool busy;
+				Assignment assignment;
+			};
+			std::vector<Slot> slots(std::min<unsigned long long>(settings.num_workers, pending.size()));
+
+			auto sockets_of_others = [&slots](size_t except)
+			{
+				std::vector<int> sockets;
+				for (size_t ii = 0; ii < slots.size(); ++ii)
+					if (ii!=except && slots[ii].process.socket>=0)
+						sockets.push_back(slots[ii].process.socket);
+				return sockets;
+			};
+
+			auto worker_main = [&settings, &before_each_path](int socket)
+			{
+				RunWorker<TrackerType, EndgameType>(socket, settings.solver, before_each_path);
+			};
+
+			auto start_worker = [&](size_t ii)
+			{
+				slots[ii].process = Spawn(worker_main, sockets_of_others(ii));
+				slots[ii].busy = false;
+				Send(slots[ii].process.socket, serialized_homotopy); // if the worker died already, the next send fails, too
+			};
+
+			// a worker died, either on its batch, or before taking it
+			auto replace_worker = [&](size_t ii)
+			{
+				Kill(slots[ii].process);
+				auto a = slots[ii].assignment;
+				if (++a.attempts < settings.max_attempts)
+					pending.push_front(a);
+				else
+					for (auto jj = a.first_index; jj < a.first_index+a.num_paths; ++jj)
+						results[jj].start_index = jj; // tracking_success is already Failure
+				start_worker(ii);
+			};
+
+			for (size_t ii = 0; ii < slots.size(); ++ii)
+				start_worker(ii);
+
+			while (true)
+			{
+				for (size_t ii = 0; ii < slots.size() && !pending.empty(); ++ii)
+				{
+					if (slots[ii].busy)
+						continue;
+
+					auto a = pending.front();
+					pending.pop_front();
+
+					Batch<BCT> batch;
+					batch.first_index = a.first_index;
+					for (auto jj = a.first_index; jj < a.first_index+a.num_paths; ++jj)
+						batch.start_points.push_back(start_system.template StartPoint<BCT>(jj));
+
+					slots[ii].assignment = a;
+					if (Send(slots[ii].process.socket, Pack(batch)))
+						slots[ii].busy = true;
+					else
+						replace_worker(ii);
+				}
+
+				std::vector<size_t> busy;
+				std::vector<int> busy_sockets;
+				for (size_t ii = 0; ii < slots.size(); ++ii)
+					if (slots[ii].busy)
+					{
+						busy.push_back(ii);
+						busy_sockets.push_back(slots[ii].process.socket);
+					}
+
+				if (busy.empty())
+				{
+					if (pending.empty())
+						break;
+					continue;
+				}
+
+				auto ii = busy[WaitForAny(busy_sockets)];
+				slots[ii].busy = false;
+
+				std::string message;
+				if (Receive(slots[ii].process.socket, message))
+				{
+					std::vector<SolveResult<BCT> > batch_results;
+					Unpack(message, batch_results);
+					for (auto& r : batch_results)
+						results[r.start_index] = std::move(r);
+				}
+				else
+					replace_worker(ii);
+			}
+
+			const auto empty_batch = Pack(Batch<BCT>());
+			for (auto& s : slots)
+			{
+				Send(s.process.socket, empty_batch);
+				Retire(s.process);
+			}
+
+			return results;
+		}
+
+	} // re: namespace tracking
+} // re: namespace bertini
+
+#endif
@@ -34,6 +34,8 @@
 
 #include "bertini2/tracking/amp_criteria.hpp"
 #include "bertini2/tracking/tracking_config.hpp"
+#include "bertini2/tracking/sparse_jacobian_lu.hpp"
+#include "bertini2/tracking/mixed_precision_lu.hpp"
 
 #include "bertini2/system.hpp"
 #include "bertini2/mpfr_extensions.hpp"
@@ -179,6 +181,10 @@ namespace bertini{
 			 ExplicitRKPredictors<Complex,Real> euler(config::Predictor::Euler, sys)
 			 success_code = euler.Predict( ... )
 			 \endcode
+			 
+			 For systems for which System::UseSparseLinearAlgebra holds, the Jacobian of each stage is evaluated and factored sparsely.  See SparseJacobianLU.
+
+			 With config::AdaptiveMultiplePrecisionConfig::mixed_precision_linear_solves set, the dense Jacobians of the stages of the adaptive precision Predict in multiple precision are factored in low precision, and the stages refined in the full precision.  See MixedPrecisionLU.
 			 */
 			class ExplicitRKPredictor
 			{
@@ -328,6 +334,10 @@ namespace bertini{
 					std::get< Mat<mpfr> >(dh_dx_temp_).resize(numTotalFunctions_, numVariables_);
 					std::get< Vec<dbl> >(dh_dt_temp_).resize(numTotalFunctions_);
 					std::get< Vec<mpfr> >(dh_dt_temp_).resize(numTotalFunctions_);
+					std::get< Vec<dbl> >(norm_estimate_x_).resize(numVariables_);
+					std::get< Vec<mpfr> >(norm_estimate_x_).resize(numVariables_);
+					std::get< Vec<dbl> >(norm_estimate_y_).resize(numVariables_);
+					std::get< Vec<mpfr> >(norm_estimate_y_).resize(numVariables_);
 
 					ResizeK();
 				}
@@ -361,6 +371,11 @@ namespace bertini{
 					Precision(std::get< Vec<mpfr> >(dh_dt_temp_),new_precision);
 					Precision(std::get< Mat<mpfr> >(dh_dx_0_),new_precision);
 					Precision(std::get< Mat<mpfr> >(dh_dx_temp_),new_precision);
+					Precision(std::get< Vec<mpfr> >(norm_estimate_x_),new_precision);
+					Precision(std::get< Vec<mpfr> >(norm_estimate_y_),new_precision);
+					Precision(std::get< Vec<mpfr> >(stage_temp_),new_precision);
+					std::get< MixedPrecisionLU<mpfr> >(mixed_LU_0_).ChangePrecision(new_precision);
+					std::get< MixedPrecisionLU<mpfr> >(mixed_LU_temp_).ChangePrecision(new_precision);
 
 					Precision(std::get< Mat<mpfr_float> >(a_),new_precision);
 					Precision(std::get< Vec<mpfr_float> >(b_),new_precision);
@@ -476,6 +491,9 @@ namespace bertini{
 					static_assert(std::is_same<typename Eigen::NumTraits<RealType>::Real, typename Eigen::NumTraits<ComplexType>::Real>::value,"underlying complex type and the type for comparisons must match");
 					static_assert(std::is_same<typename Derived::Scalar, ComplexType>::value, "scalar types must match");
 
+					mixed_precision_solves_ = AMP_config.mixed_precision_linear_solves;
+					std::get< MixedPrecisionLU<ComplexType> >(mixed_LU_0_).SetMaxRefinementIterations(AMP_config.max_refinement_iterations);
+					std::get< MixedPrecisionLU<ComplexType> >(mixed_LU_temp_).SetMaxRefinementIterations(AMP_config.max_refinement_iterations);
 					
 					auto success_code = Predict<ComplexType, RealType>(next_space, S, current_space, current_time, delta_t,
 																	   condition_number_estimate, num_steps_since_last_condition_number_computation,
@@ -485,21 +503,24 @@ namespace bertini{
 						return success_code;
 					
 					// Calculate condition number and updated if needed
-					Eigen::PartialPivLU<Mat<ComplexType>>& LUref = GetLU<ComplexType>();
-					Mat<ComplexType>& dhdxref = std::get< Mat<ComplexType> >(dh_dx_0_);
+					auto& sparse_LU_ref = std::get< SparseJacobianLU<ComplexType> >(sparse_LU_0_);
 					
-					Vec<ComplexType> randy = RandomOfUnits<ComplexType>(S.NumVariables());
-					Vec<ComplexType> temp_soln = LUref.solve(randy);
-					
-					norm_J = dhdxref.norm();
-					norm_J_inverse = temp_soln.norm();
+					norm_J = use_sparse_ ? sparse_LU_ref.Norm() : std::get< Mat<ComplexType> >(dh_dx_0_).norm();
 					
 					if (num_steps_since_last_condition_number_computation >= frequency_of_CN_estimation)
 					{
+						auto& x = std::get< Vec<ComplexType> >(norm_estimate_x_);
+						auto& y = std::get< Vec<ComplexType> >(norm_estimate_y_);
+						if (use_sparse_)
+							norm_J_inverse = sparse_LU_ref.EstimateInverseNorm(x, y);
+						else if (use_mixed_)
+							norm_J_inverse = std::get< MixedPrecisionLU<ComplexType> >(mixed_LU_0_).NormJInverse();
+						else
+							norm_J_inverse = EstimateInverseNorm(GetLU<ComplexType>(), x, y);
 						condition_number_estimate = norm_J * norm_J_inverse;
 						num_steps_since_last_condition_number_computation = 1; // reset the counter to 1
 					}
-					else // no need to compute the condition number
+					else // no need to estimate the condition number.  the estimate of the norm of the inverse passed in, from a recent step, stands
 						num_steps_since_last_condition_number_computation++;
 					
 					
@@ -809,7 +830,48 @@ namespace bertini{
 					if (std::is_same<typename Derived::Scalar, mpfr>::value)
 						PrecisionSanityCheck();
 
-					if(stage == 0)
+					if (stage == 0)
+					{
+						use_sparse_ = S.UseSparseLinearAlgebra();
+						use_mixed_ = mixed_precision_solves_ && !use_sparse_ && std::is_same<ComplexType, mpfr>::value;
+					}
+
+					if (use_sparse_)
+					{
+						// the factorization of the first stage is kept, for the AMP criteria
+						auto& sparse_LU_ref = std::get< SparseJacobianLU<ComplexType> >(stage == 0 ? sparse_LU_0_ : sparse_LU_temp_);
+						if (!sparse_LU_ref.Factor(S, space, time))
+							return SuccessCode::MatrixSolveFailureFirstPartOfPrediction;
+
+						Vec<ComplexType>& dhdtref = std::get< Vec<ComplexType> >(dh_dt_temp_);
+						S.TimeDerivativeInPlace(dhdtref, space, time);
+						Vec<ComplexType>& stage_ref = std::get< Vec<ComplexType> >(stage_temp_);
+						sparse_LU_ref.Solve(stage_ref, -dhdtref);
+						if (!stage_ref.allFinite())
+							return SuccessCode::MatrixSolveFailureFirstPartOfPrediction;
+						K.col(stage) = stage_ref;
+
+						return SuccessCode::Success;
+					}
+					else if (use_mixed_)
+					{
+						// as for the sparse factorizations, that of the first stage is kept for the AMP criteria
+						auto& mixed_LU_ref = std::get< MixedPrecisionLU<ComplexType> >(stage == 0 ? mixed_LU_0_ : mixed_LU_temp_);
+						Mat<ComplexType>& dhdxref = std::get< Mat<ComplexType> >(stage == 0 ? dh_dx_0_ : dh_dx_temp_);
+						S.JacobianInPlace(dhdxref, space, time);
+						if (!mixed_LU_ref.Factor(dhdxref))
+							return SuccessCode::MatrixSolveFailureFirstPartOfPrediction;
+
+						Vec<ComplexType>& dhdtref = std::get< Vec<ComplexType> >(dh_dt_temp_);
+						S.TimeDerivativeInPlace(dhdtref, space, time);
+						Vec<ComplexType>& stage_ref = std::get< Vec<ComplexType> >(stage_temp_);
+						if (!mixed_LU_ref.Solve(stage_ref, dhdxref, -dhdtref))
+							return SuccessCode::MatrixSolveFailureFirstPartOfPrediction;
+						K.col(stage) = stage_ref;
+
+						return SuccessCode::Success;
+					}
+					else if(stage == 0)
 					{
 						Eigen::PartialPivLU<Mat<ComplexType>>& LUref = GetLU<ComplexType>();
 						Mat<ComplexType>& dhdxref = std::get< Mat<ComplexType> >(dh_dx_0_);
@@ -996,7 +1058,17 @@ namespace bertini{
 				mutable std::tuple< Mat<dbl>, Mat<mpfr> > dh_dx_0_;  // Jacobian for the initial stage.  Use for AMP testing
 				mutable std::tuple< Mat<dbl>, Mat<mpfr> > dh_dx_temp_;  // Temporary jacobian for all other stages
 				mutable std::tuple< Vec<dbl>, Vec<mpfr> > dh_dt_temp_;  // Temporary time derivative used for all stages
+				mutable std::tuple< Vec<dbl>, Vec<mpfr> > norm_estimate_x_;  // Work vectors for estimating the norm of the inverse of the Jacobian
+				mutable std::tuple< Vec<dbl>, Vec<mpfr> > norm_estimate_y_;
 				// std::tuple< Eigen::PartialPivLU<Mat<dbl>>, Eigen::PartialPivLU<Mat<mpfr>> > LU_0_;  // LU from the intial stage used for AMP testing
+				mutable std::tuple< SparseJacobianLU<dbl>, SparseJacobianLU<mpfr> > sparse_LU_0_;  // Sparse Jacobian and LU for the initial stage, for systems with System::UseSparseLinearAlgebra.  Use for AMP testing
+				mutable std::tuple< SparseJacobianLU<dbl>, SparseJacobianLU<mpfr> > sparse_LU_temp_;  // Sparse Jacobian and LU for all other stages
+				mutable std::tuple< Vec<dbl>, Vec<mpfr> > stage_temp_;  // Temporary stage variable, for the sparse and mixed-precision solves
+				mutable bool use_sparse_ = false;  // Whether the current prediction uses the sparse Jacobians
+				mutable std::tuple< MixedPrecisionLU<dbl>, MixedPrecisionLU<mpfr> > mixed_LU_0_;  // Factorization in low precision of the Jacobian of the initial stage, for mixed-precision linear solves.  Use for AMP testing
+				mutable std::tuple< MixedPrecisionLU<dbl>, MixedPrecisionLU<mpfr> > mixed_LU_temp_;  // Factorization in low precision for all other stages
+				mutable bool mixed_precision_solves_ = false;  // Whether the AMP settings of the current prediction ask for mixed-precision linear solves
+				mutable bool use_mixed_ = false;  // Whether the current prediction uses mixed_LU_0_ and mixed_LU_temp_
 
 				mutable Eigen::PartialPivLU<Mat<dbl>> LU_d_;
 				mutable std::map<unsigned,Eigen::PartialPivLU<Mat<mpfr>>> LU_mp_;
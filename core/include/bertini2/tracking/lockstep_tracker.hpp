@@ -0,0 +1,204 @@
+//This file is part of Bertini 2.
+//
+//lockstep_tracker.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//lockstep_tracker.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with lockstep_tracker.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+/**
+\file lockstep_tracker.hpp
+
+\brief Provides LockstepTracker, which tracks a bundle of paths together in double or double-double precision.
+*/
+
+#ifndef BERTINI_TRACKING_LOCKSTEP_TRACKER_HPP
+#define BERTINI_TRACKING_LOCKSTEP_TRACKER_HPP
+
+#include "bertini2/tracking/tracking_config.hpp"
+#include "bertini2/tracking/amp_criteria.hpp"
+#include "bertini2/system.hpp"
+
+namespace bertini {
+
+	namespace tracking {
+
+		/**
+		\brief Tracks a bundle of paths in double or double-double precision, in lock step.
+
+		Each step of the tracker is taken by all the paths of the bundle at once.  The system is evaluated at all their points in one sweep over its StraightLineProgram (see System::EvalBatch and System::JacobianBatch), so the cost of dispatching each instruction is shared by the bundle, and the loops over the paths vectorize.  The linear solves are done path by path.
+
+		Each path has its own time, step size, and count of successful steps, so paths of different difficulty proceed at different rates, measured in time, while taking the same number of steps.  Prediction is by the classical fourth-order Runge-Kutta method, and correction by Newton's method, with the same criteria for success as the DoublePrecisionTracker.  The step size is cut by step_size_fail_factor on failure, and raised by step_size_success_factor after consecutive_successful_steps_before_stepsize_increase successes, up to max_step_size.
+
+		A path drops out of the bundle, with a code other than Success, when:
+
+		- its step size falls below min_step_size (MinStepSizeReached),
+		- it takes max_num_steps steps (MaxNumStepsTaken),
+		- its norm exceeds the path truncation threshold (GoingToInfinity), or
+		- the precision of the bundle is too low to hold the tracking tolerance, by Criteria A and C of adaptive precision (HigherPrecisionNecessary).  See amp::CheapestSufficientTier.
+
+		The paths are tracked in the precision of the complex type they are given in, dbl or dd_complex.  Double-double costs roughly ten times double, but far less than mpfr at the same precision, so paths dropping out of a double bundle for HigherPrecisionNecessary are best continued in a double-double bundle, from the time and point at which they dropped out.  Paths which drop out should otherwise be tracked again by a regular tracker, in particular an AMPTracker for HigherPrecisionNecessary.  Solve does all this, when config::Solver::bundle_size is more than one.
+
+		\code{.cpp}
+		LockstepTracker tracker(homotopy);
+		tracker.Setup(1e-5, 1e5, config::Stepping<double>(), config::Newton());
+
+		std::vector<Vec<dbl> > endpoints;
+		auto codes = tracker.TrackPaths(endpoints, dbl(1), dbl(0.1), start_points);
+		\endcode
+
+		Like a System, a LockstepTracker may not be used by two threads at once.
+		*/
+		class LockstepTracker
+		{
+		public:
+
+			/**
+			\param sys The system to track on.  Must have a path variable, and must outlive the tracker.  Its degree and coefficient bounds set the constants of the precision criteria.
+			*/
+			LockstepTracker(System const& sys);
+
+			/**
+			\param sys The system to track on.  Must have a path variable, and must outlive the tracker.
+			\param amp_config The settings for adaptive precision, for the system, which set the constants of the precision criteria.
+			*/
+			LockstepTracker(System const& sys, config::AdaptiveMultiplePrecisionConfig const& amp_config);
+
+			/**
+			\brief Set the tolerances and the stepping and Newton settings.
+
+			\param tracking_tolerance The norm of the Newton step below which a corrector has converged.
+			\param path_truncation_threshold The norm of a point above which its path is taken to be going to infinity.
+			\param stepping The step size settings.
+			\param newton The numbers of Newton iterations.
+			*/
+			void Setup(double tracking_tolerance, double path_truncation_threshold,
+			           config::Stepping<double> const& stepping, config::Newton const& newton);
+
+			/**
+			\brief Set the tolerances and the stepping and Newton settings, from settings of another real type, as those of a solve in multiple precision.
+			*/
+			template<typename RealType>
+			void Setup(RealType const& tracking_tolerance, RealType const& path_truncation_threshold,
+			           config::Stepping<RealType> const& stepping, config::Newton const& newton)
+			{
+				config::Stepping<double> s;
+				s.initial_step_size = static_cast<double>(stepping.initial_step_size);
+				s.max_step_size = static_cast<double>(stepping.max_step_size);
+				s.min_step_size = static_cast<double>(stepping.min_step_size);
+				s.step_size_success_factor = static_cast<double>(stepping.step_size_success_factor);
+				s.step_size_fail_factor = static_cast<double>(stepping.step_size_fail_factor);
+				s.consecutive_successful_steps_before_stepsize_increase = stepping.consecutive_successful_steps_before_stepsize_increase;
+				s.min_num_steps = stepping.min_num_steps;
+				s.max_num_steps = stepping.max_num_steps;
+				s.frequency_of_CN_estimation = stepping.frequency_of_CN_estimation;
+				Setup(static_cast<double>(tracking_tolerance), static_cast<double>(path_truncation_threshold), s, newton);
+			}
+
+			/**
+			\brief The settings for adaptive precision, whose constants the precision criteria use.
+			*/
+			config::AdaptiveMultiplePrecisionConfig const& PrecisionConfig() const
+			{
+				return amp_config_;
+			}
+
+			/**
+			\brief Track a bundle of paths from a start time to an end time.
+
+			\param[out] endpoints The points at the end time, one per start point.  For paths which dropped out, the last point reached.
+			\param start_time The time at which all the paths start.
+			\param end_time The time at which all the paths end.
+			\param start_points The points from which to track, all at the start time.
+			\return One code per path.  Success for paths which reached the end time.
+
+			\throws std::runtime_error if a start point is not of the size of the system.
+			*/
+			std::vector<SuccessCode> TrackPaths(std::vector<Vec<dbl> > & endpoints,
+			                                    dbl const& start_time, dbl const& end_time,
+			                                    std::vector<Vec<dbl> > const& start_points) const;
+
+			/**
+			\brief Track a bundle of paths, each from its own start time, to an end time, in the precision of ComplexType.
+
+			\param[out] endpoints The points at the end time, one per start point.  For paths which dropped out, the last point reached.
+			\param[in,out] times In, the time at which each path starts.  Out, the time each path reached, which is end_time for those which succeeded.
+			\param end_time The time at which all the paths end.
+			\param start_points The points from which to track, each at its time.
+			\return One code per path.  Success for paths which reached the end time.
+
+			\tparam ComplexType dbl or dd_complex.
+
+			\throws std::runtime_error if a start point is not of the size of the system, or the numbers of times and start points differ.
+			*/
+			template<typename ComplexType>
+			std::vector<SuccessCode> TrackPaths(std::vector<Vec<ComplexType> > & endpoints,
+			                                    std::vector<ComplexType> & times, ComplexType const& end_time,
+			                                    std::vector<Vec<ComplexType> > const& start_points) const;
+
+		private:
+
+			/**
+			\brief The state of one path of the bundle.
+			*/
+			template<typename ComplexType>
+			struct PathState
+			{
+				ComplexType time;
+				double step_size;
+				unsigned num_steps = 0;
+				unsigned num_consecutive_successes = 0;
+				SuccessCode code = SuccessCode::Success;
+				bool active = true;
+			};
+
+			/**
+			\brief Compute \f$dx/dt = -J^{-1} \partial H/\partial t\f$ at a batch of points, one column per point.
+
+			\return For each column, whether the linear solve succeeded, and was well enough conditioned for the precision of ComplexType.
+			*/
+			template<typename ComplexType>
+			std::vector<SuccessCode> Velocities(Mat<ComplexType> & velocities, Mat<ComplexType> const& points, Vec<ComplexType> const& times) const;
+
+			/**
+			\brief The buffers for evaluation, reused from step to step, to avoid reallocation.
+			*/
+			template<typename ComplexType>
+			struct Workspace
+			{
+				std::vector<Mat<ComplexType> > jacobians;
+				Mat<ComplexType> time_derivatives;
+				Mat<ComplexType> function_values;
+			};
+
+			System const& system_;
+
+			double tracking_tolerance_ = 1e-5;
+			double path_truncation_threshold_ = 1e5;
+			config::Stepping<double> stepping_;
+			config::Newton newton_;
+			config::AdaptiveMultiplePrecisionConfig amp_config_;
+
+			mutable std::tuple<Workspace<dbl>, Workspace<dd_complex> > workspaces_;
+		};
+
+	} // re: namespace tracking
+} // re: namespace bertini
+
+#endif
@@ -0,0 +1,307 @@
+//This file is part of Bertini 2.
+//
+//mixed_precision_lu.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//mixed_precision_lu.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with mixed_precision_lu.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+
+#ifndef BERTINI_TRACKING_MIXED_PRECISION_LU_HPP
+#define BERTINI_TRACKING_MIXED_PRECISION_LU_HPP
+
+/**
+\file mixed_precision_lu.hpp
+
+\brief Provides MixedPrecisionLU, which solves linear systems in multiple precision by factoring in double or double-double, and refining in full precision.
+*/
+
+#include <array>
+#include <cmath>
+
+#include "bertini2/double_double.hpp"
+#include "bertini2/tracking/amp_criteria.hpp"
+
+namespace bertini{
+	namespace tracking{
+
+		/**
+		\brief Solves linear systems with a matrix of ComplexType by factoring a rounding of it in double or double-double precision, and refining the solutions with residuals computed in the full precision of ComplexType.
+
+		This is classical mixed-precision iterative refinement.  Each step of refinement costs one product of the matrix with a vector in full precision, \f$O(n^2)\f$, and a pair of triangular solves in the low precision, whereas factoring in full precision costs \f$O(n^3)\f$ operations in slow multiple-precision arithmetic.  Refinement converges, to the accuracy of a direct solve in the full precision, when the condition number of the matrix times the unit roundoff of the low precision is well below one, the error contracting by about that factor per step.
+
+		The low precision, the PrecisionTier of the factorization, is chosen from an estimate of the condition number \f$\kappa\f$, made from the factorization in double.  Each step of refinement gains about as many digits as the low precision has beyond the \f$\log_{10}\kappa\f$ lost to conditioning, so the tier is the cheaper of double and double-double in which the digits of ComplexType are reached, less those lost to conditioning, in few enough steps: at most max_refinement_iterations, and fewer than a third of the size of the matrix, beyond which the products with the matrix cost more than factoring it in full precision.  Failing both, the matrix is factored in full precision, and solving is direct.  If refinement stalls, the matrix is factored in full precision after all, until the next Factor.
+
+		The estimate of the norm of the inverse of the matrix, from whichever factorization is in use, is kept for the criteria of adaptive precision.
+
+		Only worth using when ComplexType is mpfr, but defined for dbl as well, so that code generic in the number type compiles.  For dbl, the double tier refines in double, which changes little.
+
+		\tparam ComplexType The number type of the matrix, dbl or mpfr.
+		*/
+		template<typename ComplexType>
+		class MixedPrecisionLU
+		{
+		public:
+			using RealType = typename Eigen::NumTraits<ComplexType>::Real;
+
+			/**
+			\param max_refinement_iterations The most steps of refinement to take, after which it is taken to have stalled.
+			*/
+			MixedPrecisionLU(unsigned max_refinement_iterations = 10) :
+				max_refinement_iterations_(max_refinement_iterations)
+			{}
+
+			/**
+			\brief Set the most steps of refinement to take, after which it is taken to have stalled.
+			*/
+			void SetMaxRefinementIterations(unsigned max_refinement_iterations)
+			{
+				max_refinement_iterations_ = max_refinement_iterations;
+			}
+
+			/**
+			\brief Change the precision of the work in full precision.  The factorization, if in full precision, is dropped, so Factor must be called before the next Solve.
+			*/
+			void ChangePrecision(unsigned new_precision)
+			{
+				Precision(residual_, new_precision);
+				Precision(correction_, new_precision);
+				Precision(norm_J_inverse_, new_precision);
+				LU_ = Eigen::PartialPivLU<Mat<ComplexType> >();
+			}
+
+			/**
+			\brief Factor a matrix, in the cheapest precision in which refinement should converge.
+
+			\param J The matrix.  Must be square.  Must be passed again, unchanged, to Solve.
+			\return Whether the factorization succeeded.  It fails only if the factorization in full precision, the last resort, fails the checks of LUPartialPivotDecompositionSuccessful.
+			*/
+			bool Factor(Mat<ComplexType> const& J)
+			{
+				const auto n = J.rows();
+				J_d_.resize(n, n);
+				for (Eigen::Index ii = 0; ii < n; ++ii)
+					for (Eigen::Index jj = 0; jj < n; ++jj)
+						J_d_(ii,jj) = ToDouble(J(ii,jj));
+
+				LU_d_.compute(J_d_);
+				const double norm_J = J_d_.cwiseAbs().colwise().sum().maxCoeff();
+				const double norm_J_inverse = EstimateInverseNorm(LU_d_, x_d_, y_d_);
+				const double digits_lost = std::log10(norm_J*norm_J_inverse);
+				const double digits_wanted = -std::log10(static_cast<double>(Eigen::NumTraits<ComplexType>::epsilon())) - digits_lost;
+				const double max_steps = std::min(double(max_refinement_iterations_), n/3.0);
+
+				// written so that NaN and infinity go to the full precision
+				auto refinement_pays = [&](unsigned digits_of_tier)
+					{
+						const double digits_per_step = digits_of_tier - digits_lost - 1;
+						return digits_per_step > 1 && std::ceil(digits_wanted/digits_per_step) <= max_steps;
+					};
+
+				if (refinement_pays(NumTraits<double>::NumDigits()) && LUPartialPivotDecompositionSuccessful(LU_d_.matrixLU())==MatrixSuccessCode::Success)
+					tier_ = amp::PrecisionTier::Double;
+				else if (refinement_pays(NumTraits<dd_real>::NumDigits()))
+				{
+					J_dd_.resize(n, n);
+					for (Eigen::Index ii = 0; ii < n; ++ii)
+						for (Eigen::Index jj = 0; jj < n; ++jj)
+							J_dd_(ii,jj) = ToDoubleDouble(J(ii,jj));
+					LU_dd_.compute(J_dd_);
+					tier_ = amp::PrecisionTier::DoubleDouble;
+				}
+				else
+					return FactorFully(J);
+
+				norm_J_inverse_ = RealType(norm_J_inverse);
+				condition_number_ = norm_J*norm_J_inverse;
+				++num_factorizations_[static_cast<int>(tier_)];
+				return true;
+			}
+
+			/**
+			\brief Solve \f$Jx = b\f$, by refinement, or directly with a factorization in full precision.
+
+			\param[out] x The solution.
+			\param J The matrix last passed to Factor.
+			\param b The right hand side.
+			\return Whether the solve succeeded.  It fails only if refinement stalls, and then the factorization in full precision fails.
+			*/
+			template<typename Derived>
+			bool Solve(Vec<ComplexType> & x, Mat<ComplexType> const& J, Eigen::MatrixBase<Derived> const& b)
+			{
+				if (tier_==amp::PrecisionTier::Multiple)
+				{
+					x = LU_.solve(b);
+					return true;
+				}
+
+				const RealType epsilon = Eigen::NumTraits<ComplexType>::epsilon();
+
+				residual_ = b;
+				x.resize(J.cols());
+				for (Eigen::Index ii = 0; ii < x.size(); ++ii)
+					x(ii) = ComplexType(0);
+
+				// the first pass solves for x itself, from zero, and the rest for corrections to it
+				RealType norm_previous_correction(0);
+				for (unsigned ii = 0; ii <= max_refinement_iterations_; ++ii)
+				{
+					if (ii > 0)
+					{
+						residual_ = b - J*x;
+						++num_refinement_steps_;
+					}
+					SolveLow(correction_, residual_);
+					x += correction_;
+
+					const RealType norm_correction = correction_.norm();
+					// the residuals are accurate to about epsilon, so the corrections settle at about the condition number times it
+					if (norm_correction <= RealType(10*condition_number_)*epsilon*x.norm())
+						return true;
+
+					// the first correction is about the error of the first solve, so contraction is judged from the second on
+					if (ii > 1 && !(norm_correction < norm_previous_correction/RealType(2)))
+						break;
+					norm_previous_correction = norm_correction;
+				}
+
+				// refinement stalled, or ran out of steps.  the matrix is too poorly conditioned for the low precision, after all
+				++num_stalls_;
+				if (!FactorFully(J))
+					return false;
+				x = LU_.solve(b);
+				return true;
+			}
+
+			/**
+			\brief The precision of the factorization in use.
+			*/
+			amp::PrecisionTier Tier() const
+			{
+				return tier_;
+			}
+
+			/**
+			\brief The estimate of the 1-norm of the inverse of the matrix, from the factorization in full precision if there is one, and otherwise from that in double made in choosing the tier.  For the criteria of adaptive precision.
+			*/
+			RealType const& NormJInverse() const
+			{
+				return norm_J_inverse_;
+			}
+
+			/**
+			\brief The number of factorizations in a precision, since construction.
+			*/
+			unsigned long long NumFactorizations(amp::PrecisionTier tier) const
+			{
+				return num_factorizations_[static_cast<int>(tier)];
+			}
+
+			/**
+			\brief The number of steps of refinement, each a residual in full precision and a solve in low, since construction.
+			*/
+			unsigned long long NumRefinementSteps() const
+			{
+				return num_refinement_steps_;
+			}
+
+			/**
+			\brief The number of solves in which refinement stalled, and the matrix was factored in full precision, since construction.
+			*/
+			unsigned long long NumStalls() const
+			{
+				return num_stalls_;
+			}
+
+		private:
+
+			bool FactorFully(Mat<ComplexType> const& J)
+			{
+				LU_ = J.lu();
+				tier_ = amp::PrecisionTier::Multiple;
+				++num_factorizations_[static_cast<int>(tier_)];
+				if (LUPartialPivotDecompositionSuccessful(LU_.matrixLU())!=MatrixSuccessCode::Success)
+					return false;
+				norm_J_inverse_ = EstimateInverseNorm(LU_, residual_, correction_);
+				return true;
+			}
+
+			/**
+			\brief Solve with the factorization in low precision, rounding the right hand side down to it, and the solution up.
+			*/
+			void SolveLow(Vec<ComplexType> & x, Vec<ComplexType> const& b)
+			{
+				const auto n = b.size();
+				x.resize(n);
+				if (tier_==amp::PrecisionTier::Double)
+				{
+					b_d_.resize(n);
+					for (Eigen::Index ii = 0; ii < n; ++ii)
+						b_d_(ii) = ToDouble(b(ii));
+					x_d_ = LU_d_.solve(b_d_);
+					for (Eigen::Index ii = 0; ii < n; ++ii)
+						x(ii) = ComplexType(x_d_(ii));
+				}
+				else
+				{
+					b_dd_.resize(n);
+					for (Eigen::Index ii = 0; ii < n; ++ii)
+						b_dd_(ii) = ToDoubleDouble(b(ii));
+					x_dd_ = LU_dd_.solve(b_dd_);
+					for (Eigen::Index ii = 0; ii < n; ++ii)
+						FromDoubleDouble(x_dd_(ii), x(ii));
+				}
+			}
+
+			static dbl ToDouble(dbl const& z)
+			{
+				return z;
+			}
+
+			static dbl ToDouble(mpfr const& z)
+			{
+				return dbl(static_cast<double>(z.real()), static_cast<double>(z.imag()));
+			}
+
+			unsigned max_refinement_iterations_;
+
+			amp::PrecisionTier tier_ = amp::PrecisionTier::Multiple;
+			RealType norm_J_inverse_ = RealType(0);
+			double condition_number_ = 1; // the estimate from the factorization in double
+
+			Mat<dbl> J_d_;
+			Eigen::PartialPivLU<Mat<dbl> > LU_d_;
+			Vec<dbl> b_d_, x_d_, y_d_;
+
+			Mat<dd_complex> J_dd_;
+			Eigen::PartialPivLU<Mat<dd_complex> > LU_dd_;
+			Vec<dd_complex> b_dd_, x_dd_;
+
+			Eigen::PartialPivLU<Mat<ComplexType> > LU_;
+			Vec<ComplexType> residual_, correction_;
+
+			std::array<unsigned long long, 3> num_factorizations_ = {{0, 0, 0}};
+			unsigned long long num_refinement_steps_ = 0;
+			unsigned long long num_stalls_ = 0;
+		};
+
+	} // re: namespace tracking
+} // re: namespace bertini
+
+#endif
@@ -11,6 +11,8 @@
 
 #include "bertini2/tracking/amp_criteria.hpp"
 #include "bertini2/tracking/tracking_config.hpp"
+#include "bertini2/tracking/sparse_jacobian_lu.hpp"
+#include "bertini2/tracking/mixed_precision_lu.hpp"
 #include "bertini2/system.hpp"
 
 
@@ -38,6 +40,19 @@ namespace bertini{
 			 \endcode
 			 
 			 
+			 ## Reusing the factorization
+
+			 With config::Newton::reuse_factorization set, iterations after the first solve with the LU factorization of the Jacobian from an earlier iteration, evaluating only the functions.  This is the chord, or simplified, Newton method.  It converges only linearly, but each of its iterations costs one evaluation of the functions and a pair of triangular solves, rather than an evaluation of the Jacobian and an \f$O(n^3)\f$ factorization.  Once the norm of a step exceeds config::Newton::max_chord_contraction times that of the step before, the Jacobian is evaluated and factored anew.  NumFactorizationsSkipped counts the factorizations saved.
+			 
+			 
+			 ## Sparse systems
+
+			 For systems for which System::UseSparseLinearAlgebra holds, large with few variables per function, only the structurally nonzero entries of the Jacobian are evaluated, and it is factored by a sparse LU.  See SparseJacobianLU.
+
+
+			 ## Mixed-precision linear solves
+
+			 With config::AdaptiveMultiplePrecisionConfig::mixed_precision_linear_solves set, the dense Jacobians of the adaptive precision Correct in multiple precision are factored in double or double-double, and the steps refined in the full precision, by MixedPrecisionLU.  The estimate of the norm of the inverse Jacobian for the AMP criteria then comes from it.
 			 
 			 */
 
@@ -68,6 +83,24 @@ namespace bertini{
 				{
 					newton_config_ = newton_settings;
 				}
+
+
+				/**
+				 \brief The number of iterations which reused the factorization of an earlier one, rather than factoring the Jacobian, since construction or the last ResetNumFactorizationsSkipped.
+				 */
+				unsigned long long NumFactorizationsSkipped() const
+				{
+					return num_factorizations_skipped_;
+				}
+
+
+				/**
+				 \brief Set the count of skipped factorizations back to zero.
+				 */
+				void ResetNumFactorizationsSkipped()
+				{
+					num_factorizations_skipped_ = 0;
+				}
 				
 				
 	
@@ -84,8 +117,12 @@ namespace bertini{
 					Precision(std::get< Vec<mpfr> >(f_temp_), new_precision);
 					Precision(std::get< Vec<mpfr> >(step_temp_), new_precision);
 					Precision(std::get< Mat<mpfr> >(J_temp_), new_precision);
+					Precision(std::get< Vec<mpfr> >(norm_estimate_x_), new_precision);
+					Precision(std::get< Vec<mpfr> >(norm_estimate_y_), new_precision);
+					std::get<mpfr_float>(norm_J_inverse_).precision(new_precision);
 
 					std::get< Eigen::PartialPivLU<Mat<mpfr>> >(LU_) = Eigen::PartialPivLU<Mat<mpfr>>(numTotalFunctions_);
+					std::get< MixedPrecisionLU<mpfr> >(mixed_LU_).ChangePrecision(new_precision);
 
 					current_precision_ = new_precision;				
 				}
@@ -112,6 +149,10 @@ namespace bertini{
 					std::get< Vec<mpfr> >(f_temp_).resize(numTotalFunctions_);
 					std::get< Vec<dbl> >(step_temp_).resize(numTotalFunctions_);
 					std::get< Vec<mpfr> >(step_temp_).resize(numTotalFunctions_);
+					std::get< Vec<dbl> >(norm_estimate_x_).resize(numVariables_);
+					std::get< Vec<mpfr> >(norm_estimate_x_).resize(numVariables_);
+					std::get< Vec<dbl> >(norm_estimate_y_).resize(numVariables_);
+					std::get< Vec<mpfr> >(norm_estimate_y_).resize(numVariables_);
 				}
 
 				
@@ -157,14 +198,18 @@ namespace bertini{
 					Vec<ComplexType>& step_ref = std::get< Vec<ComplexType> >(step_temp_);
 					
 					next_space = current_space;
+					bool refactor = true;
+					RealType norm_previous_step(0);
 					for (unsigned ii = 0; ii < max_num_newton_iterations; ++ii)
 					{
 						//Update the newton iterate by one iteration
-						auto success_code = EvalIterationStep(step_ref, S, next_space, current_time);
+						auto success_code = EvalIterationStep(step_ref, S, next_space, current_time, refactor);
 						if(success_code != SuccessCode::Success)
 							return success_code;
 						
 						next_space += step_ref;
+						refactor = ShouldRefactor(step_ref.norm(), norm_previous_step, ii);
+						norm_previous_step = step_ref.norm();
 						
 						if ( (step_ref.norm() < tracking_tolerance) && (ii >= (min_num_newton_iterations-1)) )
 							return SuccessCode::Success;
@@ -214,25 +259,28 @@ namespace bertini{
 					#endif
 					
 					Vec<ComplexType>& step_ref = std::get< Vec<ComplexType> >(step_temp_);
+					UseMixedPrecisionSolves(AMP_config);
 					
 					next_space = current_space;
+					bool refactor = true;
+					RealType norm_previous_step(0);
 					for (unsigned ii = 0; ii < max_num_newton_iterations; ++ii)
 					{
+						const bool fresh_factorization = refactor;
 						//Update the newton iterate by one iteration
-						auto success_code = EvalIterationStep(step_ref, S, next_space, current_time);
+						auto success_code = EvalIterationStep(step_ref, S, next_space, current_time, refactor);
 						if(success_code != SuccessCode::Success)
 							return success_code;
 						
 						next_space += step_ref;
-						
-						Mat<ComplexType>& J_temp_ref = std::get< Mat<ComplexType> >(J_temp_);
-						Eigen::PartialPivLU< Mat<ComplexType> >& LU_ref = std::get< Eigen::PartialPivLU< Mat<ComplexType> > >(LU_);
+						refactor = ShouldRefactor(step_ref.norm(), norm_previous_step, ii);
+						norm_previous_step = step_ref.norm();
 						
 						if ( (step_ref.norm() < tracking_tolerance) && (ii >= (min_num_newton_iterations-1)) )
 							return SuccessCode::Success;
 						
-						auto norm_J_inverse = LU_ref.solve(RandomOfUnits<ComplexType>(S.NumVariables())).norm();
-						if (!amp::CriterionB(J_temp_ref.norm(), norm_J_inverse, max_num_newton_iterations - ii, tracking_tolerance, step_ref.norm(), AMP_config))
+						const RealType& norm_J_inverse = NormJInverse<ComplexType>(fresh_factorization);
+						if (!amp::CriterionB(NormJ<ComplexType>(), norm_J_inverse, max_num_newton_iterations - ii, tracking_tolerance, step_ref.norm(), AMP_config))
 							return SuccessCode::HigherPrecisionNecessary;
 						
 						if (!amp::CriterionC(norm_J_inverse, next_space, tracking_tolerance, AMP_config))
@@ -288,24 +336,26 @@ namespace bertini{
 					#endif
 					
 					Vec<ComplexType>& step_ref = std::get< Vec<ComplexType> >(step_temp_);
+					UseMixedPrecisionSolves(AMP_config);
 					
 					next_space = current_space;
+					bool refactor = true;
+					RealType norm_previous_step(0);
 					for (unsigned ii = 0; ii < max_num_newton_iterations; ++ii)
 					{
+						const bool fresh_factorization = refactor;
 						//Update the newton iterate by one iteration
-						auto success_code = EvalIterationStep(step_ref, S, next_space, current_time);
+						auto success_code = EvalIterationStep(step_ref, S, next_space, current_time, refactor);
 						if(success_code != SuccessCode::Success)
 							return success_code;
 						
 						next_space += step_ref;
-						
-						Mat<ComplexType>& J_temp_ref = std::get< Mat<ComplexType> >(J_temp_);
-						Eigen::PartialPivLU< Mat<ComplexType> >& LU_ref = std::get< Eigen::PartialPivLU< Mat<ComplexType> > >(LU_);
-						
+						refactor = ShouldRefactor(step_ref.norm(), norm_previous_step, ii);
+						norm_previous_step = step_ref.norm();
 						
 						norm_delta_z = step_ref.norm();
-						norm_J = J_temp_ref.norm();
-						norm_J_inverse = LU_ref.solve(RandomOfUnits<ComplexType>(S.NumVariables())).norm();
+						norm_J = NormJ<ComplexType>();
+						norm_J_inverse = NormJInverse<ComplexType>(fresh_factorization);
 						condition_number_estimate = norm_J*norm_J_inverse;
 						
 						
@@ -333,6 +383,76 @@ namespace bertini{
 				////////////////////
 				
 				
+				/**
+				 \brief Get the estimate of the norm of the inverse of the Jacobian, for the AMP criteria.
+
+				 The estimate is made, by EstimateInverseNorm, only when the Jacobian has just been factored.  Otherwise, the estimate for the factorization in use stands.  With mixed-precision solves, the estimate is MixedPrecisionLU's, which costs nothing more.
+
+				 \param fresh_factorization Whether the factorization in use was made in this iteration.
+				 */
+				template<typename ComplexType>
+				typename Eigen::NumTraits<ComplexType>::Real const& NormJInverse(bool fresh_factorization)
+				{
+					using RealType = typename Eigen::NumTraits<ComplexType>::Real;
+					RealType& estimate = std::get<RealType>(norm_J_inverse_);
+					if (use_mixed_)
+						estimate = std::get< MixedPrecisionLU<ComplexType> >(mixed_LU_).NormJInverse();
+					else if (fresh_factorization)
+					{
+						auto& x = std::get< Vec<ComplexType> >(norm_estimate_x_);
+						auto& y = std::get< Vec<ComplexType> >(norm_estimate_y_);
+						if (use_sparse_)
+							estimate = std::get< SparseJacobianLU<ComplexType> >(sparse_LU_).EstimateInverseNorm(x, y);
+						else
+							estimate = EstimateInverseNorm(std::get< Eigen::PartialPivLU< Mat<ComplexType> > >(LU_), x, y);
+					}
+					return estimate;
+				}
+
+
+				/**
+				 \brief Set, from the AMP settings, whether to use mixed-precision linear solves.
+				 */
+				void UseMixedPrecisionSolves(config::AdaptiveMultiplePrecisionConfig const& AMP_config)
+				{
+					mixed_precision_solves_ = AMP_config.mixed_precision_linear_solves;
+					std::get< MixedPrecisionLU<dbl> >(mixed_LU_).SetMaxRefinementIterations(AMP_config.max_refinement_iterations);
+					std::get< MixedPrecisionLU<mpfr> >(mixed_LU_).SetMaxRefinementIterations(AMP_config.max_refinement_iterations);
+				}
+
+
+				/**
+				 \brief Get the norm of the Jacobian last factored, dense or sparse, for the AMP criteria.
+				 */
+				template<typename ComplexType>
+				typename Eigen::NumTraits<ComplexType>::Real NormJ() const
+				{
+					if (use_sparse_)
+						return std::get< SparseJacobianLU<ComplexType> >(sparse_LU_).Norm();
+					return std::get< Mat<ComplexType> >(J_temp_).norm();
+				}
+
+
+				/**
+				 \brief Decide whether the next iteration should evaluate and factor the Jacobian anew.
+
+				 Without reuse_factorization, always.  Otherwise, not after the first iteration, whose factorization is fresh, and after that only once the steps stop contracting fast enough.
+
+				 \param norm_step The norm of the step just taken.
+				 \param norm_previous_step The norm of the step before it.
+				 \param iteration The index of the step just taken.
+				 */
+				template<typename RealType>
+				bool ShouldRefactor(RealType const& norm_step, RealType const& norm_previous_step, unsigned iteration) const
+				{
+					if (!newton_config_.reuse_factorization)
+						return true;
+					if (iteration==0)
+						return false;
+					return norm_step > RealType(newton_config_.max_chord_contraction)*norm_previous_step;
+				}
+
+
 				/**
 				 \brief This function computes the newton step for a system given information about the previous iteration
 				 
@@ -340,13 +460,15 @@ namespace bertini{
 				 \param S The system used in the computations
 				 \param current_space The space from the previous Newton iteration
 				 \param current_time The time from the previous Newton iteration
+				 \param refactor Whether to evaluate and factor the Jacobian.  If false, the factorization from an earlier call is used, and only the functions are evaluated.
 				 
 				 */
 				
 				template<typename ComplexType, typename Derived>
 				SuccessCode EvalIterationStep(Vec<ComplexType> & newton_step,
 											  const System& S,
-											  const Eigen::MatrixBase<Derived>& current_space, const ComplexType& current_time)
+											  const Eigen::MatrixBase<Derived>& current_space, const ComplexType& current_time,
+											  bool refactor = true)
 				{
 					Vec<ComplexType>& f_temp_ref = std::get< Vec<ComplexType> >(f_temp_);
 					Mat<ComplexType>& J_temp_ref = std::get< Mat<ComplexType> >(J_temp_);
@@ -354,13 +476,46 @@ namespace bertini{
 					Eigen::PartialPivLU< Mat<ComplexType> >& LU_ref = std::get< Eigen::PartialPivLU< Mat<ComplexType> > >(LU_);
 					
 					S.EvalInPlace(f_temp_ref, current_space, current_time);
-					S.JacobianInPlace(J_temp_ref, current_space, current_time);
-					LU_ref = J_temp_ref.lu();
-					
-					if (LUPartialPivotDecompositionSuccessful(LU_ref.matrixLU())!=MatrixSuccessCode::Success)
-						return SuccessCode::MatrixSolveFailure;
+					if (refactor)
+					{
+						use_sparse_ = S.UseSparseLinearAlgebra();
+						use_mixed_ = mixed_precision_solves_ && !use_sparse_ && std::is_same<ComplexType, mpfr>::value;
+						if (use_sparse_)
+						{
+							if (!std::get< SparseJacobianLU<ComplexType> >(sparse_LU_).Factor(S, current_space, current_time))
+								return SuccessCode::MatrixSolveFailure;
+						}
+						else if (use_mixed_)
+						{
+							S.JacobianInPlace(J_temp_ref, current_space, current_time);
+							if (!std::get< MixedPrecisionLU<ComplexType> >(mixed_LU_).Factor(J_temp_ref))
+								return SuccessCode::MatrixSolveFailure;
+						}
+						else
+						{
+							S.JacobianInPlace(J_temp_ref, current_space, current_time);
+							LU_ref = J_temp_ref.lu();
+							
+							if (LUPartialPivotDecompositionSuccessful(LU_ref.matrixLU())!=MatrixSuccessCode::Success)
+								return SuccessCode::MatrixSolveFailure;
+						}
+					}
+					else
+						++num_factorizations_skipped_;
 					
-					newton_step = LU_ref.solve(-f_temp_ref);
+					if (use_sparse_)
+					{
+						std::get< SparseJacobianLU<ComplexType> >(sparse_LU_).Solve(newton_step, -f_temp_ref);
+						if (!newton_step.allFinite())
+							return SuccessCode::MatrixSolveFailure;
+					}
+					else if (use_mixed_)
+					{
+						if (!std::get< MixedPrecisionLU<ComplexType> >(mixed_LU_).Solve(newton_step, J_temp_ref, -f_temp_ref))
+							return SuccessCode::MatrixSolveFailure;
+					}
+					else
+						newton_step = LU_ref.solve(-f_temp_ref);
 					
 					return SuccessCode::Success;
 					
@@ -382,11 +537,21 @@ namespace bertini{
 				std::tuple< Mat<dbl>, Mat<mpfr> > J_temp_; // Variable to hold temporary evaluation of the Jacobian
 				
 				std::tuple< Eigen::PartialPivLU<Mat<dbl>>, Eigen::PartialPivLU<Mat<mpfr>> > LU_; // The LU factorization from the Newton iterates
+				std::tuple< SparseJacobianLU<dbl>, SparseJacobianLU<mpfr> > sparse_LU_; // The sparse Jacobian and its factorization, for systems with System::UseSparseLinearAlgebra
+				bool use_sparse_ = false; // Whether the factorization in use is sparse_LU_ rather than LU_
+				std::tuple< MixedPrecisionLU<dbl>, MixedPrecisionLU<mpfr> > mixed_LU_; // The factorization in low precision, for mixed-precision linear solves
+				bool mixed_precision_solves_ = false; // Whether the AMP settings of the current Correct ask for mixed-precision linear solves
+				bool use_mixed_ = false; // Whether the factorization in use is mixed_LU_ rather than LU_
+				std::tuple< double, mpfr_float > norm_J_inverse_; // The estimate of the norm of the inverse of the Jacobian, for the factorization in LU_
+				std::tuple< Vec<dbl>, Vec<mpfr> > norm_estimate_x_; // Work vectors for estimating the norm of the inverse of the Jacobian
+				std::tuple< Vec<dbl>, Vec<mpfr> > norm_estimate_y_;
 				
 				unsigned current_precision_;
 
 				config::Newton newton_config_; // Hold the settings of the Newton iteration
 
+				unsigned long long num_factorizations_skipped_ = 0; // The number of iterations which reused an earlier factorization
+
 				
 			}; //re: class NewtonCorrector
 			
@@ -0,0 +1,340 @@
+//This file is part of Bertini 2.
+//
+//parameter_homotopy.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//parameter_homotopy.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with parameter_homotopy.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+
+/**
+\file parameter_homotopy.hpp
+
+\brief Provides ParameterHomotopy, which solves a parametrized family of systems at a generic point of its parameters once, and then at many other points from those solutions.
+*/
+
+#ifndef BERTINI_TRACKING_PARAMETER_HOMOTOPY_HPP
+#define BERTINI_TRACKING_PARAMETER_HOMOTOPY_HPP
+
+#include "bertini2/start_system.hpp"
+#include "bertini2/tracking/solve.hpp"
+
+namespace bertini{
+	namespace tracking{
+
+		/**
+		\brief The finite solutions of a parametrized family at a generic point of its parameters, the start points of parameter homotopies to other points.
+
+		The solutions are dehomogenized, so that they do not depend on the random patch of the family they were computed with, and may be used with another instance of the same family, made in another process.  Saved and read with ParameterHomotopy::SaveGeneric and ParameterHomotopy::LoadGeneric.
+		*/
+		struct GenericSolutions
+		{
+			Vec<dbl> parameter_values; ///< The generic point, a random complex value for each explicit parameter.
+			std::vector<Vec<dbl> > solutions; ///< The distinct finite solutions there, dehomogenized.
+
+			template <typename Archive>
+			void serialize(Archive& ar, const unsigned version)
+			{
+				ar & parameter_values;
+				ar & solutions;
+			}
+		};
+
+
+		/**
+		\brief Solves a family of polynomial systems, parametrized by the explicit parameters of a System, at many points of the parameters.
+
+		The family is solved once, at a random complex point \f$p_0\f$ of the parameters, from a start system with as many start points as its Bezout number.  Its finite solutions there (GenericSolutions) number the same as the isolated solutions at almost any point, so that at each point \f$q\f$ asked for after, only those are tracked, along the parameter homotopy \f$f(x; t p_0 + (1-t) q)\f$ from \f$t=1\f$ to \f$t=0\f$.  The path from \f$p_0\f$ being through complex parameter space, it avoids the discriminant for almost every \f$p_0\f$, as the gamma trick does.
+
+		The explicit parameters of the family are given new entries, \f$t p_0 + (1-t) q\f$, in a copy of it, with \f$q\f$ its implicit parameters.  Moving to a new point sets the values of the implicit parameters, rather than making a new homotopy.  The points are distributed among threads, each with its own clone of the homotopy, and tracking all the paths for a point before taking the next.  For trackers whose numbers are mpfr, one thread is used, as for Solve.
+
+		\code{.cpp}
+		auto p = std::make_shared<node::Function>("p");
+		p->SetRoot(std::make_shared<node::Integer>(0)); // replaced by the homotopy
+		family.AddParameter(p);
+		// ... add variables, and functions involving p ...
+		family.Homogenize();
+		family.AutoPatch();
+
+		config::ParameterHomotopy<double> settings;
+		ParameterHomotopy<DoublePrecisionTracker> ph(family, settings);
+		ph.SolveGeneric();
+		ph.SaveGeneric("generic_solutions");
+
+		// later, perhaps in another process, with another instance of the family
+		ph.LoadGeneric("generic_solutions");
+		auto results = ph.Solve(parameter_points);
+		\endcode
+
+		\tparam TrackerType The type of tracker to use.
+		\tparam EndgameType The type of endgame to run at the end of each path.
+		*/
+		template<typename TrackerType, typename EndgameType = typename EndgameSelector<TrackerType>::Cauchy>
+		class ParameterHomotopy
+		{
+		public:
+			using BaseComplexType = typename TrackerTraits<TrackerType>::BaseComplexType;
+			using BaseRealType = typename TrackerTraits<TrackerType>::BaseRealType;
+
+			/**
+			\param family The family of systems.  Homogenized and patched, as for Solve, with its parameters as explicit parameters, which must have entries, such as 0, to be replaced.  Must not have a path variable.  Must outlive the ParameterHomotopy.
+			\param settings The settings for tracking, threads, and the generic solutions kept.
+
+			\throws std::runtime_error if the family has no explicit parameters, or has a path variable.
+			*/
+			ParameterHomotopy(System const& family, config::ParameterHomotopy<BaseRealType> const& settings) : family_(family), settings_(settings)
+			{
+				if (family.NumParameters()==0)
+					throw std::runtime_error("parameter homotopy for a system with no explicit parameters");
+				if (family.HavePathVariable())
+					throw std::runtime_error("parameter homotopy for a system with a path variable already");
+			}
+
+
+			/**
+			\brief Solve the family at a new random complex point of the parameters, keeping its distinct finite solutions, those of paths whose endgames succeeded with cycle number 1.
+
+			\tparam StartSystemType The type of start system, made from the family at the generic point.
+			\return The number of generic solutions kept.
+			*/
+			template<typename StartSystemType = start_system::TotalDegree>
+			unsigned long long SolveGeneric()
+			{
+				GenericSolutions generic;
+				generic.parameter_values.resize(family_.NumParameters());
+				for (unsigned ii = 0; ii < family_.NumParameters(); ++ii)
+					generic.parameter_values(ii) = node::Rational::Rand().Eval<dbl>();
+
+				auto at_generic_point = family_.Clone();
+				for (unsigned ii = 0; ii < family_.NumParameters(); ++ii)
+					at_generic_point.Parameter(ii)->SetRoot(std::make_shared<node::Float>(mpfr(generic.parameter_values(ii))));
+
+				StartSystemType start_system(at_generic_point);
+				auto results = tracking::Solve<TrackerType, EndgameType>(at_generic_point, start_system, settings_.solver);
+
+				for (auto const& r : results)
+				{
+					if (r.tracking_success!=SuccessCode::Success || r.endgame_success!=SuccessCode::Success || r.cycle_number!=1)
+						continue;
+
+					Vec<dbl> solution(r.solution.size());
+					for (unsigned kk = 0; kk < r.solution.size(); ++kk)
+						solution(kk) = static_cast<dbl>(r.solution(kk));
+					if (!(solution.norm() < static_cast<double>(settings_.finite_threshold)))
+						continue;
+
+					if (std::none_of(generic.solutions.begin(), generic.solutions.end(),
+					                 [&](Vec<dbl> const& s){ return (s - solution).norm() < static_cast<double>(settings_.same_point_tolerance); }))
+						generic.solutions.push_back(solution);
+				}
+
+				generic_ = generic;
+				return generic_.solutions.size();
+			}
+
+
+			/**
+			\brief The generic point and the solutions there, found by SolveGeneric or read by LoadGeneric.
+			*/
+			GenericSolutions const& Generic() const
+			{
+				return generic_;
+			}
+
+
+			/**
+			\brief Write the generic point and the solutions there to a file, replacing it at once.  See WriteFileAtomically.
+			*/
+			void SaveGeneric(std::string const& filename) const
+			{
+				WriteFileAtomically(filename, Pack(generic_));
+			}
+
+
+			/**
+			\brief Read a generic point and the solutions there from a file written by SaveGeneric, for this family.
+
+			\throws std::runtime_error if the file cannot be read, or has a different number of parameters or variables than the family.
+			*/
+			void LoadGeneric(std::string const& filename)
+			{
+				GenericSolutions generic;
+				Unpack(ReadFile(filename), generic);
+
+				if (generic.parameter_values.size()!=family_.NumParameters())
+					throw std::runtime_error("generic solutions read for parameter homotopy are for a different number of parameters");
+				for (auto const& s : generic.solutions)
+					if (s.size()!=family_.NumNaturalVariables())
+						throw std::runtime_error("generic solutions read for parameter homotopy are for a different number of variables");
+
+				generic_ = generic;
+			}
+
+
+			/**
+			\brief Solve the family at each of a collection of points of the parameters, by tracking the generic solutions to it.
+
+			\param parameter_points The points, each with a value for each explicit parameter.
+			\return For each point, the outcome of the path from each generic solution, in the order of the generic solutions, the start_index of each being that of its generic solution.
+
+			\throws std::runtime_error if there are no generic solutions, or a point has the wrong number of values.  Whatever the tracker or endgame throws, in any thread, after all threads have finished.
+			*/
+			std::vector<std::vector<SolveResult<BaseComplexType> > > Solve(std::vector<Vec<dbl> > const& parameter_points) const
+			{
+				if (generic_.solutions.empty())
+					throw std::runtime_error("parameter homotopy has no generic solutions to track.  call SolveGeneric or LoadGeneric first");
+				for (auto const& q : parameter_points)
+					if (q.size()!=family_.NumParameters())
+						throw std::runtime_error("parameter point for parameter homotopy has the wrong number of values");
+
+				const bool is_multiple_precision = std::is_same<BaseComplexType, mpfr>::value;
+
+				auto homotopy = MakeHomotopy();
+
+				unsigned num_threads = settings_.solver.num_threads ? settings_.solver.num_threads : std::max(std::thread::hardware_concurrency(), 1u);
+				if (is_multiple_precision)
+					num_threads = 1;
+				num_threads = static_cast<unsigned>(std::max<size_t>(std::min<size_t>(num_threads, parameter_points.size()), 1));
+
+				// clone in this thread, before any of the workers start evaluating
+				std::vector<System> homotopies;
+				for (unsigned ii = 0; ii < num_threads; ++ii)
+					homotopies.push_back(homotopy.Clone());
+
+				// the start points are the same for every parameter point
+				std::vector<Vec<BaseComplexType> > start_points;
+				for (auto const& s : generic_.solutions)
+					start_points.push_back(ToHomotopyCoordinates(homotopy, s));
+
+				std::vector<std::vector<SolveResult<BaseComplexType> > > results(parameter_points.size());
+
+				detail::WorkStealingQueues queues(parameter_points.size(), num_threads);
+				std::mutex exception_mutex;
+				std::exception_ptr first_exception;
+
+				auto work = [&](unsigned id)
+				{
+					try{
+						// the precision configuration of an AMPTracker is computed from the homotopy, so needs values for its implicit parameters
+						SetTarget(homotopies[id], generic_.parameter_values);
+						PathSolver<TrackerType, EndgameType> solver(homotopies[id], settings_.solver);
+
+						unsigned long long point;
+						while (queues.Next(id, point))
+						{
+							SetTarget(homotopies[id], parameter_points[point]);
+							for (unsigned long long ii = 0; ii < start_points.size(); ++ii)
+							{
+								solver.ResetPrecision();
+								results[point].push_back(solver.Run(ii, start_points[ii]));
+							}
+						}
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> lock(exception_mutex);
+						if (!first_exception)
+							first_exception = std::current_exception();
+					}
+				};
+
+				std::vector<std::thread> threads;
+				for (unsigned ii = 1; ii < num_threads; ++ii)
+					threads.emplace_back(work, ii);
+				work(0);
+				for (auto& th : threads)
+					th.join();
+
+				if (first_exception)
+					std::rethrow_exception(first_exception);
+
+				return results;
+			}
+
+		private:
+
+			/**
+			\brief Make the parameter homotopy, from a clone of the family, with the entry of explicit parameter k replaced by \f$t p_{0,k} + (1-t) q_k\f$, the \f$q_k\f$ being its implicit parameters.
+			*/
+			System MakeHomotopy() const
+			{
+				auto homotopy = family_.Clone();
+
+				auto t = std::make_shared<node::Variable>("t");
+				VariableGroup q;
+				for (unsigned ii = 0; ii < family_.NumParameters(); ++ii)
+				{
+					q.push_back(std::make_shared<node::Variable>("parameter_target_" + std::to_string(ii)));
+					std::shared_ptr<node::Node> p0 = std::make_shared<node::Float>(mpfr(generic_.parameter_values(ii)));
+					homotopy.Parameter(ii)->SetRoot(t*p0 + (1-t)*q.back());
+				}
+
+				homotopy.AddImplicitParameters(q);
+				homotopy.AddPathVariable(t);
+				return homotopy;
+			}
+
+
+			/**
+			\brief Set the point of the parameters a homotopy goes to, in both number types, so that it is there whatever the precision of evaluation.
+			*/
+			static void SetTarget(System const& homotopy, Vec<dbl> const& q)
+			{
+				homotopy.SetImplicitParameters(q);
+
+				Vec<mpfr> q_mp(q.size());
+				for (unsigned ii = 0; ii < q.size(); ++ii)
+					q_mp(ii) = mpfr(q(ii));
+				homotopy.SetImplicitParameters(q_mp);
+			}
+
+
+			/**
+			\brief Put a dehomogenized generic solution into the coordinates of the homotopy, homogenized and patched as the family is.
+			*/
+			static Vec<BaseComplexType> ToHomotopyCoordinates(System const& homotopy, Vec<dbl> const& affine)
+			{
+				const bool is_homogenized = homotopy.NumHomVariables() > 0;
+
+				Vec<BaseComplexType> x(homotopy.NumVariables());
+				unsigned offset = 0, affine_offset = 0;
+				for (unsigned jj = 0; jj < homotopy.NumVariableGroups(); ++jj)
+				{
+					const auto n = homotopy.AffineVariableGroup(jj).size();
+					if (is_homogenized)
+						x(offset++) = BaseComplexType(1);
+					for (unsigned kk = 0; kk < n; ++kk)
+						x(offset++) = BaseComplexType(affine(affine_offset++));
+				}
+
+				if (homotopy.IsPatched())
+					homotopy.RescalePointToFitPatchInPlace(x);
+				return x;
+			}
+
+
+			System const& family_;
+			config::ParameterHomotopy<BaseRealType> settings_;
+			GenericSolutions generic_;
+		};
+
+	} // re: namespace tracking
+} // re: namespace bertini
+
+#endif
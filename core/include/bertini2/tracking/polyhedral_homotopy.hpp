@@ -0,0 +1,151 @@
+//This file is part of Bertini 2.
+//
+//polyhedral_homotopy.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//polyhedral_homotopy.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with polyhedral_homotopy.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+
+/**
+\file polyhedral_homotopy.hpp
+
+\brief Provides TrackPolyhedralHomotopies, which finds the start points of a polyhedral start system.
+*/
+
+#ifndef BERTINI_TRACKING_POLYHEDRAL_HOMOTOPY_HPP
+#define BERTINI_TRACKING_POLYHEDRAL_HOMOTOPY_HPP
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "bertini2/start_system.hpp"
+#include "bertini2/tracking/tracker.hpp"
+#include "bertini2/detail/work_stealing.hpp"
+
+namespace bertini{
+	namespace tracking{
+
+		/**
+		\brief Solve a polyhedral start system, by tracking the homotopy of each of its mixed cells from the solutions of the cell's binomial system, and record the solutions in it.
+
+		The homotopy of a cell (see start_system::Polyhedral::CellHomotopy) involves fractional powers of t, so cannot be evaluated at \f$t=0\f$, where the binomial solutions are exact.  The exponents other than 0 being at least 1, the binomial solutions are within about start_time of the path at start_time, and are refined there by Newton's method before tracking to \f$t=1\f$.  No endgame is needed, the start system being generic.
+
+		The cells are distributed among settings.num_threads threads, each tracking all the paths of a cell with a tracker of its own.  For trackers whose numbers are mpfr, one thread is used, as for Solve.
+
+		\param start_system The polyhedral start system, whose mixed cells have been found.  Its start points are set to the ends of the paths which succeeded, in the order of the cells.
+		\param settings The settings for the tracker, and the number of threads.
+		\param start_time The time from which to track.
+		\return The number of paths which failed.  The start system has that many fewer start points than its mixed volume.
+
+		\tparam TrackerType The type of tracker to use, such as DoublePrecisionTracker.
+		*/
+		template<typename TrackerType>
+		unsigned long long TrackPolyhedralHomotopies(start_system::Polyhedral & start_system, config::Solver<typename TrackerTraits<TrackerType>::BaseRealType> const& settings, double start_time = 1e-8)
+		{
+			using BCT = typename TrackerTraits<TrackerType>::BaseComplexType;
+			using PrecisionConfig = typename TrackerTraits<TrackerType>::PrecisionConfig;
+
+			const auto num_cells = start_system.MixedCells().size();
+
+			// made in this thread, before any of the workers start, as making them evaluates the nodes of the start system, which are shared
+			std::vector<System> homotopies;
+			std::vector<std::vector<Vec<dbl> > > binomial_solutions;
+			for (size_t ii = 0; ii < num_cells; ++ii)
+			{
+				homotopies.push_back(start_system.CellHomotopy(ii));
+				binomial_solutions.push_back(start_system.BinomialSolutions(ii));
+			}
+
+			unsigned num_threads = settings.num_threads ? settings.num_threads : std::max(std::thread::hardware_concurrency(), 1u);
+			if (std::is_same<BCT, mpfr>::value)
+				num_threads = 1;
+			num_threads = static_cast<unsigned>(std::max<size_t>(std::min<size_t>(num_threads, num_cells), 1));
+
+			std::vector<std::vector<Vec<dbl> > > solutions(num_cells);
+			std::vector<unsigned long long> num_failures(num_cells, 0);
+
+			detail::WorkStealingQueues queues(num_cells, num_threads);
+			std::mutex exception_mutex;
+			std::exception_ptr first_exception;
+
+			auto work = [&](unsigned id)
+			{
+				try{
+					unsigned long long cell;
+					while (queues.Next(id, cell))
+					{
+						TrackerType tracker(homotopies[cell]);
+						tracker.Setup(settings.predictor,
+						              settings.tolerances.newton_before_endgame, settings.tolerances.path_truncation_threshold,
+						              settings.stepping, settings.newton);
+						tracker.PrecisionSetup(PrecisionConfig(homotopies[cell]));
+
+						const BCT t_start(start_time), t_end(1);
+						for (auto const& y : binomial_solutions[cell])
+						{
+							Vec<BCT> start_point(y.size()), refined, end_point;
+							for (unsigned kk = 0; kk < y.size(); ++kk)
+								start_point(kk) = BCT(y(kk));
+
+							if (tracker.Refine(refined, start_point, t_start)!=SuccessCode::Success
+							    || tracker.TrackPath(end_point, t_start, t_end, refined)!=SuccessCode::Success)
+							{
+								++num_failures[cell];
+								continue;
+							}
+							solutions[cell].push_back(end_point.template cast<dbl>());
+						}
+					}
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(exception_mutex);
+					if (!first_exception)
+						first_exception = std::current_exception();
+				}
+			};
+
+			std::vector<std::thread> threads;
+			for (unsigned ii = 1; ii < num_threads; ++ii)
+				threads.emplace_back(work, ii);
+			work(0);
+			for (auto& th : threads)
+				th.join();
+
+			if (first_exception)
+				std::rethrow_exception(first_exception);
+
+			std::vector<Vec<dbl> > start_points;
+			unsigned long long total_failures = 0;
+			for (size_t ii = 0; ii < num_cells; ++ii)
+			{
+				start_points.insert(start_points.end(), solutions[ii].begin(), solutions[ii].end());
+				total_failures += num_failures[ii];
+			}
+			start_system.SetStartPoints(start_points);
+			return total_failures;
+		}
+
+	} // re: namespace tracking
+} // re: namespace bertini
+
+#endif
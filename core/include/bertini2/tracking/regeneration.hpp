@@ -0,0 +1,262 @@
+//This file is part of Bertini 2.
+//
+//regeneration.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//regeneration.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with regeneration.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+
+/**
+\file regeneration.hpp
+
+\brief Provides SolveByRegeneration, which solves a system equation by equation.
+*/
+
+#ifndef BERTINI_TRACKING_REGENERATION_HPP
+#define BERTINI_TRACKING_REGENERATION_HPP
+
+#include "bertini2/slice.hpp"
+#include "bertini2/tracking/solve.hpp"
+
+namespace bertini{
+	namespace tracking{
+
+		/**
+		\brief The outcome of SolveByRegeneration.
+		*/
+		template<typename ComplexType>
+		struct RegenerationResult
+		{
+			std::vector<Vec<ComplexType> > solutions; ///< The finite nonsingular solutions of the system, dehomogenized.
+			std::vector<unsigned long long> num_stage_solutions; ///< For each stage, the number of solutions kept, of the functions so far with the linears standing in for the rest.  The last is the number of solutions.
+			unsigned long long num_paths = 0; ///< The number of paths tracked, over all stages.
+		};
+
+
+		namespace detail{
+
+			/**
+			\brief Put a dehomogenized solution of a stage of regeneration into the coordinates of a homotopy, whose homogenizing variable comes first in the ordering of its one variable group.
+			*/
+			template<typename T, typename ComplexType>
+			Vec<T> RegenerationCoordinates(System const& homotopy, Vec<ComplexType> const& point)
+			{
+				Vec<T> x(homotopy.NumVariables());
+				x(0) = T(1);
+				for (unsigned ii = 0; ii < point.size(); ++ii)
+					x(ii+1) = T(point(ii));
+				if (std::is_same<T, mpfr>::value)
+					Precision(x, DefaultPrecision()); // the point may be from the end of a path in higher precision
+				homotopy.RescalePointToFitPatchInPlace(x);
+				return x;
+			}
+
+
+			/**
+			\brief The solutions of a stage of regeneration, as the start points of a homotopy.  Provides what TrackUnfinishedPaths needs of a start system.
+			*/
+			template<typename ComplexType>
+			struct RegenerationStartPoints
+			{
+				System const& homotopy;
+				std::vector<Vec<ComplexType> > const& points; ///< dehomogenized
+
+				unsigned long long NumStartPoints() const
+				{
+					return points.size();
+				}
+
+				template<typename T>
+				Vec<T> StartPoint(unsigned long long index) const
+				{
+					return RegenerationCoordinates<T>(homotopy, points[index]);
+				}
+			};
+
+
+			/**
+			\brief Track the paths of a homotopy of regeneration, from each of a set of points, in parallel, as Solve does.
+			*/
+			template<typename TrackerType, typename EndgameType>
+			std::vector<SolveResult<typename TrackerTraits<TrackerType>::BaseComplexType> >
+			TrackRegenerationPaths(System const& homotopy, std::vector<Vec<typename TrackerTraits<TrackerType>::BaseComplexType> > const& points, config::Solver<typename TrackerTraits<TrackerType>::BaseRealType> settings)
+			{
+				using BCT = typename TrackerTraits<TrackerType>::BaseComplexType;
+
+				if (points.empty())
+					return {};
+
+				settings.checkpoint_file.clear(); // there is no resuming a stage
+
+				SolveCheckpoint<BCT> progress;
+				progress.finished.resize(points.size(), false);
+				progress.results.resize(points.size());
+
+				// tracking in multiple precision leaves the default precision where the last path ended
+				const auto precision = DefaultPrecision();
+				TrackUnfinishedPaths<TrackerType, EndgameType>(homotopy, RegenerationStartPoints<BCT>{homotopy, points}, settings, progress);
+				DefaultPrecision(precision);
+				return std::move(progress.results);
+			}
+
+		} // re: namespace detail
+
+
+		/**
+		\brief Solve a square system equation by equation, by regeneration, finding its finite nonsingular solutions.
+
+		For systems whose total degree is far above their number of solutions, the intermediate systems have few solutions too, and tracking only those avoids most of the paths of a total degree homotopy going to infinity.
+
+		Each function \f$f_k\f$ of degree \f$d_k\f$ has random complex homogeneous linears \f$L_{k,0},\dots,L_{k,d_k-1}\f$, a LinearSlice on the variables.  Stage \f$k\f$ starts from the solutions of \f$f_1,\dots,f_{k-1},L_{k,0},\dots,L_{n,0}\f$, the first stage from the one solution of the linears.  These are regenerated, by moving \f$L_{k,0}\f$ to each of the other \f$L_{k,j}\f$, to the solutions of \f$f_1,\dots,f_{k-1},\prod_j L_{k,j},L_{k+1,0},\dots,L_{n,0}\f$, and tracked from there to \f$f_1,\dots,f_k,L_{k+1,0},\dots,L_{n,0}\f$, with the gamma trick homotopy of Solve.  Of the ends of those paths, those at infinity, and those which are singular, with cycle number above 1 or an ill-conditioned Jacobian, are dropped.  The rest are the solutions of stage \f$k\f$, so that the number of paths in each stage follows the number of finite nonsingular solutions of the stage before.  Hence solutions which are singular are not found.
+
+		The paths of each homotopy are distributed among threads as by Solve, each thread with its own clone of the homotopy.  For trackers whose numbers are mpfr, one thread is used.
+
+		\code{.cpp}
+		sys.Homogenize();
+		sys.AutoPatch();
+
+		config::Regeneration<double> settings;
+		auto result = SolveByRegeneration<DoublePrecisionTracker>(sys, settings);
+		\endcode
+
+		\param target The system to solve.  Square, polynomial, in one affine variable group, homogenized and patched.
+		\param settings The settings for tracking, for the paths moving linears, and for the solutions dropped.
+		\return The solutions, and the number kept at each stage.
+
+		\tparam TrackerType The type of tracker to use, such as AMPTracker or DoublePrecisionTracker.
+		\tparam EndgameType The type of endgame to run at the end of each path.
+
+		\throws std::runtime_error if the target is not square, is not homogenized and patched in one affine variable group, has a path variable, or has a function not a polynomial of positive degree.  Whatever the tracker or endgame throws, as Solve.
+		*/
+		template<typename TrackerType, typename EndgameType = typename EndgameSelector<TrackerType>::Cauchy>
+		RegenerationResult<typename TrackerTraits<TrackerType>::BaseComplexType>
+		SolveByRegeneration(System const& target, config::Regeneration<typename TrackerTraits<TrackerType>::BaseRealType> const& settings)
+		{
+			using BCT = typename TrackerTraits<TrackerType>::BaseComplexType;
+
+			if (target.HavePathVariable())
+				throw std::runtime_error("regeneration of a system with a path variable");
+			if (target.NumVariableGroups()!=1 || target.NumHomVariableGroups()!=0 || target.NumUngroupedVariables()!=0)
+				throw std::runtime_error("regeneration of a system not in exactly one affine variable group");
+			if (target.NumHomVariables()!=1 || !target.IsPatched())
+				throw std::runtime_error("regeneration of a system not homogenized and patched");
+			if (target.NumFunctions()!=target.NumNaturalVariables())
+				throw std::runtime_error("regeneration of a system which is not square");
+
+			const auto num_functions = target.NumFunctions();
+			const auto degrees = target.Degrees();
+			for (auto d : degrees)
+				if (d < 1)
+					throw std::runtime_error("regeneration of a system with a function not a polynomial of positive degree");
+
+			std::vector<LinearSlice> linears;
+			for (unsigned ii = 0; ii < num_functions; ++ii)
+				linears.push_back(LinearSlice::RandomComplex(target.VariableOrdering(), degrees[ii], true));
+
+			// the functions of the target before the stage, the given function for it, and the first linears after
+			auto stage_system = [&](unsigned stage, std::shared_ptr<node::Node> const& stage_function)
+			{
+				System s(target); // shares the variables, patch, and functions of the target
+				s.Function(stage)->SetRoot(stage_function);
+				for (unsigned ii = stage+1; ii < num_functions; ++ii)
+					s.Function(ii)->SetRoot(linears[ii].Linear(0));
+				return s;
+			};
+
+			// the one solution of the first linears, by solving the linear system they make with the patch
+			std::vector<Vec<BCT> > solutions;
+			{
+				auto linear_system = stage_system(0, linears[0].Linear(0));
+				linear_system.Differentiate(); // else it has the Jacobian of the target
+				Vec<dbl> origin = Vec<dbl>::Zero(linear_system.NumVariables());
+				Vec<dbl> x = linear_system.Jacobian(origin).lu().solve(-linear_system.Eval(origin));
+				Vec<dbl> x_dehomogenized = linear_system.DehomogenizePoint(x);
+
+				Vec<BCT> solution(x_dehomogenized.size());
+				for (unsigned ii = 0; ii < x_dehomogenized.size(); ++ii)
+					solution(ii) = BCT(x_dehomogenized(ii));
+				solutions.push_back(solution);
+			}
+
+			auto linear_settings = settings.solver;
+			linear_settings.tolerances.newton_before_endgame = settings.newton_before_endgame;
+			linear_settings.tolerances.newton_during_endgame = settings.newton_during_endgame;
+			linear_settings.tolerances.final_tolerance = settings.final_tolerance;
+			linear_settings.tolerances.final_tolerance_times_final_tolerance_multiplier = settings.final_tolerance * linear_settings.tolerances.final_tolerance_multiplier;
+
+			RegenerationResult<BCT> result;
+			for (unsigned stage = 0; stage < num_functions; ++stage)
+			{
+				// regenerate, moving the first linear to each of the others
+				auto start_points = solutions;
+				for (int jj = 1; jj < degrees[stage]; ++jj)
+				{
+					auto homotopy = GammaTrickHomotopy(stage_system(stage, linears[stage].Linear(jj)), stage_system(stage, linears[stage].Linear(0)));
+					for (auto const& r : detail::TrackRegenerationPaths<TrackerType, EndgameType>(homotopy, solutions, linear_settings))
+						if (r.tracking_success==SuccessCode::Success && r.endgame_success==SuccessCode::Success)
+							start_points.push_back(r.solution);
+					result.num_paths += solutions.size();
+				}
+
+				// and track from the product of the linears to the function
+				std::shared_ptr<node::Node> product = linears[stage].Linear(0);
+				for (int jj = 1; jj < degrees[stage]; ++jj)
+					product = product * linears[stage].Linear(jj);
+
+				auto homotopy = GammaTrickHomotopy(stage_system(stage, target.Function(stage)->entry_node()), stage_system(stage, product));
+				auto results = detail::TrackRegenerationPaths<TrackerType, EndgameType>(homotopy, start_points, settings.solver);
+				result.num_paths += start_points.size();
+
+				std::vector<Vec<dbl> > kept;
+				solutions.clear();
+				for (auto const& r : results)
+				{
+					if (r.tracking_success!=SuccessCode::Success || r.endgame_success!=SuccessCode::Success || r.cycle_number!=1)
+						continue;
+
+					Vec<dbl> solution(r.solution.size());
+					for (unsigned ii = 0; ii < r.solution.size(); ++ii)
+						solution(ii) = static_cast<dbl>(r.solution(ii));
+					if (!(solution.norm() < static_cast<double>(settings.finite_threshold)))
+						continue;
+
+					// the Jacobian of the homotopy at t=0 is that of the system of the stage
+					auto singular_values = Eigen::JacobiSVD<Mat<dbl> >(homotopy.Jacobian(detail::RegenerationCoordinates<dbl>(homotopy, solution), dbl(0))).singularValues();
+					if (!(singular_values(0) < static_cast<double>(settings.singular_threshold) * singular_values(singular_values.size()-1)))
+						continue;
+
+					if (std::any_of(kept.begin(), kept.end(),
+					                [&](Vec<dbl> const& s){ return (s - solution).norm() < static_cast<double>(settings.same_point_tolerance); }))
+						continue;
+
+					kept.push_back(solution);
+					solutions.push_back(r.solution);
+				}
+				result.num_stage_solutions.push_back(solutions.size());
+			}
+
+			result.solutions = solutions;
+			return result;
+		}
+
+	} // re: namespace tracking
+} // re: namespace bertini
+
+#endif
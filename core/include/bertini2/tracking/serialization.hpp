@@ -0,0 +1,147 @@
+//This file is part of Bertini 2.
+//
+//serialization.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//serialization.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with serialization.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+/**
+\file serialization.hpp
+
+\brief Serialization of systems and other objects to strings and files, for handing work to other processes, and for checkpointing solves.
+*/
+
+#ifndef BERTINI_TRACKING_SERIALIZATION_HPP
+#define BERTINI_TRACKING_SERIALIZATION_HPP
+
+#include <sstream>
+#include <string>
+
+#include <boost/serialization/complex.hpp>
+#include <boost/serialization/string.hpp>
+
+#include "bertini2/system.hpp"
+#include "bertini2/start_system.hpp"
+
+namespace bertini {
+
+	namespace tracking {
+
+		/**
+		\brief Write an object to a string, with a text archive.
+
+		Not for systems, which must be written with SaveSystem.
+		*/
+		template<typename T>
+		std::string Pack(T const& t)
+		{
+			std::ostringstream out;
+			{
+				boost::archive::text_oarchive oa(out);
+				oa << t;
+			}
+			return out.str();
+		}
+
+		/**
+		\brief Read an object from a string made by Pack.
+		*/
+		template<typename T>
+		void Unpack(std::string const& s, T & t)
+		{
+			std::istringstream in(s);
+			boost::archive::text_iarchive ia(in);
+			ia >> t;
+		}
+
+
+		/**
+		\brief Serialize a system into a string, with a text archive.
+
+		The node types are exported in this library, and Boost.Serialization finds the exports only from code in the library.  Hence systems are serialized here, rather than with Pack.
+		*/
+		std::string SaveSystem(System const& sys);
+
+		/**
+		\brief Serialize a total degree start system into a string, with a text archive.
+		*/
+		std::string SaveSystem(start_system::TotalDegree const& sys);
+
+		/**
+		\brief Serialize a multihomogeneous start system into a string, with a text archive.
+		*/
+		std::string SaveSystem(start_system::MHomogeneous const& sys);
+
+		/**
+		\brief Serialize a linear-product start system into a string, with a text archive.
+		*/
+		std::string SaveSystem(start_system::LinearProduct const& sys);
+
+		/**
+		\brief Serialize a polyhedral start system into a string, with a text archive.  Its mixed cells, and its start points if found, are kept.
+		*/
+		std::string SaveSystem(start_system::Polyhedral const& sys);
+
+		/**
+		\brief Read a system back from a string made by SaveSystem.
+		*/
+		void LoadSystem(std::string const& serialized, System & sys);
+
+		/**
+		\brief Read a total degree start system back from a string made by SaveSystem.
+		*/
+		void LoadSystem(std::string const& serialized, start_system::TotalDegree & sys);
+
+		/**
+		\brief Read a multihomogeneous start system back from a string made by SaveSystem.
+		*/
+		void LoadSystem(std::string const& serialized, start_system::MHomogeneous & sys);
+
+		/**
+		\brief Read a linear-product start system back from a string made by SaveSystem.
+		*/
+		void LoadSystem(std::string const& serialized, start_system::LinearProduct & sys);
+
+		/**
+		\brief Read a polyhedral start system back from a string made by SaveSystem.
+		*/
+		void LoadSystem(std::string const& serialized, start_system::Polyhedral & sys);
+
+
+		/**
+		\brief Write a string to a file, replacing the file at once.
+
+		The string is written to a temporary file next to the given one, which is then renamed over it, so that a process dying while writing leaves the previous file intact.
+
+		\throws std::runtime_error if the file cannot be written.
+		*/
+		void WriteFileAtomically(std::string const& filename, std::string const& contents);
+
+		/**
+		\brief Read the whole of a file into a string.
+
+		\throws std::runtime_error if the file cannot be read.
+		*/
+		std::string ReadFile(std::string const& filename);
+
+	} // re: namespace tracking
+} // re: namespace bertini
+
+#endif
@@ -0,0 +1,503 @@
+//This file is part of Bertini 2.
+//
+//solve.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//solve.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with solve.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+/**
+\file solve.hpp
+
+\brief Provides Solve, which tracks every path from a start system to a target system, in parallel.
+*/
+
+#ifndef BERTINI_TRACKING_SOLVE_HPP
+#define BERTINI_TRACKING_SOLVE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <exception>
+
+#include "bertini2/limb_pool.hpp"
+#include "bertini2/tracking/tracker.hpp"
+#include "bertini2/tracking/fixed_prec_cauchy_endgame.hpp"
+#include "bertini2/tracking/fixed_prec_powerseries_endgame.hpp"
+#include "bertini2/tracking/amp_cauchy_endgame.hpp"
+#include "bertini2/tracking/amp_powerseries_endgame.hpp"
+#include "bertini2/tracking/serialization.hpp"
+#include "bertini2/tracking/lockstep_tracker.hpp"
+#include "bertini2/detail/work_stealing.hpp"
+
+namespace bertini {
+
+	namespace tracking {
+
+		/**
+		\brief The outcome of tracking one path, and running the endgame on it.
+		*/
+		template<typename ComplexType>
+		struct SolveResult
+		{
+			unsigned long long start_index = 0; ///< The index of the start point of the path.
+			SuccessCode tracking_success = SuccessCode::Failure; ///< How tracking from the start time to the endgame boundary went.
+			SuccessCode endgame_success = SuccessCode::Failure; ///< How the endgame went.  Failure if it was not run, because tracking failed.
+			Vec<ComplexType> solution; ///< The dehomogenized approximation of the solution at the end of the path.  Empty if the endgame was not run.
+			unsigned cycle_number = 0; ///< The cycle number computed by the endgame.
+
+			template <typename Archive>
+			void serialize(Archive& ar, const unsigned version)
+			{
+				ar & start_index;
+				ar & tracking_success;
+				ar & endgame_success;
+				ar & solution;
+				ar & cycle_number;
+			}
+		};
+
+
+		/**
+		\brief The progress of a solve, saved periodically so that it can be resumed after the process dies.
+
+		Holds the homotopy and start system, since restarting with freshly made ones would change the random numbers in them, and with them the paths.  Only finished paths are recorded.  Paths in flight when the checkpoint is written are tracked again, from their start points, on resuming.
+		*/
+		template<typename ComplexType>
+		struct SolveCheckpoint
+		{
+			std::string homotopy; ///< The homotopy, as made by SaveSystem.
+			std::string start_system; ///< The start system, as made by SaveSystem.
+			std::vector<char> finished; ///< Whether the path from each start point has been tracked.
+			std::vector<SolveResult<ComplexType> > results; ///< The results, one per start point.  Meaningful only for finished paths.
+
+			template <typename Archive>
+			void serialize(Archive& ar, const unsigned version)
+			{
+				ar & homotopy;
+				ar & start_system;
+				ar & finished;
+				ar & results;
+			}
+		};
+
+
+
+		/**
+		\brief Build the homotopy \f$(1-t) f + \gamma t g\f$, with \f$f\f$ the target, \f$g\f$ the start system, and \f$\gamma\f$ a random complex number.
+
+		\return The homotopy, with path variable t.
+		*/
+		inline
+		System GammaTrickHomotopy(System const& target, System const& start_system)
+		{
+			auto t = std::make_shared<node::Variable>("t");
+			std::shared_ptr<node::Node> gamma = std::make_shared<node::Rational>(node::Rational::Rand());
+			auto homotopy = (1-t)*target + gamma*t*start_system;
+			homotopy.AddPathVariable(t);
+			return homotopy;
+		}
+
+
+		/**
+		\brief Tracks single paths of a homotopy, from the start time to the endgame boundary, and then through the endgame.
+
+		Holds a tracker and an endgame, set up once, for use on path after path.  Solve makes one per thread, each on its own clone of the homotopy.
+
+		\tparam TrackerType The type of tracker to use.
+		\tparam EndgameType The type of endgame to run at the end of each path.
+		*/
+		template<typename TrackerType, typename EndgameType = typename EndgameSelector<TrackerType>::Cauchy>
+		class PathSolver
+		{
+		public:
+			using BaseComplexType = typename TrackerTraits<TrackerType>::BaseComplexType;
+			using BaseRealType = typename TrackerTraits<TrackerType>::BaseRealType;
+			using PrecisionConfig = typename TrackerTraits<TrackerType>::PrecisionConfig;
+
+			/**
+			In multiple precision, turns on the limb pool (see EnableLimbPool), so that tracking at a fixed precision allocates no limbs once warm.
+
+			\param homotopy The homotopy to track on.  Must have a path variable, and must outlive the PathSolver.
+			\param settings The settings for the tracker, and the endgame boundary.
+			*/
+			PathSolver(System const& homotopy, config::Solver<BaseRealType> const& settings) : homotopy_(homotopy), tracker_(homotopy), endgame_(tracker_), endgame_boundary_(settings.endgame_boundary), initial_precision_(DefaultPrecision())
+			{
+				if (std::is_same<BaseComplexType, mpfr>::value)
+					EnableLimbPool();
+
+				tracker_.Setup(settings.predictor,
+				               settings.tolerances.newton_before_endgame, settings.tolerances.path_truncation_threshold,
+				               settings.stepping, settings.newton);
+				tracker_.PrecisionSetup(PrecisionConfig(homotopy));
+			}
+
+			/**
+			\brief Return to the precision in effect at construction, which the previous path may have changed.
+
+			Does nothing in double precision.  In multiple precision, call this before generating the start point for the next path.
+			*/
+			void ResetPrecision()
+			{
+				if (std::is_same<BaseComplexType, mpfr>::value)
+				{
+					DefaultPrecision(initial_precision_);
+					homotopy_.precision(initial_precision_);
+				}
+			}
+
+			/**
+			\brief Track a path, and run the endgame on it.
+
+			\param index The index of the start point, recorded in the result.
+			\param start_point The start point of the path.
+			\return The outcome of tracking the path.
+			*/
+			SolveResult<BaseComplexType> Run(unsigned long long index, Vec<BaseComplexType> const& start_point)
+			{
+				BaseComplexType t_start(1), t_endgame_boundary(endgame_boundary_);
+
+				Vec<BaseComplexType> boundary_point;
+				auto tracking_success = tracker_.TrackPath(boundary_point, t_start, t_endgame_boundary, start_point);
+				if (tracking_success!=SuccessCode::Success)
+				{
+					SolveResult<BaseComplexType> result;
+					result.start_index = index;
+					result.tracking_success = tracking_success;
+					return result;
+				}
+
+				return RunFromBoundary(index, boundary_point);
+			}
+
+			/**
+			\brief Run the endgame on a path already tracked to the endgame boundary.
+
+			\param index The index of the start point, recorded in the result.
+			\param boundary_point The point on the path at the endgame boundary.
+			\return The outcome of the endgame, with tracking_success Success.
+			*/
+			SolveResult<BaseComplexType> RunFromBoundary(unsigned long long index, Vec<BaseComplexType> const& boundary_point)
+			{
+				SolveResult<BaseComplexType> result;
+				result.start_index = index;
+				result.tracking_success = SuccessCode::Success;
+
+				BaseComplexType t_endgame_boundary(endgame_boundary_);
+
+				// tracking may have raised the precision, and the time and point of the endgame must match
+				if (std::is_same<BaseComplexType, mpfr>::value)
+				{
+					homotopy_.precision(Precision(boundary_point(0)));
+					Precision(t_endgame_boundary, Precision(boundary_point(0)));
+				}
+
+				result.endgame_success = endgame_.Run(t_endgame_boundary, boundary_point);
+				result.solution = homotopy_.DehomogenizePoint(endgame_.template FinalApproximation<BaseComplexType>());
+				result.cycle_number = endgame_.CycleNumber();
+				return result;
+			}
+
+		private:
+			System const& homotopy_; ///< The homotopy tracked on.  The tracker and endgame refer to it, too.
+			TrackerType tracker_;
+			EndgameType endgame_;
+			BaseRealType endgame_boundary_;
+			unsigned initial_precision_; ///< The default precision when constructed, restored by ResetPrecision.
+		};
+
+
+		/**
+		\brief Solve a bundle of paths, tracking them to the endgame boundary together with a LockstepTracker.
+
+		The bundle is tracked first in double precision.  The paths which drop out of it needing higher precision continue in double-double, from where they stopped.  Paths which reach the boundary either way are finished by the endgame of the PathSolver, and the rest are tracked again from their start points by the PathSolver's own tracker, so that an AMPTracker takes those needing more than double-double.  Unless settings.bundle_size is more than one, solves the paths one at a time.
+
+		\param precision_config The settings for the precision criteria of the LockstepTracker.  See LockstepTracker::PrecisionConfig.
+		*/
+		template<typename PathSolverType, typename ComplexType, typename RealType>
+		std::vector<SolveResult<ComplexType> > SolveBundle(PathSolverType & solver, System const& homotopy, config::AdaptiveMultiplePrecisionConfig const& precision_config, config::Solver<RealType> const& settings,
+		                                                   std::vector<unsigned long long> const& indices, std::vector<Vec<ComplexType> > const& start_points)
+		{
+			std::vector<SolveResult<ComplexType> > results;
+			if (settings.bundle_size < 2)
+			{
+				for (size_t ii = 0; ii < indices.size(); ++ii)
+				{
+					solver.ResetPrecision();
+					results.push_back(solver.Run(indices[ii], start_points[ii]));
+				}
+				return results;
+			}
+
+			LockstepTracker lockstep(homotopy, precision_config);
+			lockstep.Setup(settings.tolerances.newton_before_endgame, settings.tolerances.path_truncation_threshold,
+			               settings.stepping, settings.newton);
+			const dbl boundary_time(static_cast<double>(settings.endgame_boundary));
+
+			std::vector<Vec<dbl> > double_points, double_boundary_points;
+			for (const auto& p : start_points)
+				double_points.push_back(p.template cast<dbl>());
+			std::vector<dbl> double_times(start_points.size(), dbl(1));
+			auto codes = lockstep.TrackPaths(double_boundary_points, double_times, boundary_time, double_points);
+
+			std::vector<size_t> dd_position(codes.size(), codes.size()); // of each path in the double-double bundle, or past its end
+			std::vector<Vec<dd_complex> > dd_points, dd_boundary_points;
+			std::vector<dd_complex> dd_times;
+			for (size_t ii = 0; ii < codes.size(); ++ii)
+				if (codes[ii]==SuccessCode::HigherPrecisionNecessary)
+				{
+					dd_position[ii] = dd_points.size();
+					dd_points.push_back(double_boundary_points[ii].unaryExpr([](dbl const& z){ return ToDoubleDouble(z); }));
+					dd_times.push_back(ToDoubleDouble(double_times[ii]));
+				}
+			std::vector<SuccessCode> dd_codes;
+			if (!dd_points.empty())
+				dd_codes = lockstep.TrackPaths(dd_boundary_points, dd_times, ToDoubleDouble(boundary_time), dd_points);
+
+			for (size_t ii = 0; ii < indices.size(); ++ii)
+			{
+				solver.ResetPrecision();
+
+				Vec<ComplexType> boundary_point;
+				if (codes[ii]==SuccessCode::Success)
+					boundary_point = double_boundary_points[ii].template cast<ComplexType>();
+				else if (dd_position[ii] < dd_codes.size() && dd_codes[dd_position[ii]]==SuccessCode::Success)
+				{
+					const auto& p = dd_boundary_points[dd_position[ii]];
+					boundary_point.resize(p.size());
+					for (int kk = 0; kk < p.size(); ++kk)
+						FromDoubleDouble(p(kk), boundary_point(kk));
+				}
+
+				if (boundary_point.size())
+					results.push_back(solver.RunFromBoundary(indices[ii], boundary_point));
+				else
+					results.push_back(solver.Run(indices[ii], start_points[ii]));
+			}
+			return results;
+		}
+
+
+		/**
+		\brief Track the paths not yet finished in progress, in parallel, recording their results in it.
+
+		The body of Solve and ResumeSolve.  If settings.checkpoint_file is set, progress is written to it at most every settings.checkpoint_interval seconds, as paths finish, and once more at the end, even if a path threw.
+		*/
+		template<typename TrackerType, typename EndgameType, typename StartSystemType>
+		void TrackUnfinishedPaths(System const& homotopy, StartSystemType const& start_system, config::Solver<typename TrackerTraits<TrackerType>::BaseRealType> const& settings, SolveCheckpoint<typename TrackerTraits<TrackerType>::BaseComplexType> & progress)
+		{
+			using BCT = typename TrackerTraits<TrackerType>::BaseComplexType;
+			const bool is_multiple_precision = std::is_same<BCT, mpfr>::value;
+			const unsigned bundle_size = std::max(settings.bundle_size, 1u);
+			const bool checkpointing = !settings.checkpoint_file.empty();
+
+			std::vector<unsigned long long> unfinished;
+			for (unsigned long long ii = 0; ii < progress.finished.size(); ++ii)
+				if (!progress.finished[ii])
+					unfinished.push_back(ii);
+
+			unsigned num_threads = settings.num_threads ? settings.num_threads : std::max(std::thread::hardware_concurrency(), 1u);
+			if (is_multiple_precision)
+				num_threads = 1;
+			num_threads = static_cast<unsigned>(std::max(std::min<unsigned long long>(num_threads, unfinished.size()), 1ull));
+
+			// clone in this thread, before any of the workers start evaluating
+			std::vector<System> homotopies;
+			for (unsigned ii = 0; ii < num_threads; ++ii)
+			{
+				homotopies.push_back(homotopy.Clone());
+				// compiling the straight-line program for a bundle sets the default precision, briefly, for its double-double constants
+				if (bundle_size > 1)
+					homotopies.back().GetStraightLineProgram();
+			}
+
+			// the bounds for the precision criteria of the bundles are found by evaluating in multiple precision, which is better done once
+			config::AdaptiveMultiplePrecisionConfig bundle_precision_config;
+			if (bundle_size > 1)
+				bundle_precision_config = LockstepTracker(homotopy).PrecisionConfig();
+
+			detail::WorkStealingQueues queues(unfinished.size(), num_threads);
+
+			std::mutex start_system_mutex; // generating start points evaluates the nodes of the start system, which are shared
+			std::mutex progress_mutex;
+			std::mutex exception_mutex;
+			std::exception_ptr first_exception;
+			auto last_checkpoint = std::chrono::steady_clock::now();
+
+			auto work = [&](unsigned id)
+			{
+				try{
+					PathSolver<TrackerType, EndgameType> solver(homotopies[id], settings);
+
+					std::vector<unsigned long long> indices;
+					std::vector<Vec<BCT> > start_points;
+					while (true)
+					{
+						indices.clear();
+						unsigned long long job;
+						while (indices.size() < bundle_size && queues.Next(id, job))
+							indices.push_back(unfinished[job]);
+						if (indices.empty())
+							break;
+
+						solver.ResetPrecision();
+
+						start_points.clear();
+						{
+							std::lock_guard<std::mutex> lock(start_system_mutex);
+							for (auto index : indices)
+								start_points.push_back(start_system.template StartPoint<BCT>(index));
+						}
+
+						auto results = SolveBundle(solver, homotopies[id], bundle_precision_config, settings, indices, start_points);
+
+						std::lock_guard<std::mutex> lock(progress_mutex);
+						for (auto& result : results)
+						{
+							progress.finished[result.start_index] = true;
+							progress.results[result.start_index] = std::move(result);
+						}
+
+						auto now = std::chrono::steady_clock::now();
+						if (checkpointing && now - last_checkpoint >= std::chrono::seconds(settings.checkpoint_interval))
+						{
+							WriteFileAtomically(settings.checkpoint_file, Pack(progress));
+							last_checkpoint = now;
+						}
+					}
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(exception_mutex);
+					if (!first_exception)
+						first_exception = std::current_exception();
+				}
+			};
+
+			std::vector<std::thread> threads;
+			for (unsigned ii = 1; ii < num_threads; ++ii)
+				threads.emplace_back(work, ii);
+			work(0);
+			for (auto& th : threads)
+				th.join();
+
+			if (checkpointing)
+				WriteFileAtomically(settings.checkpoint_file, Pack(progress));
+
+			if (first_exception)
+				std::rethrow_exception(first_exception);
+		}
+
+
+
+		/**
+		\brief Track every path from a start system to a target system, in parallel.
+
+		Builds the homotopy with GammaTrickHomotopy, and tracks the path from each start point from \f$t=1\f$ to the endgame boundary, then runs the endgame to \f$t=0\f$.
+
+		The paths are distributed among a set of threads.  Each thread tracks on its own clone of the homotopy (see System::Clone), with its own PathSolver.  Start point indices are dealt out in blocks, and a thread which finishes its block steals from the others, because the costs of paths vary by orders of magnitude.
+
+		If settings.bundle_size is more than one, each thread takes that many start points at a time, and tracks them to the endgame boundary together, with a LockstepTracker, in double precision and then, for those needing it, double-double.  Paths which drop out of a bundle are tracked again by the tracker of the solve.  So with an AMPTracker, the precision of a path escalates from double, through double-double, to mpfr.
+
+		Boost.Multiprecision keeps the default precision of mpfr numbers in a single global, which trackers using multiple precision change as they go.  Hence for trackers whose numbers are mpfr, the paths are tracked in one thread, regardless of settings.num_threads.
+
+		If settings.checkpoint_file is set, the homotopy, the start system, and the results of finished paths are saved to it periodically, as a SolveCheckpoint.  If the process dies, ResumeSolve picks up from the file.
+
+		\code{.cpp}
+		sys.Homogenize();
+		sys.AutoPatch();
+		auto TD = start_system::TotalDegree(sys);
+		TD.Homogenize();
+
+		config::Solver<double> settings;
+		auto results = Solve<DoublePrecisionTracker>(sys, TD, settings);
+		\endcode
+
+		\param target The system to solve.  Homogenized and patched, as the start system must be.
+		\param start_system The start system, providing NumStartPoints() and StartPoint<T>(index).
+		\param settings The settings for the tracker, the number of threads, and checkpointing.
+		\return One result per start point, in order of start point index.
+
+		\tparam TrackerType The type of tracker to use, such as AMPTracker or DoublePrecisionTracker.
+		\tparam EndgameType The type of endgame to run at the end of each path.
+		\tparam StartSystemType The type of the start system.
+
+		\throws Whatever the tracker or endgame throws, in any thread, after all threads have finished.
+		*/
+		template<typename TrackerType, typename EndgameType = typename EndgameSelector<TrackerType>::Cauchy, typename StartSystemType>
+		std::vector<SolveResult<typename TrackerTraits<TrackerType>::BaseComplexType> >
+		Solve(System const& target, StartSystemType const& start_system, config::Solver<typename TrackerTraits<TrackerType>::BaseRealType> const& settings)
+		{
+			using BCT = typename TrackerTraits<TrackerType>::BaseComplexType;
+
+			auto num_paths = static_cast<unsigned long long>(start_system.NumStartPoints());
+			auto homotopy = GammaTrickHomotopy(target, start_system);
+
+			SolveCheckpoint<BCT> progress;
+			progress.finished.resize(num_paths, false);
+			progress.results.resize(num_paths);
+			if (!settings.checkpoint_file.empty())
+			{
+				progress.homotopy = SaveSystem(homotopy);
+				progress.start_system = SaveSystem(start_system);
+			}
+
+			TrackUnfinishedPaths<TrackerType, EndgameType>(homotopy, start_system, settings, progress);
+			return std::move(progress.results);
+		}
+
+
+
+		/**
+		\brief Finish a solve interrupted after writing a checkpoint.
+
+		Reads the SolveCheckpoint written by Solve to settings.checkpoint_file, and tracks the paths not finished in it, on the homotopy and start system saved in it.  Checkpoints continue to be written to the same file.
+
+		\param settings The settings for the tracker, the number of threads, and checkpointing.  Need not be those the solve was started with, except for checkpoint_file.
+		\return One result per start point, in order of start point index, including those read from the checkpoint.
+
+		\tparam TrackerType The type of tracker to use.  Its complex type must be that of the interrupted solve.
+		\tparam EndgameType The type of endgame to run at the end of each path.
+		\tparam StartSystemType The type of the start system of the interrupted solve.
+
+		\throws std::runtime_error if the checkpoint file cannot be read.  Whatever the tracker or endgame throws, as Solve.
+		*/
+		template<typename TrackerType, typename EndgameType = typename EndgameSelector<TrackerType>::Cauchy, typename StartSystemType = start_system::TotalDegree>
+		std::vector<SolveResult<typename TrackerTraits<TrackerType>::BaseComplexType> >
+		ResumeSolve(config::Solver<typename TrackerTraits<TrackerType>::BaseRealType> const& settings)
+		{
+			using BCT = typename TrackerTraits<TrackerType>::BaseComplexType;
+
+			SolveCheckpoint<BCT> progress;
+			Unpack(ReadFile(settings.checkpoint_file), progress);
+
+			System homotopy;
+			LoadSystem(progress.homotopy, homotopy);
+			StartSystemType start_system;
+			LoadSystem(progress.start_system, start_system);
+
+			TrackUnfinishedPaths<TrackerType, EndgameType>(homotopy, start_system, settings, progress);
+			return std::move(progress.results);
+		}
+
+	} // re: namespace tracking
+} // re: namespace bertini
+
+#endif
@@ -0,0 +1,124 @@
+//This file is part of Bertini 2.
+//
+//sparse_jacobian_lu.hpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//sparse_jacobian_lu.hpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with sparse_jacobian_lu.hpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+
+#ifndef BERTINI_TRACKING_SPARSE_JACOBIAN_LU_HPP
+#define BERTINI_TRACKING_SPARSE_JACOBIAN_LU_HPP
+
+/**
+\file sparse_jacobian_lu.hpp
+
+\brief Provides SparseJacobianLU, the sparse Jacobian of a system with its sparse LU factorization, for the predictors and correctors.
+*/
+
+#include <memory>
+
+#include "bertini2/system.hpp"
+
+namespace bertini{
+	namespace tracking{
+
+		/**
+		\brief The Jacobian of a system as a sparse matrix, and its sparse LU factorization.
+
+		Used by the predictors and correctors in place of a dense Jacobian and its PartialPivLU, when System::UseSparseLinearAlgebra holds.  Only the structurally nonzero entries are evaluated, by System::SparseJacobianInPlace, and Eigen's SparseLU orders the columns to keep the fill of the factors low, so that for Jacobians with a few entries per row the factorization costs far less than the dense \f$O(n^3)\f$ one.
+
+		The factorization is made anew for each Jacobian, so that its workspace is at the current precision.  Copies get the Jacobian but not the factorization, and must Factor before they Solve.
+
+		\tparam ComplexType dbl or mpfr.
+		*/
+		template<typename ComplexType>
+		class SparseJacobianLU
+		{
+		public:
+			using RealType = typename Eigen::NumTraits<ComplexType>::Real;
+
+			SparseJacobianLU() = default;
+
+			SparseJacobianLU(SparseJacobianLU const& other) : J_(other.J_)
+			{}
+
+			SparseJacobianLU& operator=(SparseJacobianLU const& other)
+			{
+				J_ = other.J_;
+				LU_.reset();
+				return *this;
+			}
+
+			/**
+			\brief Evaluate the Jacobian of a system at a point and time, and factor it.
+
+			\return Whether the factorization succeeded.  It fails if the Jacobian is singular.
+			*/
+			template<typename Derived>
+			bool Factor(System const& S, Eigen::MatrixBase<Derived> const& space, ComplexType const& time)
+			{
+				S.SparseJacobianInPlace(J_, space, time);
+				LU_.reset(new Eigen::SparseLU<SparseMat<ComplexType> >(J_));
+				return LU_->info()==Eigen::Success;
+			}
+
+			/**
+			\brief Solve \f$Jx = b\f$ with the factorization.
+			*/
+			template<typename Rhs>
+			void Solve(Vec<ComplexType> & x, Eigen::MatrixBase<Rhs> const& b) const
+			{
+				x = LU_->solve(b);
+			}
+
+			/**
+			\brief The Frobenius norm of the Jacobian, as the dense Jacobians' norm() in the criteria for adaptive precision.
+			*/
+			RealType Norm() const
+			{
+				return J_.norm();
+			}
+
+			/**
+			\brief Estimate the 1-norm of the inverse of the Jacobian, from the factorization.  See bertini::EstimateInverseNorm.
+			*/
+			RealType EstimateInverseNorm(Vec<ComplexType> & x, Vec<ComplexType> & y) const
+			{
+				return bertini::EstimateInverseNorm(*LU_, x, y);
+			}
+
+			/**
+			\brief The Jacobian last factored.
+			*/
+			SparseMat<ComplexType> const& Jacobian() const
+			{
+				return J_;
+			}
+
+		private:
+
+			SparseMat<ComplexType> J_;
+			std::unique_ptr< Eigen::SparseLU<SparseMat<ComplexType> > > LU_; ///< Made anew for each Jacobian.  Not copyable, hence the copy members above.
+		};
+
+	} // re: namespace tracking
+} // re: namespace bertini
+
+#endif
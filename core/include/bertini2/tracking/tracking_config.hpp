@@ -268,7 +268,7 @@ namespace bertini
 				unsigned min_num_steps = 1;
 				unsigned max_num_steps = 1e5;
 
-				unsigned frequency_of_CN_estimation = 1;
+				unsigned frequency_of_CN_estimation = 1; ///< The number of steps between estimates of the condition number, and of the norm of the inverse of the Jacobian, by the predictor.  In between, the latest estimate stands.
 			};
 
 
@@ -277,6 +277,9 @@ namespace bertini
 			{
 				unsigned max_num_newton_iterations = 2;
 				unsigned min_num_newton_iterations = 1;
+
+				bool reuse_factorization = false; ///< If true, the corrector keeps the LU factorization of the Jacobian from one iteration to the next (the chord, or simplified, Newton method), evaluating only the functions, until the steps stop contracting.
+				double max_chord_contraction = 0.5; ///< With reuse_factorization, the Jacobian is evaluated and factored anew once the ratio of the norm of a step to that of the one before exceeds this.
 			};
 
 
@@ -326,6 +329,53 @@ namespace bertini
 			};
 
 
+			/**
+			\brief Settings for Solve, the driver tracking every path from a start system.
+			*/
+			template<typename T>
+			struct Solver
+			{
+				unsigned num_threads = 0; ///< The number of threads among which to distribute the paths.  0 means one per hardware thread.
+				T endgame_boundary = T(1)/T(10); ///< The time at which tracking stops, and the endgame takes over.
+
+				Predictor predictor = Predictor::RK4;
+				Stepping<T> stepping;
+				Newton newton;
+				Tolerances<T> tolerances; ///< newton_before_endgame is used as the tracking tolerance.
+
+				std::string checkpoint_file; ///< The file to which Solve saves its progress, for ResumeSolve.  Empty for no checkpointing.
+				unsigned checkpoint_interval = 300; ///< The least number of seconds between checkpoints.
+				unsigned bundle_size = 0; ///< If more than one, paths are first tracked to the endgame boundary by a LockstepTracker, this many at a time, in double precision, and then in double-double for those needing it.  Paths dropping out of a bundle are tracked again by the tracker of the solve.
+			};
+
+
+			/**
+			\brief Settings for DistributedSolve, the driver spreading paths over worker processes.
+			*/
+			template<typename T>
+			struct Distributed
+			{
+				unsigned num_workers = 2; ///< The number of worker processes.
+				unsigned batch_size = 8; ///< The number of paths handed to a worker at a time.
+				unsigned max_attempts = 3; ///< The number of times a batch is handed out, to workers which die on it, before its paths are given up on.
+
+				Solver<T> solver; ///< The settings for tracking in each worker.  num_threads is ignored, as each worker tracks in one thread.
+			};
+
+
+			/**
+			\brief Settings for ParameterHomotopy, which solves a parametrized family at a generic point, and then at many others.
+			*/
+			template<typename T>
+			struct ParameterHomotopy
+			{
+				T finite_threshold = T(100000); ///< Generic solutions larger than this, dehomogenized, are taken to be at infinity, and are not kept.
+				T same_point_tolerance = T(1)/T(100000000); ///< Generic solutions closer than this are taken to be the same, and kept once.
+
+				Solver<T> solver; ///< The settings for tracking, for the solve at the generic point, and for the parameter homotopies.  num_threads is the number of threads among which the parameter points are distributed.
+			};
+
+
 			struct TrackBack
 			{
 				unsigned minimum_cycle;
@@ -355,15 +405,23 @@ namespace bertini
 
 
 
+			/**
+			\brief Settings for SolveByRegeneration, the equation-by-equation solver.
+
+			The tolerances are for the paths moving one linear of a stage to another, in place of those of solver, as their ends are the start points of the homotopy of the stage.
+			*/
 			template<typename T>
 			struct Regeneration
 			{
-				bool remove_infinite_endpoints;
-				bool higher_dimension_check;
+				T newton_before_endgame = T(1)/T(10000000); ///< The tracking tolerance of the paths moving linears.
+				T newton_during_endgame = T(1)/T(100000000); ///< The tolerance during the endgame of the paths moving linears.
+				T final_tolerance = T(1)/T(100000000000); ///< The final tolerance of the paths moving linears.
+
+				T finite_threshold = T(100000); ///< Solutions of a stage larger than this, dehomogenized, are taken to be at infinity, and dropped.
+				T singular_threshold = T(100000000); ///< Solutions of a stage at which the condition number of its Jacobian is more than this are taken to be singular, and dropped.
+				T same_point_tolerance = T(1)/T(100000000); ///< Solutions of a stage closer than this are taken to be the same, and kept once.
 
-				T newton_before_endgame;
-				T newton_during_endgame;
-				T final_tolerance;
+				Solver<T> solver; ///< The settings for tracking.  num_threads is the number of threads among which the paths of each stage are distributed.
 			};
 
 			
@@ -435,6 +493,9 @@ namespace bertini
 
 				unsigned max_num_precision_decreases = 10; ///< The maximum number of times precision can be lowered during tracking of a segment of path.
 				
+				bool mixed_precision_linear_solves = false; ///< Whether linear solves in multiple precision factor in double or double-double, refining the solutions in the full precision.  See MixedPrecisionLU.
+				unsigned max_refinement_iterations = 10; ///< The most steps of refinement in a mixed-precision linear solve, after which the matrix is factored in full precision.
+
 
 				/**
 				 \brief Set epsilon, degree bound, and coefficient bound from system.
@@ -489,6 +550,8 @@ namespace bertini
 				out << "safety_digits_1: " << AMP.safety_digits_1 << "\n";
 				out << "safety_digits_2: " << AMP.safety_digits_2 << "\n";
 				out << "consecutive_successful_steps_before_precision_decrease" << AMP.consecutive_successful_steps_before_precision_decrease << "\n";
+				out << "mixed_precision_linear_solves: " << AMP.mixed_precision_linear_solves << "\n";
+				out << "max_refinement_iterations: " << AMP.max_refinement_iterations << "\n";
 				return out;
 			}
 
@@ -0,0 +1,314 @@
+//This file is part of Bertini 2.
+//
+//double_double.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//double_double.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with double_double.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+#include "bertini2/double_double.hpp"
+
+#include <ostream>
+
+
+namespace bertini {
+
+	namespace {
+
+		const dd_real ln2(6.931471805599452862e-01, 2.319046813846299558e-17);
+		const dd_real ln10(2.302585092994045901e+00, -2.170756223382249351e-16);
+		const dd_real pi(3.141592653589793116e+00, 1.224646799147353207e-16);
+		const dd_real two_pi(6.283185307179586232e+00, 2.449293598294706414e-16);
+		const dd_real half_pi(1.570796326794896558e+00, 6.123233995736766036e-17);
+
+		/**
+		\brief Whether a term of a series is too small to change a sum.
+		*/
+		bool Negligible(dd_real const& term, dd_real const& sum)
+		{
+			return std::abs(term.hi()) <= std::abs(sum.hi())*1e-33;
+		}
+
+		/**
+		\brief Compute the sine and cosine together, as both are needed for either.
+		*/
+		void SinCos(dd_real const& a, dd_real & s, dd_real & c)
+		{
+			if (a==dd_real(0))
+			{
+				s = dd_real(0);
+				c = dd_real(1);
+				return;
+			}
+
+			// reduce modulo 2 pi, and then to within pi/4 of a multiple j of pi/2
+			dd_real r = a - two_pi*std::floor((a/two_pi).hi() + 0.5);
+			const double j = std::floor(r.hi()/half_pi.hi() + 0.5);
+			dd_real t = r - half_pi*j;
+
+			// Taylor series for the sine.  the cosine follows from it, without cancellation, as |t| <= pi/4
+			const dd_real t_squared = t*t;
+			dd_real term = t, sin_t = t;
+			for (int n = 3; n < 60; n += 2)
+			{
+				term = -term*t_squared/dd_real(double((n-1)*n));
+				sin_t += term;
+				if (Negligible(term, sin_t))
+					break;
+			}
+			dd_real cos_t = sqrt(1.0 - sin_t*sin_t);
+
+			switch (static_cast<int>(j))
+			{
+				case 0:
+					s = sin_t; c = cos_t; break;
+				case 1:
+					s = cos_t; c = -sin_t; break;
+				case -1:
+					s = -cos_t; c = sin_t; break;
+				default: // plus or minus 2
+					s = -sin_t; c = -cos_t; break;
+			}
+		}
+
+	} // re: anonymous namespace
+
+
+
+	dd_real::dd_real(mpfr_float const& x)
+	{
+		mpfr_srcptr v = x.backend().data();
+		hi_ = mpfr_get_d(v, MPFR_RNDN);
+		lo_ = 0;
+		if (!std::isfinite(hi_))
+			return;
+
+		// the difference is exact in the precision of x
+		mpfr_t r;
+		mpfr_init2(r, mpfr_get_prec(v));
+		mpfr_sub_d(r, v, hi_, MPFR_RNDN);
+		lo_ = mpfr_get_d(r, MPFR_RNDN);
+		mpfr_clear(r);
+	}
+
+
+	dd_real::operator mpfr_float() const
+	{
+		mpfr_float result;
+		mpfr_set_d(result.backend().data(), hi_, MPFR_RNDN);
+		mpfr_add_d(result.backend().data(), result.backend().data(), lo_, MPFR_RNDN);
+		return result;
+	}
+
+
+
+	dd_real sqrt(dd_real const& a)
+	{
+		if (a.hi_<=0)
+			return a.hi_==0 ? dd_real(0) : dd_real(std::numeric_limits<double>::quiet_NaN());
+
+		// Karp's trick: one Newton step from the double precision square root
+		const double x = 1.0/std::sqrt(a.hi_);
+		const double ax = a.hi_*x;
+		double s, e;
+		dd_real::TwoSum(ax, (a - dd_real(ax)*ax).hi_*(x*0.5), s, e);
+		return dd_real(s, e);
+	}
+
+
+	dd_real exp(dd_real const& a)
+	{
+		if (a.hi_ <= -709.0)
+			return dd_real(0);
+		if (a.hi_ >= 709.8)
+			return dd_real(std::numeric_limits<double>::infinity());
+		if (a==dd_real(0))
+			return dd_real(1);
+
+		// exp(a) = 2^m exp(r), with |r| <= ln(2)/2.  r is further scaled down by 2^9, and the result squared back up
+		const double m = std::floor(a.hi_/ln2.hi_ + 0.5);
+		const dd_real r = ldexp(a - ln2*m, -9);
+
+		// the series for exp(r)-1, so that squaring doesn't lose the low digits of a number near 1
+		dd_real term = r, s = r;
+		for (int n = 2; n < 30; ++n)
+		{
+			term = term*r/dd_real(double(n));
+			s += term;
+			if (Negligible(term, s))
+				break;
+		}
+
+		for (int ii = 0; ii < 9; ++ii)
+			s = ldexp(s, 1) + s*s; // (1+s)^2 - 1
+
+		return ldexp(s + 1.0, static_cast<int>(m));
+	}
+
+
+	dd_real log(dd_real const& a)
+	{
+		if (a.hi_<=0)
+			return a.hi_==0 ? dd_real(-std::numeric_limits<double>::infinity()) : dd_real(std::numeric_limits<double>::quiet_NaN());
+
+		// one Newton step on exp(x) = a, from the double precision logarithm
+		dd_real x(std::log(a.hi_));
+		return x + a*exp(-x) - 1.0;
+	}
+
+
+	dd_real log10(dd_real const& a)
+	{
+		return log(a)/ln10;
+	}
+
+
+	dd_real sin(dd_real const& a)
+	{
+		dd_real s, c;
+		SinCos(a, s, c);
+		return s;
+	}
+
+
+	dd_real cos(dd_real const& a)
+	{
+		dd_real s, c;
+		SinCos(a, s, c);
+		return c;
+	}
+
+
+	dd_real tan(dd_real const& a)
+	{
+		dd_real s, c;
+		SinCos(a, s, c);
+		return s/c;
+	}
+
+
+	dd_real sinh(dd_real const& a)
+	{
+		if (std::abs(a.hi_) > 0.05)
+		{
+			dd_real e = exp(a);
+			return ldexp(e - 1.0/e, -1);
+		}
+
+		// the difference of exponentials cancels badly for small arguments, so sum the series instead
+		const dd_real a_squared = a*a;
+		dd_real term = a, s = a;
+		for (int n = 3; n < 60; n += 2)
+		{
+			term = term*a_squared/dd_real(double((n-1)*n));
+			s += term;
+			if (Negligible(term, s))
+				break;
+		}
+		return s;
+	}
+
+
+	dd_real cosh(dd_real const& a)
+	{
+		dd_real e = exp(a);
+		return ldexp(e + 1.0/e, -1);
+	}
+
+
+	dd_real tanh(dd_real const& a)
+	{
+		if (std::abs(a.hi_) > 0.05)
+		{
+			dd_real e = exp(a), inverse = 1.0/e;
+			return (e - inverse)/(e + inverse);
+		}
+
+		dd_real s = sinh(a);
+		return s/sqrt(1.0 + s*s);
+	}
+
+
+	dd_real atan2(dd_real const& y, dd_real const& x)
+	{
+		if (x.hi_==0)
+		{
+			if (y.hi_==0)
+				return dd_real(0);
+			return y.hi_ > 0 ? half_pi : -half_pi;
+		}
+		if (y.hi_==0)
+			return x.hi_ > 0 ? dd_real(0) : pi;
+
+		// one Newton step from the double precision angle, on whichever of the sine or cosine is the better conditioned
+		const dd_real r = sqrt(x*x + y*y);
+		const dd_real xx = x/r, yy = y/r;
+
+		dd_real z(std::atan2(y.hi_, x.hi_)), s, c;
+		SinCos(z, s, c);
+		if (std::abs(xx.hi_) > std::abs(yy.hi_))
+			z += (yy - s)/c;
+		else
+			z -= (xx - c)/s;
+		return z;
+	}
+
+
+	dd_real atan(dd_real const& a)
+	{
+		return atan2(a, dd_real(1));
+	}
+
+
+	dd_real pow(dd_real const& a, dd_real const& b)
+	{
+		return exp(b*log(a));
+	}
+
+
+	dd_real pow(dd_real const& a, int n)
+	{
+		if (n==0)
+			return dd_real(1);
+
+		unsigned m = n < 0 ? -static_cast<unsigned>(n) : static_cast<unsigned>(n);
+		dd_real result(1), square = a;
+		while (m)
+		{
+			if (m & 1u)
+				result *= square;
+			m >>= 1;
+			if (m)
+				square *= square;
+		}
+		return n < 0 ? dd_real(1)/result : result;
+	}
+
+
+	std::ostream& operator<<(std::ostream& out, dd_real const& a)
+	{
+		// printed through mpfr, at enough bits for the sum of the parts, so that the formatting follows the flags of the stream as for other types
+		mpfr_float x;
+		x.precision(40);
+		mpfr_set_d(x.backend().data(), a.hi_, MPFR_RNDN);
+		mpfr_add_d(x.backend().data(), x.backend().data(), a.lo_, MPFR_RNDN);
+		return out << x;
+	}
+
+} // re: namespace bertini
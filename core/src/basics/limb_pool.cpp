@@ -0,0 +1,199 @@
+//This file is part of Bertini 2.
+//
+//limb_pool.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//limb_pool.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with limb_pool.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+#include "bertini2/config.h"
+#include "bertini2/limb_pool.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <gmp.h>
+
+#ifdef USE_THREAD_LOCAL
+	#define BERTINI_LIMB_POOL_THREAD_LOCAL thread_local
+#else
+	#define BERTINI_LIMB_POOL_THREAD_LOCAL
+#endif
+
+namespace bertini {
+
+	namespace {
+
+		const std::size_t granule = sizeof(mp_limb_t); ///< GMP and MPFR allocate whole limbs.  Other sizes are not pooled.
+		const std::size_t largest_pooled = std::size_t(1) << 14; ///< In bytes.  Enough for about 130000 bits.
+		const std::size_t most_kept_per_size = 1024; ///< Beyond this many free blocks of a size, blocks go back to the system.
+
+		struct Pool
+		{
+			std::vector<std::vector<void*> > free_blocks; ///< Indexed by size in limbs.
+			std::size_t misses = 0;
+
+			Pool() : free_blocks(largest_pooled/granule + 1)
+			{}
+
+			~Pool()
+			{
+				for (auto& blocks : free_blocks)
+					for (auto b : blocks)
+						std::free(b);
+			}
+		};
+
+		// the pool is reached through a pointer, and its state kept in a plain enum, so that numbers destroyed after the pool, during the exit of the thread, find it gone, rather than find a destroyed object.
+		enum class PoolState : char { Unborn, Alive, Dead };
+		BERTINI_LIMB_POOL_THREAD_LOCAL PoolState pool_state = PoolState::Unborn;
+		BERTINI_LIMB_POOL_THREAD_LOCAL Pool* pool = nullptr;
+
+		struct PoolOwner
+		{
+			~PoolOwner()
+			{
+				delete pool;
+				pool = nullptr;
+				pool_state = PoolState::Dead;
+			}
+		};
+
+		Pool* ThisThreadsPool()
+		{
+			if (pool_state==PoolState::Alive)
+				return pool;
+			if (pool_state==PoolState::Dead)
+				return nullptr;
+
+			static BERTINI_LIMB_POOL_THREAD_LOCAL PoolOwner owner;
+			(void)owner;
+			pool = new Pool;
+			pool_state = PoolState::Alive;
+			return pool;
+		}
+
+		bool IsPooled(std::size_t size)
+		{
+			return size>0 && size<=largest_pooled && size%granule==0;
+		}
+
+		void* SystemAllocate(std::size_t size)
+		{
+			void* block = std::malloc(size);
+			if (!block)
+			{
+				// GMP cannot handle a failed allocation, and its own allocator aborts, too
+				std::fprintf(stderr, "bertini limb pool: unable to allocate %zu bytes\n", size);
+				std::abort();
+			}
+			return block;
+		}
+
+		void* PoolAllocate(std::size_t size)
+		{
+			if (IsPooled(size))
+				if (auto p = ThisThreadsPool())
+				{
+					auto& blocks = p->free_blocks[size/granule];
+					if (!blocks.empty())
+					{
+						void* block = blocks.back();
+						blocks.pop_back();
+						return block;
+					}
+					++p->misses;
+				}
+
+			return SystemAllocate(size);
+		}
+
+		void PoolFree(void* block, std::size_t size)
+		{
+			if (IsPooled(size))
+				if (auto p = ThisThreadsPool())
+				{
+					auto& blocks = p->free_blocks[size/granule];
+					if (blocks.size() < most_kept_per_size)
+						try{
+							blocks.push_back(block);
+							return;
+						}
+						catch (...)
+						{} // fall through, and give the block back
+				}
+
+			std::free(block);
+		}
+
+		void* PoolReallocate(void* block, std::size_t old_size, std::size_t new_size)
+		{
+			if (old_size==new_size)
+				return block;
+
+			if (!IsPooled(old_size) && !IsPooled(new_size))
+			{
+				void* moved = std::realloc(block, new_size);
+				if (!moved)
+				{
+					std::fprintf(stderr, "bertini limb pool: unable to reallocate to %zu bytes\n", new_size);
+					std::abort();
+				}
+				return moved;
+			}
+
+			void* moved = PoolAllocate(new_size);
+			std::memcpy(moved, block, old_size<new_size ? old_size : new_size);
+			PoolFree(block, old_size);
+			return moved;
+		}
+
+	} // re: anonymous namespace
+
+
+
+	void EnableLimbPool()
+	{
+		mp_set_memory_functions(&PoolAllocate, &PoolReallocate, &PoolFree);
+	}
+
+
+	void DisableLimbPool()
+	{
+		mp_set_memory_functions(nullptr, nullptr, nullptr);
+	}
+
+
+	bool LimbPoolEnabled()
+	{
+		void* (*allocate)(std::size_t);
+		mp_get_memory_functions(&allocate, nullptr, nullptr);
+		return allocate==&PoolAllocate;
+	}
+
+
+	std::size_t LimbPoolMisses()
+	{
+		auto p = ThisThreadsPool();
+		return p ? p->misses : 0;
+	}
+
+} // re: namespace bertini
@@ -0,0 +1,132 @@
+//This file is part of Bertini 2.
+//
+//common_subexpressions.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//common_subexpressions.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with common_subexpressions.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2015, 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+#include "function_tree/common_subexpressions.hpp"
+#include "function_tree/dependencies.hpp"
+
+#include <sstream>
+#include <unordered_set>
+
+
+namespace bertini {
+namespace node {
+
+	std::shared_ptr<Node> HashConsingFactory::Canonicalize(std::shared_ptr<Node> const& n)
+	{
+		auto found = seen_.find(n.get());
+		if (found!=seen_.end())
+			return found->second.second;
+
+		Key key(std::type_index(typeid(*n)), {}, "");
+		auto& children = std::get<1>(key);
+		auto& data = std::get<2>(key);
+
+		bool keyed_on_identity = false;
+
+		// first, make the children canonical, and key on them, together with whatever else distinguishes this type of node.
+		if (auto op = std::dynamic_pointer_cast<NaryOperator>(n))
+		{
+			for (size_t ii = 0; ii < op->children_size(); ++ii)
+			{
+				op->SetChild(ii, Canonicalize(op->children()[ii]));
+				children.push_back(op->children()[ii].get());
+			}
+
+			if (auto sum = std::dynamic_pointer_cast<SumOperator>(n))
+				for (auto sign : sum->children_sign())
+					data.push_back(sign ? '+' : '-');
+			else if (auto mult = std::dynamic_pointer_cast<MultOperator>(n))
+				for (auto mult_or_div : mult->children_mult_or_div())
+					data.push_back(mult_or_div ? '*' : '/');
+		}
+		else if (auto op = std::dynamic_pointer_cast<UnaryOperator>(n))
+		{
+			op->SetChild(Canonicalize(op->first_child()));
+			children.push_back(op->first_child().get());
+
+			if (auto power = std::dynamic_pointer_cast<IntegerPowerOperator>(n))
+				data = std::to_string(power->exponent());
+		}
+		else if (auto op = std::dynamic_pointer_cast<PowerOperator>(n))
+		{
+			op->SetBase(Canonicalize(op->base()));
+			op->SetExponent(Canonicalize(op->exponent()));
+			children.push_back(op->base().get());
+			children.push_back(op->exponent().get());
+		}
+		else if (auto f = std::dynamic_pointer_cast<Function>(n))
+		{
+			f->SetRoot(Canonicalize(f->entry_node()));
+			keyed_on_identity = true;
+		}
+		else if (auto d = std::dynamic_pointer_cast<Differential>(n))
+			children.push_back(d->GetVariable().get());
+		else if (std::dynamic_pointer_cast<Variable>(n))
+			keyed_on_identity = true;
+		else
+		{
+			// the remaining leaves are numbers, keyed on their printed value.  a stream precision of 0 prints multiple precision numbers with all their digits.
+			std::stringstream ss;
+			ss.precision(0);
+			n->print(ss);
+			data = ss.str();
+		}
+
+
+		std::shared_ptr<Node> canonical = n;
+		if (keyed_on_identity)
+			++num_keyed_on_identity_;
+		else
+			canonical = by_structure_.insert(std::make_pair(key, n)).first->second;
+
+		// the node is held onto, even if not canonical, so that its address cannot be re-used by a different node while the factory remembers it.
+		seen_[n.get()] = std::make_pair(n, canonical);
+		return canonical;
+	}
+
+
+
+
+	size_t CountDistinctNodes(std::vector< std::shared_ptr<Node> > const& roots)
+	{
+		std::unordered_set<Node const*> seen;
+		std::vector< std::shared_ptr<Node> > to_visit(roots);
+
+		while (!to_visit.empty())
+		{
+			auto n = to_visit.back();
+			to_visit.pop_back();
+
+			if (!seen.insert(n.get()).second)
+				continue;
+
+			for (const auto& iter : Children(*n))
+				to_visit.push_back(iter);
+		}
+
+		return seen.size();
+	}
+
+} // namespace node
+} // namespace bertini
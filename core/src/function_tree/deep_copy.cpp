@@ -0,0 +1,127 @@
+//This file is part of Bertini 2.
+//
+//deep_copy.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//deep_copy.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with deep_copy.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2015, 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+#include "function_tree/deep_copy.hpp"
+
+#include <typeindex>
+
+
+namespace bertini {
+namespace node {
+
+	namespace {
+
+		/**
+		\brief Copy a single node, with its stored values.  Its children are those of the original.
+		*/
+		template<typename NodeT>
+		std::shared_ptr<Node> ShallowCopy(Node const& n)
+		{
+			return std::make_shared<NodeT>(dynamic_cast<NodeT const&>(n));
+		}
+
+		using ShallowCopier = std::shared_ptr<Node> (*)(Node const&);
+
+		const std::unordered_map<std::type_index, ShallowCopier> shallow_copiers = {
+			{typeid(Variable), &ShallowCopy<Variable>},
+			{typeid(Float), &ShallowCopy<Float>},
+			{typeid(Integer), &ShallowCopy<Integer>},
+			{typeid(Rational), &ShallowCopy<Rational>},
+			{typeid(special_number::Pi), &ShallowCopy<special_number::Pi>},
+			{typeid(special_number::E), &ShallowCopy<special_number::E>},
+			{typeid(Function), &ShallowCopy<Function>},
+			{typeid(Jacobian), &ShallowCopy<Jacobian>},
+			{typeid(SinOperator), &ShallowCopy<SinOperator>},
+			{typeid(ArcSinOperator), &ShallowCopy<ArcSinOperator>},
+			{typeid(CosOperator), &ShallowCopy<CosOperator>},
+			{typeid(ArcCosOperator), &ShallowCopy<ArcCosOperator>},
+			{typeid(TanOperator), &ShallowCopy<TanOperator>},
+			{typeid(ArcTanOperator), &ShallowCopy<ArcTanOperator>},
+			{typeid(SumOperator), &ShallowCopy<SumOperator>},
+			{typeid(NegateOperator), &ShallowCopy<NegateOperator>},
+			{typeid(MultOperator), &ShallowCopy<MultOperator>},
+			{typeid(PowerOperator), &ShallowCopy<PowerOperator>},
+			{typeid(IntegerPowerOperator), &ShallowCopy<IntegerPowerOperator>},
+			{typeid(SqrtOperator), &ShallowCopy<SqrtOperator>},
+			{typeid(ExpOperator), &ShallowCopy<ExpOperator>},
+			{typeid(LogOperator), &ShallowCopy<LogOperator>}
+		};
+
+	} // re: anonymous namespace
+
+
+
+
+	std::shared_ptr<Node> DeepCopier::Copy(std::shared_ptr<Node> const& n)
+	{
+		if (!n)
+			return nullptr;
+
+		auto found = copies_.find(n.get());
+		if (found!=copies_.end())
+			return found->second;
+
+		std::shared_ptr<Node> copy;
+
+		if (auto d = std::dynamic_pointer_cast<Differential>(n))
+		{
+			auto v = Copy(std::const_pointer_cast<Variable>(d->GetVariable()));
+			copy = std::make_shared<Differential>(v, v->name());
+		}
+		else
+		{
+			auto copier = shallow_copiers.find(std::type_index(typeid(*n)));
+			if (copier==shallow_copiers.end())
+				throw std::runtime_error("unable to deep copy node of unknown type " + std::string(typeid(*n).name()));
+
+			copy = copier->second(*n);
+
+			// the copy refers to the children of the original, so replace them with their copies
+			if (auto op = std::dynamic_pointer_cast<NaryOperator>(copy))
+			{
+				for (size_t ii = 0; ii < op->children_size(); ++ii)
+					op->SetChild(ii, Copy(op->children()[ii]));
+			}
+			else if (auto op = std::dynamic_pointer_cast<UnaryOperator>(copy))
+				op->SetChild(Copy(op->first_child()));
+			else if (auto op = std::dynamic_pointer_cast<PowerOperator>(copy))
+			{
+				op->SetBase(Copy(op->base()));
+				op->SetExponent(Copy(op->exponent()));
+			}
+			else if (auto f = std::dynamic_pointer_cast<Function>(copy))
+			{
+				f->SetRoot(Copy(f->entry_node()));
+				if (auto j = std::dynamic_pointer_cast<Jacobian>(copy))
+					j->current_diff_variable_ = nullptr;
+			}
+		}
+
+		copy->ResetSelf();
+		copies_[n.get()] = copy;
+		return copy;
+	}
+
+} // namespace node
+} // namespace bertini
@@ -0,0 +1,191 @@
+//This file is part of Bertini 2.
+//
+//dependencies.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//dependencies.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with dependencies.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2015, 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+#include "function_tree/dependencies.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+
+
+namespace bertini {
+namespace node {
+
+	std::vector< std::shared_ptr<Node> > Children(Node const& n)
+	{
+		if (auto op = dynamic_cast<NaryOperator const*>(&n))
+			return op->children();
+		if (auto op = dynamic_cast<UnaryOperator const*>(&n))
+			return {op->first_child()};
+		if (auto op = dynamic_cast<PowerOperator const*>(&n))
+			return {op->base(), op->exponent()};
+		if (auto f = dynamic_cast<Function const*>(&n))
+			return {f->entry_node()};
+		return {};
+	}
+
+
+	std::vector< std::shared_ptr<const Node> > DistinctNodes(std::vector< std::shared_ptr<Node> > const& roots)
+	{
+		std::unordered_set<Node const*> seen;
+		std::vector< std::shared_ptr<const Node> > nodes;
+		std::vector< std::shared_ptr<Node> > to_visit(roots);
+
+		while (!to_visit.empty())
+		{
+			auto n = to_visit.back();
+			to_visit.pop_back();
+
+			if (!seen.insert(n.get()).second)
+				continue;
+
+			nodes.push_back(n);
+			for (const auto& iter : Children(*n))
+				to_visit.push_back(iter);
+		}
+
+		return nodes;
+	}
+
+
+
+
+	namespace {
+
+		/**
+		\brief Compute, with memoization, the set of groups on which a node depends, as a vector of flags.  The last flag is for variables in no group.
+		*/
+		std::vector<bool> const& Dependencies(std::shared_ptr<Node> const& n,
+		                                      std::unordered_map<Variable const*, size_t> const& group_of_variable,
+		                                      size_t num_groups,
+		                                      std::unordered_map<Node const*, std::vector<bool> > & memo,
+		                                      std::vector< std::vector< std::shared_ptr<const Node> > > & dependent_nodes)
+		{
+			auto found = memo.find(n.get());
+			if (found!=memo.end())
+				return found->second;
+
+			std::vector<bool> depends(num_groups+1, false);
+
+			if (auto v = dynamic_cast<Variable const*>(n.get()))
+			{
+				auto group = group_of_variable.find(v);
+				depends[group==group_of_variable.end() ? num_groups : group->second] = true;
+			}
+			else
+				for (const auto& iter : Children(*n))
+				{
+					const auto& child_depends = Dependencies(iter, group_of_variable, num_groups, memo, dependent_nodes);
+					for (size_t ii = 0; ii <= num_groups; ++ii)
+						if (child_depends[ii])
+							depends[ii] = true;
+				}
+
+			for (size_t ii = 0; ii <= num_groups; ++ii)
+				if (depends[ii])
+					dependent_nodes[ii].push_back(n);
+
+			return memo[n.get()] = depends;
+		}
+
+	} // re: anonymous namespace
+
+
+
+
+	std::vector< std::vector< std::shared_ptr<const Node> > > DependentNodes(std::vector< std::shared_ptr<Node> > const& roots, std::vector<VariableGroup> const& groups)
+	{
+		std::unordered_map<Variable const*, size_t> group_of_variable;
+		for (size_t ii = 0; ii < groups.size(); ++ii)
+			for (const auto& iter : groups[ii])
+				group_of_variable[iter.get()] = ii;
+
+		std::unordered_map<Node const*, std::vector<bool> > memo;
+		std::vector< std::vector< std::shared_ptr<const Node> > > dependent_nodes(groups.size()+1);
+
+		for (const auto& iter : roots)
+			Dependencies(iter, group_of_variable, groups.size(), memo, dependent_nodes);
+
+		return dependent_nodes;
+	}
+
+
+
+
+	namespace {
+
+		/**
+		\brief Compute, with memoization, the sorted indices of the variables appearing beneath a node.
+		*/
+		std::vector<int> const& Occurring(std::shared_ptr<Node> const& n,
+		                                  std::unordered_map<Variable const*, int> const& index_of_variable,
+		                                  std::unordered_map<Node const*, std::vector<int> > & memo)
+		{
+			auto found = memo.find(n.get());
+			if (found!=memo.end())
+				return found->second;
+
+			std::vector<int> occurring;
+
+			if (auto v = dynamic_cast<Variable const*>(n.get()))
+			{
+				auto index = index_of_variable.find(v);
+				if (index!=index_of_variable.end())
+					occurring.push_back(index->second);
+			}
+			else
+				for (const auto& iter : Children(*n))
+				{
+					const auto& child_occurring = Occurring(iter, index_of_variable, memo);
+					std::vector<int> merged;
+					merged.reserve(occurring.size()+child_occurring.size());
+					std::set_union(occurring.begin(), occurring.end(), child_occurring.begin(), child_occurring.end(), std::back_inserter(merged));
+					occurring.swap(merged);
+				}
+
+			return memo[n.get()] = std::move(occurring);
+		}
+
+	} // re: anonymous namespace
+
+
+
+	std::vector< std::vector<int> > VariablesOccurring(std::vector< std::shared_ptr<Node> > const& roots, VariableGroup const& variables)
+	{
+		std::unordered_map<Variable const*, int> index_of_variable;
+		for (size_t ii = 0; ii < variables.size(); ++ii)
+			index_of_variable[variables[ii].get()] = static_cast<int>(ii);
+
+		std::unordered_map<Node const*, std::vector<int> > memo;
+		std::vector< std::vector<int> > occurring;
+		occurring.reserve(roots.size());
+		for (const auto& iter : roots)
+			occurring.push_back(Occurring(iter, index_of_variable, memo));
+
+		return occurring;
+	}
+
+} // namespace node
+} // namespace bertini
@@ -0,0 +1,243 @@
+//This file is part of Bertini 2.
+//
+//native_program.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//native_program.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with native_program.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+#include "bertini2/config.h"
+#include "function_tree/native_program.hpp"
+#include "function_tree/straight_line_program.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <dlfcn.h>
+
+#include <boost/filesystem.hpp>
+
+
+namespace bertini {
+
+	namespace {
+
+		using Operation = StraightLineProgram::Operation;
+
+		const char* const segment_names[] = {"bertini_native_functions", "bertini_native_jacobian", "bertini_native_time_derivatives"};
+
+		/**
+		\brief Write one instruction as a statement, in terms of the array `v`.
+		*/
+		void WriteStatement(std::ostream& out, StraightLineProgram::Instruction const& i)
+		{
+			out << "\tv[" << i.out << "] = ";
+			const auto a = "v[" + std::to_string(i.in1) + "]";
+			const auto b = "v[" + std::to_string(i.in2) + "]";
+
+			switch (i.op)
+			{
+				case Operation::Add:
+					out << a << " + " << b; break;
+				case Operation::Subtract:
+					out << a << " - " << b; break;
+				case Operation::Multiply:
+					out << a << " * " << b; break;
+				case Operation::Divide:
+					out << a << " / " << b; break;
+				case Operation::Negate:
+					out << "-" << a; break;
+				case Operation::IntegerPower:
+					out << "ipow(" << a << ", " << i.exponent << ")"; break;
+				case Operation::Power:
+					out << "std::pow(" << a << ", " << b << ")"; break;
+				case Operation::Sqrt:
+					out << "std::sqrt(" << a << ")"; break;
+				case Operation::Exp:
+					out << "std::exp(" << a << ")"; break;
+				case Operation::Log:
+					out << "std::log(" << a << ")"; break;
+				case Operation::Sin:
+					out << "std::sin(" << a << ")"; break;
+				case Operation::Cos:
+					out << "std::cos(" << a << ")"; break;
+				case Operation::Tan:
+					out << "std::tan(" << a << ")"; break;
+				case Operation::ArcSin:
+					out << "std::asin(" << a << ")"; break;
+				case Operation::ArcCos:
+					out << "std::acos(" << a << ")"; break;
+				case Operation::ArcTan:
+					out << "std::atan(" << a << ")"; break;
+			}
+			out << ";\n";
+		}
+
+	} // re: anonymous namespace
+
+
+
+	NativeCompiler::NativeCompiler() :
+		NativeCompiler((boost::filesystem::temp_directory_path() / "bertini2_native").string(), BERTINI_NATIVE_CXX)
+	{}
+
+
+	NativeCompiler::NativeCompiler(std::string const& cache_directory, std::string const& compiler) :
+		cache_directory_(cache_directory), compiler_(compiler)
+	{}
+
+
+
+	std::string NativeCompiler::GenerateBody(StraightLineProgram const& slp)
+	{
+		std::stringstream out;
+		out << "// memory locations: " << slp.NumMemoryLocations() << "\n"
+		    << "#include <complex>\n\n"
+		    << "namespace {\n"
+		    << "\tusing C = std::complex<double>;\n\n"
+		    << "\t// by repeated squaring\n"
+		    << "\tinline C ipow(C x, int n)\n"
+		    << "\t{\n"
+		    << "\t\tunsigned m = n < 0 ? -static_cast<unsigned>(n) : static_cast<unsigned>(n);\n"
+		    << "\t\tC result(1);\n"
+		    << "\t\twhile (m)\n"
+		    << "\t\t{\n"
+		    << "\t\t\tif (m & 1u)\n"
+		    << "\t\t\t\tresult *= x;\n"
+		    << "\t\t\tm >>= 1;\n"
+		    << "\t\t\tif (m)\n"
+		    << "\t\t\t\tx *= x;\n"
+		    << "\t\t}\n"
+		    << "\t\treturn n < 0 ? C(1)/result : result;\n"
+		    << "\t}\n"
+		    << "}\n\n"
+		    << "extern \"C\" {\n\n";
+
+		const size_t bounds[] = {0, slp.function_segment_end_, slp.jacobian_segment_end_, slp.time_derivative_segment_end_};
+		for (unsigned segment = 0; segment < 3; ++segment)
+		{
+			out << "void " << segment_names[segment] << "(C* v)\n{\n";
+			for (auto ii = bounds[segment]; ii < bounds[segment+1]; ++ii)
+				WriteStatement(out, slp.instructions_[ii]);
+			out << "}\n\n";
+		}
+		out << "} // re: extern \"C\"\n";
+
+		return out.str();
+	}
+
+
+	std::string NativeCompiler::HashOf(std::string const& body)
+	{
+		// 64-bit FNV-1a.  it needs to be the same from run to run, which std::hash need not be.
+		std::uint64_t h = 14695981039346656037ull;
+		for (unsigned char c : body)
+		{
+			h ^= c;
+			h *= 1099511628211ull;
+		}
+
+		std::stringstream out;
+		out << std::hex << std::setw(16) << std::setfill('0') << h;
+		return out.str();
+	}
+
+
+	std::string NativeCompiler::GenerateSource(StraightLineProgram const& slp)
+	{
+		const auto body = GenerateBody(slp);
+		return "extern \"C\" const char bertini_native_hash[] = \"" + HashOf(body) + "\";\n" + body;
+	}
+
+
+	std::string NativeCompiler::StructuralHash(StraightLineProgram const& slp)
+	{
+		return HashOf(GenerateBody(slp));
+	}
+
+
+	std::string NativeCompiler::CachedLibraryPath(StraightLineProgram const& slp) const
+	{
+		return (boost::filesystem::path(cache_directory_) / ("slp_" + StructuralHash(slp) + ".so")).string();
+	}
+
+
+
+	std::shared_ptr<const NativeProgram> NativeCompiler::Compile(StraightLineProgram const& slp) const
+	{
+		namespace fs = boost::filesystem;
+
+		const auto body = GenerateBody(slp);
+		const auto hash = HashOf(body);
+		const fs::path directory(cache_directory_);
+		const fs::path library = directory / ("slp_" + hash + ".so");
+
+		if (!fs::exists(library))
+		{
+			fs::create_directories(directory);
+
+			// written and compiled under a unique name, and then renamed into place, so that concurrent runs compiling the same program do not see each other's partial files
+			const auto unique = fs::unique_path("slp_" + hash + "_%%%%%%%%");
+			const fs::path source = directory / (unique.string() + ".cpp");
+			const fs::path object = directory / (unique.string() + ".so");
+			const fs::path log = directory / ("slp_" + hash + ".log");
+			{
+				std::ofstream file(source.string());
+				file << GenerateSource(slp);
+				if (!file)
+					throw std::runtime_error("unable to write generated source to " + source.string());
+			}
+
+			const std::string command = compiler_ + " -O2 -fPIC -shared -o \"" + object.string() + "\" \"" + source.string() + "\" > \"" + log.string() + "\" 2>&1";
+			const int status = std::system(command.c_str());
+			if (status!=0 || !fs::exists(object))
+				throw std::runtime_error("compilation of generated straight-line program failed.  see " + log.string() + " and " + source.string());
+
+			fs::rename(object, library);
+			fs::rename(source, directory / ("slp_" + hash + ".cpp"));
+		}
+
+		void* handle = dlopen(library.string().c_str(), RTLD_NOW | RTLD_LOCAL);
+		if (!handle)
+			throw std::runtime_error("unable to load compiled straight-line program " + library.string() + ": " + dlerror());
+
+		auto result = std::make_shared<NativeProgram>();
+		result->handle_ = std::shared_ptr<void>(handle, [](void* h){ dlclose(h); });
+		result->hash_ = hash;
+		result->library_path_ = library.string();
+
+		// guards against a cached object left by some other version of the generator, under the same name
+		auto loaded_hash = static_cast<const char*>(dlsym(handle, "bertini_native_hash"));
+		if (!loaded_hash || hash!=loaded_hash)
+			throw std::runtime_error("compiled straight-line program " + library.string() + " does not match its hash");
+
+		for (unsigned segment = 0; segment < 3; ++segment)
+		{
+			result->segments_[segment] = reinterpret_cast<NativeProgram::Segment>(dlsym(handle, segment_names[segment]));
+			if (!result->segments_[segment])
+				throw std::runtime_error(std::string("compiled straight-line program is missing ") + segment_names[segment]);
+		}
+
+		return result;
+	}
+
+} // namespace bertini
@@ -54,3 +54,4 @@ BOOST_CLASS_EXPORT(bertini::node::PowerOperator)
 BOOST_CLASS_EXPORT(bertini::node::IntegerPowerOperator)
 BOOST_CLASS_EXPORT(bertini::node::SqrtOperator)
 BOOST_CLASS_EXPORT(bertini::node::ExpOperator)
+BOOST_CLASS_EXPORT(bertini::node::LogOperator)
@@ -851,6 +851,16 @@ namespace bertini{
 				return exponent_*base_deg;
 			
 		}
+
+
+		int IntegerPowerOperator::Degree(VariableGroup const& vars) const
+		{
+			auto base_deg = child_->Degree(vars);
+			if (base_deg<0)
+				return base_deg;
+			else
+				return exponent_*base_deg;
+		}
 		
 
 		
@@ -0,0 +1,382 @@
+//This file is part of Bertini 2.
+//
+//sparse_polynomial.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//sparse_polynomial.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with sparse_polynomial.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+#include "function_tree/sparse_polynomial.hpp"
+#include "function_tree/dependencies.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace bertini {
+
+	void SparsePolynomialSystem::precision(unsigned new_precision) const
+	{
+		auto& memory = std::get<Memory<mpfr> >(memory_);
+
+		// the coefficients at the present precision are kept, and those at the new one taken up if kept before
+		if (have_mpfr_coefficients_)
+		{
+			if (new_precision==precision_)
+			{
+				memory.Invalidate();
+				return;
+			}
+			coefficients_at_precision_[precision_] = std::move(memory.coefficients);
+		}
+
+		auto previous_precision = DefaultPrecision();
+		DefaultPrecision(new_precision);
+
+		SetUpMemory<mpfr>();
+
+		auto kept = coefficients_at_precision_.find(new_precision);
+		if (kept!=coefficients_at_precision_.end())
+		{
+			memory.coefficients = std::move(kept->second);
+			coefficients_at_precision_.erase(kept);
+		}
+		else
+		{
+			memory.coefficients.resize(coefficients_.size());
+			for (size_t ii = 0; ii < coefficients_.size(); ++ii)
+			{
+				coefficients_[ii]->precision(new_precision);
+				coefficients_[ii]->Reset();
+				coefficients_[ii]->EvalInPlace<mpfr>(memory.coefficients[ii]);
+				memory.coefficients[ii].precision(new_precision);
+			}
+		}
+
+		DefaultPrecision(previous_precision);
+
+		precision_ = new_precision;
+		have_mpfr_coefficients_ = true;
+	}
+
+
+
+
+	namespace {
+
+		/**
+		\brief Thrown, and caught, within expansion, when a function cannot be expanded.
+		*/
+		struct NotExpandable
+		{};
+
+	} // re: anonymous namespace
+
+
+	bool PolynomialExpander::Expand(std::vector< std::shared_ptr<node::Function> > const& functions,
+	                                VariableGroup const& variables,
+	                                std::shared_ptr<node::Variable> const& path_variable,
+	                                SparsePolynomialSystem & result)
+	{
+		one_ = std::make_shared<node::Integer>(1);
+		input_index_.clear();
+		expanded_.clear();
+		is_constant_.clear();
+
+		for (size_t ii = 0; ii < variables.size(); ++ii)
+			input_index_[variables[ii].get()] = ii;
+		if (path_variable)
+			input_index_[path_variable.get()] = variables.size();
+		const size_t num_inputs = variables.size() + (path_variable ? 1 : 0);
+
+		// references to the values of an unordered_map survive insertion, so the expansions may be held while expanding others
+		std::vector<Polynomial const*> expansions;
+		try{
+			for (const auto& iter : functions)
+				expansions.push_back(&ExpandNode(iter));
+		}
+		catch (NotExpandable const&)
+		{
+			expanded_.clear();
+			is_constant_.clear();
+			return false;
+		}
+
+
+		SparsePolynomialSystem polynomials;
+		polynomials.num_variables_ = variables.size();
+		for (const auto& iter : variables)
+			polynomials.inputs_.push_back(iter);
+		if (path_variable)
+			polynomials.inputs_.push_back(path_variable);
+
+		// each input gets at least its zeroth and first powers, so that tabulation need not check
+		std::vector<unsigned> max_exponents(num_inputs, 1);
+		for (const auto& p : expansions)
+			for (const auto& term : *p)
+				for (const auto& factor : term.first)
+					max_exponents[factor.first] = std::max(max_exponents[factor.first], factor.second);
+
+		polynomials.power_offsets_.push_back(0);
+		for (const auto& iter : max_exponents)
+			polynomials.power_offsets_.push_back(polynomials.power_offsets_.back() + iter + 1);
+
+		for (const auto& p : expansions)
+		{
+			// the columns of the nonzero entries of the jacobian in this row, which are the variables appearing in some term
+			std::vector<unsigned> columns;
+			for (const auto& term : *p)
+				for (const auto& factor : term.first)
+					if (factor.first < variables.size())
+						columns.push_back(factor.first);
+			std::sort(columns.begin(), columns.end());
+			columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+			const size_t row_begin = polynomials.jacobian_columns_.size();
+			polynomials.jacobian_columns_.insert(polynomials.jacobian_columns_.end(), columns.begin(), columns.end());
+			polynomials.jacobian_row_ends_.push_back(polynomials.jacobian_columns_.size());
+
+			for (const auto& term : *p)
+			{
+				for (const auto& factor : term.first)
+				{
+					const auto column = std::lower_bound(columns.begin(), columns.end(), factor.first);
+					polynomials.factor_jacobian_locations_.push_back(row_begin + (column - columns.begin()));
+					polynomials.factor_inputs_.push_back(factor.first);
+					polynomials.factor_exponents_.push_back(factor.second);
+					polynomials.factor_power_locations_.push_back(polynomials.power_offsets_[factor.first] + factor.second);
+				}
+				polynomials.max_factors_per_term_ = std::max(polynomials.max_factors_per_term_, term.first.size());
+				polynomials.term_factor_ends_.push_back(polynomials.factor_inputs_.size());
+				polynomials.coefficients_.push_back(term.second);
+			}
+			polynomials.function_term_ends_.push_back(polynomials.term_factor_ends_.size());
+		}
+
+		// the double coefficients never change, so are computed once and for all here.  the multiple precision ones are done by changing precision.
+		polynomials.SetUpMemory<dbl>();
+		auto& coefficients_d = std::get<SparsePolynomialSystem::Memory<dbl> >(polynomials.memory_).coefficients;
+		for (const auto& iter : polynomials.coefficients_)
+			coefficients_d.push_back(iter->Eval<dbl>());
+
+		polynomials.precision(DefaultPrecision());
+
+		expanded_.clear();
+		is_constant_.clear();
+
+		result = std::move(polynomials);
+		return true;
+	}
+
+
+
+	bool PolynomialExpander::IsConstant(std::shared_ptr<node::Node> const& n)
+	{
+		auto found = is_constant_.find(n.get());
+		if (found!=is_constant_.end())
+			return found->second;
+
+		bool constant = !dynamic_cast<node::Variable const*>(n.get());
+		if (constant)
+			for (const auto& iter : node::Children(*n))
+				if (!IsConstant(iter))
+				{
+					constant = false;
+					break;
+				}
+
+		return is_constant_[n.get()] = constant;
+	}
+
+
+
+	PolynomialExpander::Polynomial const& PolynomialExpander::ExpandNode(std::shared_ptr<node::Node> const& n)
+	{
+		auto found = expanded_.find(n.get());
+		if (found!=expanded_.end())
+			return found->second;
+
+		Polynomial result;
+
+		if (IsConstant(n))
+			result[Monomial()] = n;
+		else if (auto v = dynamic_cast<node::Variable const*>(n.get()))
+		{
+			auto index = input_index_.find(v);
+			if (index==input_index_.end())
+				throw NotExpandable();
+			result[Monomial(1, std::make_pair(index->second, 1u))] = one_;
+		}
+		else if (auto f = dynamic_cast<node::Function const*>(n.get()))
+			result = ExpandNode(f->entry_node());
+		else if (auto s = dynamic_cast<node::SumOperator const*>(n.get()))
+		{
+			std::vector< std::pair<Polynomial const*, bool> > summands;
+			for (size_t ii = 0; ii < s->children().size(); ++ii)
+				summands.emplace_back(&ExpandNode(s->children()[ii]), s->children_sign()[ii]);
+			result = Sum(summands);
+		}
+		else if (auto m = dynamic_cast<node::MultOperator const*>(n.get()))
+		{
+			result[Monomial()] = one_;
+			for (size_t ii = 0; ii < m->children().size(); ++ii)
+			{
+				const auto& child = m->children()[ii];
+				if (m->children_mult_or_div()[ii])
+					result = Product(result, ExpandNode(child));
+				else
+				{
+					if (!IsConstant(child))
+						throw NotExpandable();
+
+					Polynomial reciprocal;
+					reciprocal[Monomial()] = std::make_shared<node::MultOperator>(one_, true, child, false);
+					result = Product(result, reciprocal);
+				}
+			}
+		}
+		else if (auto neg = dynamic_cast<node::NegateOperator const*>(n.get()))
+			result = Sum({{&ExpandNode(neg->first_child()), false}});
+		else if (auto ip = dynamic_cast<node::IntegerPowerOperator const*>(n.get()))
+		{
+			if (ip->exponent() < 0)
+				throw NotExpandable();
+			result = Power(ExpandNode(ip->first_child()), ip->exponent());
+		}
+		else if (auto pw = dynamic_cast<node::PowerOperator const*>(n.get()))
+		{
+			if (!IsConstant(pw->exponent()))
+				throw NotExpandable();
+
+			// only exponents which are small nonnegative integers can be expanded
+			const auto e = pw->exponent()->Eval<dbl>();
+			if (e.imag()!=0 || e.real()<0 || e.real()>max_terms_ || e.real()!=std::floor(e.real()))
+				throw NotExpandable();
+			result = Power(ExpandNode(pw->base()), static_cast<unsigned>(e.real()));
+		}
+		else
+			throw NotExpandable();
+
+		return expanded_[n.get()] = std::move(result);
+	}
+
+
+
+	PolynomialExpander::Polynomial PolynomialExpander::Sum(std::vector< std::pair<Polynomial const*, bool> > const& summands) const
+	{
+		std::map< Monomial, std::vector< std::pair<std::shared_ptr<node::Node>, bool> > > collected;
+		for (const auto& s : summands)
+			for (const auto& term : *s.first)
+				collected[term.first].emplace_back(term.second, s.second);
+
+		if (collected.size() > max_terms_)
+			throw NotExpandable();
+
+		// like terms are gathered into one sum, rather than a chain of them, so that the coefficients stay shallow
+		Polynomial result;
+		for (const auto& iter : collected)
+		{
+			const auto& parts = iter.second;
+			if (parts.size()==1 && parts[0].second)
+				result[iter.first] = parts[0].first;
+			else
+			{
+				auto sum = std::make_shared<node::SumOperator>(parts[0].first, parts[0].second);
+				for (size_t ii = 1; ii < parts.size(); ++ii)
+					sum->AddChild(parts[ii].first, parts[ii].second);
+				result[iter.first] = sum;
+			}
+		}
+		return result;
+	}
+
+
+
+	PolynomialExpander::Polynomial PolynomialExpander::Product(Polynomial const& a, Polynomial const& b) const
+	{
+		if (a.size()*b.size() > 10*max_terms_)
+			throw NotExpandable();
+
+		std::map< Monomial, std::vector< std::shared_ptr<node::Node> > > collected;
+		for (const auto& x : a)
+			for (const auto& y : b)
+			{
+				// merge the factors, which are sorted by input
+				Monomial m;
+				auto xx = x.first.begin(), yy = y.first.begin();
+				while (xx!=x.first.end() || yy!=y.first.end())
+				{
+					if (yy==y.first.end() || (xx!=x.first.end() && xx->first < yy->first))
+						m.push_back(*xx++);
+					else if (xx==x.first.end() || yy->first < xx->first)
+						m.push_back(*yy++);
+					else
+					{
+						m.emplace_back(xx->first, xx->second + yy->second);
+						++xx; ++yy;
+					}
+				}
+
+				if (x.second==one_)
+					collected[m].push_back(y.second);
+				else if (y.second==one_)
+					collected[m].push_back(x.second);
+				else
+					collected[m].push_back(std::make_shared<node::MultOperator>(x.second, y.second));
+			}
+
+		if (collected.size() > max_terms_)
+			throw NotExpandable();
+
+		Polynomial result;
+		for (const auto& iter : collected)
+		{
+			const auto& parts = iter.second;
+			if (parts.size()==1)
+				result[iter.first] = parts[0];
+			else
+			{
+				auto sum = std::make_shared<node::SumOperator>(parts[0], true);
+				for (size_t ii = 1; ii < parts.size(); ++ii)
+					sum->AddChild(parts[ii], true);
+				result[iter.first] = sum;
+			}
+		}
+		return result;
+	}
+
+
+
+	PolynomialExpander::Polynomial PolynomialExpander::Power(Polynomial const& a, unsigned exponent) const
+	{
+		Polynomial result;
+		result[Monomial()] = one_;
+
+		Polynomial square = a;
+		while (exponent)
+		{
+			if (exponent & 1u)
+				result = Product(result, square);
+			exponent >>= 1;
+			if (exponent)
+				square = Product(square, square);
+		}
+		return result;
+	}
+
+} // re: namespace bertini
@@ -0,0 +1,511 @@
+//This file is part of Bertini 2.
+//
+//straight_line_program.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//straight_line_program.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with straight_line_program.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2015, 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+
+#include "function_tree/straight_line_program.hpp"
+
+
+namespace bertini {
+
+	constexpr size_t StraightLineProgram::ZeroLocation;
+	constexpr size_t StraightLineProgram::OneLocation;
+
+
+	void StraightLineProgram::precision(unsigned new_precision) const
+	{
+		auto& memory = std::get<Memory<mpfr> >(memory_);
+
+		// the memory at the present precision is kept, and that at the new one taken up if kept before, so that going back and forth between precisions does not re-compute the constants every time.
+		if (have_mpfr_constants_)
+		{
+			if (new_precision==precision_)
+			{
+				memory.Invalidate();
+				return;
+			}
+
+			auto kept = memory_at_precision_.find(new_precision);
+			if (kept!=memory_at_precision_.end())
+			{
+				std::swap(memory, kept->second);
+				memory_at_precision_[precision_] = std::move(kept->second);
+				memory_at_precision_.erase(kept);
+				memory.Invalidate();
+				precision_ = new_precision;
+				return;
+			}
+
+			memory_at_precision_[precision_] = memory;
+		}
+
+		for (auto& iter : memory.values)
+			iter.precision(new_precision);
+
+		// the constants are re-computed from their nodes, so that they are correct to the new precision, rather than padded.
+		auto previous_precision = DefaultPrecision();
+		DefaultPrecision(new_precision);
+		for (const auto& iter : constants_)
+		{
+			iter.second->precision(new_precision);
+			iter.second->Reset();
+			iter.second->EvalInPlace<mpfr>(memory.values[iter.first]);
+			memory.values[iter.first].precision(new_precision);
+		}
+		DefaultPrecision(previous_precision);
+
+		memory.values[ZeroLocation] = mpfr(0);
+		memory.values[OneLocation] = mpfr(1);
+		memory.values[ZeroLocation].precision(new_precision);
+		memory.values[OneLocation].precision(new_precision);
+
+		for (auto& iter : memory.tangents)
+			iter.precision(new_precision);
+		for (auto& iter : memory.adjoints)
+			iter.precision(new_precision);
+		for (auto& iter : memory.gradients)
+			iter.precision(new_precision);
+
+		memory.Invalidate();
+		precision_ = new_precision;
+		have_mpfr_constants_ = true;
+	}
+
+
+
+
+	StraightLineProgram SLPCompiler::Compile(std::vector< std::shared_ptr<node::Function> > const& functions,
+	                                         VariableGroup const& variables,
+	                                         std::shared_ptr<node::Variable> const& path_variable,
+	                                         std::vector< std::shared_ptr<node::Jacobian> > const& jacobians)
+	{
+		if (!jacobians.empty() && jacobians.size()!=functions.size())
+			throw std::runtime_error("compiling straight line program, but number of jacobians (" + std::to_string(jacobians.size()) + ") doesn't match number of functions (" + std::to_string(functions.size()) + ")");
+
+		slp_ = StraightLineProgram();
+		compiled_nodes_.clear();
+		compiled_differential_nodes_.clear();
+		input_locations_.clear();
+		instruction_locations_.clear();
+		diff_variable_ = nullptr;
+		depends_on_differential_ = false;
+		have_result_ = false;
+
+		for (const auto& iter : variables)
+			slp_.variable_locations_.push_back(AddInput(iter));
+
+		if (path_variable)
+		{
+			AddInput(path_variable);
+			slp_.have_path_variable_ = true;
+		}
+
+		for (const auto& iter : functions)
+			slp_.function_locations_.push_back(CompileNode(iter));
+		slp_.function_segment_end_ = slp_.instructions_.size();
+
+		// locations are handed out in order, so the instructions are sorted by their outputs, and the reverse sweep for a function starts just after the instruction writing it.
+		for (const auto& iter : slp_.function_locations_)
+		{
+			auto end = std::upper_bound(slp_.instructions_.begin(), slp_.instructions_.end(), iter,
+			                            [](size_t location, StraightLineProgram::Instruction const& instruction){return location < instruction.out;});
+			slp_.function_instruction_ends_.push_back(end - slp_.instructions_.begin());
+			slp_.reverse_sweep_length_ += slp_.function_instruction_ends_.back();
+		}
+
+
+		if (!jacobians.empty())
+		{
+			// each jacobian tree is compiled once per variable.  the differential-dependent parts must be recompiled each time, but the rest is found in compiled_nodes_.
+			slp_.jacobian_locations_.resize(functions.size()*variables.size());
+			for (size_t jj = 0; jj < variables.size(); ++jj)
+			{
+				diff_variable_ = variables[jj];
+				compiled_differential_nodes_.clear();
+				for (size_t ii = 0; ii < jacobians.size(); ++ii)
+					slp_.jacobian_locations_[ii*variables.size()+jj] = CompileNode(jacobians[ii]);
+			}
+			slp_.have_jacobian_ = true;
+		}
+		slp_.jacobian_segment_end_ = slp_.instructions_.size();
+
+
+		if (!jacobians.empty() && path_variable)
+		{
+			diff_variable_ = path_variable;
+			compiled_differential_nodes_.clear();
+			for (const auto& iter : jacobians)
+				slp_.time_derivative_locations_.push_back(CompileNode(iter));
+			slp_.have_time_derivative_ = true;
+		}
+		slp_.time_derivative_segment_end_ = slp_.instructions_.size();
+
+		diff_variable_ = nullptr;
+		current_node_ = nullptr;
+
+
+		// set up the memory.  the double constants never change, so are computed once and for all here.  the multiple precision ones are done by changing precision.
+		auto& memory_d = std::get<StraightLineProgram::Memory<dbl> >(slp_.memory_).values;
+		memory_d.resize(slp_.num_locations_);
+		memory_d[StraightLineProgram::ZeroLocation] = dbl(0);
+		memory_d[StraightLineProgram::OneLocation] = dbl(1);
+		for (const auto& iter : slp_.constants_)
+			memory_d[iter.first] = iter.second->Eval<dbl>();
+
+		auto& memory_mp = std::get<StraightLineProgram::Memory<mpfr> >(slp_.memory_).values;
+		memory_mp.resize(slp_.num_locations_);
+
+		// the double-double constants are rounded from the multiple precision ones, computed for the purpose with at least as many digits
+		slp_.precision(std::max(DefaultPrecision(), DoubleDoublePrecision()));
+		auto& memory_dd = std::get<StraightLineProgram::Memory<dd_complex> >(slp_.memory_).values;
+		memory_dd.resize(slp_.num_locations_);
+		memory_dd[StraightLineProgram::ZeroLocation] = dd_complex(0);
+		memory_dd[StraightLineProgram::OneLocation] = dd_complex(1);
+		for (const auto& iter : slp_.constants_)
+			memory_dd[iter.first] = ToDoubleDouble(memory_mp[iter.first]);
+
+		slp_.precision(DefaultPrecision());
+
+		return slp_;
+	}
+
+
+
+
+	size_t SLPCompiler::CompileNode(std::shared_ptr<node::Node> const& n)
+	{
+		auto found = compiled_nodes_.find(n.get());
+		if (found!=compiled_nodes_.end())
+			return found->second;
+
+		if (diff_variable_)
+		{
+			found = compiled_differential_nodes_.find(n.get());
+			if (found!=compiled_differential_nodes_.end())
+			{
+				depends_on_differential_ = true;
+				return found->second;
+			}
+		}
+
+		// save the state of the parent, since visiting children overwrites it
+		auto parent_node = current_node_;
+		bool parent_depends_on_differential = depends_on_differential_;
+
+		current_node_ = n;
+		depends_on_differential_ = false;
+		have_result_ = false;
+
+		n->Accept(*this);
+
+		if (!have_result_)
+			throw std::runtime_error("unable to compile node of type " + boost::typeindex::type_id_runtime(*n).pretty_name() + " into straight line program");
+
+		auto location = result_;
+		if (depends_on_differential_)
+			compiled_differential_nodes_[n.get()] = location;
+		else
+			compiled_nodes_[n.get()] = location;
+
+		current_node_ = parent_node;
+		depends_on_differential_ = parent_depends_on_differential || depends_on_differential_;
+		return location;
+	}
+
+
+
+
+	size_t SLPCompiler::AddInstruction(Operation op, size_t in1, size_t in2, int exponent)
+	{
+		constexpr auto zero = StraightLineProgram::ZeroLocation;
+		constexpr auto one = StraightLineProgram::OneLocation;
+
+		// fold operations on the constants zero and one.  these arise in great number from the differentials in jacobian trees.
+		switch (op)
+		{
+			case Operation::Add:
+				if (in1==zero) return in2;
+				if (in2==zero) return in1;
+				if (in2 < in1) std::swap(in1,in2);
+				break;
+			case Operation::Subtract:
+				if (in2==zero) return in1;
+				if (in1==zero) return AddInstruction(Operation::Negate, in2);
+				break;
+			case Operation::Multiply:
+				if (in1==zero || in2==zero) return zero;
+				if (in1==one) return in2;
+				if (in2==one) return in1;
+				if (in2 < in1) std::swap(in1,in2);
+				break;
+			case Operation::Divide:
+				if (in1==zero) return zero;
+				if (in2==one) return in1;
+				break;
+			case Operation::Negate:
+				if (in1==zero) return zero;
+				break;
+			case Operation::IntegerPower:
+				if (exponent==0 || in1==one) return one;
+				if (exponent==1) return in1;
+				if (in1==zero && exponent>0) return zero;
+				break;
+			default:
+				break;
+		}
+
+		auto key = std::make_tuple(op, in1, in2, exponent);
+		auto found = instruction_locations_.find(key);
+		if (found!=instruction_locations_.end())
+			return found->second;
+
+		auto out = slp_.num_locations_++;
+		slp_.instructions_.push_back(StraightLineProgram::Instruction{op, out, in1, in2, exponent});
+		instruction_locations_[key] = out;
+		return out;
+	}
+
+
+
+
+	void SLPCompiler::AddConstant()
+	{
+		result_ = slp_.num_locations_++;
+		slp_.constants_.push_back(std::make_pair(result_, std::shared_ptr<const node::Node>(current_node_)));
+		have_result_ = true;
+	}
+
+
+	size_t SLPCompiler::AddInput(std::shared_ptr<const node::Variable> const& v)
+	{
+		auto location = slp_.num_locations_++;
+		slp_.inputs_.push_back(std::make_pair(location, v));
+		input_locations_[v.get()] = location;
+		return location;
+	}
+
+
+	void SLPCompiler::UnaryOperation(node::UnaryOperator const& n, Operation op)
+	{
+		auto child = CompileNode(n.first_child());
+		result_ = AddInstruction(op, child);
+		have_result_ = true;
+	}
+
+
+
+
+	////////////////
+	//
+	//  the leaves
+	//
+	////////////////
+
+	void SLPCompiler::Visit(node::Variable const& n)
+	{
+		auto found = input_locations_.find(&n);
+		if (found!=input_locations_.end())
+			result_ = found->second;
+		else // a variable not among the system's variables, such as an implicit parameter
+			result_ = AddInput(n.shared_from_this());
+		have_result_ = true;
+	}
+
+	void SLPCompiler::Visit(node::Differential const& n)
+	{
+		if (diff_variable_ && n.GetVariable()==diff_variable_)
+			result_ = StraightLineProgram::OneLocation;
+		else
+			result_ = StraightLineProgram::ZeroLocation;
+
+		depends_on_differential_ = true;
+		have_result_ = true;
+	}
+
+	void SLPCompiler::Visit(node::Integer const& n)
+	{
+		// integers zero and one are exact in every precision, so can be folded.
+		auto val = n.Eval<dbl>();
+		if (val==dbl(0))
+		{
+			result_ = StraightLineProgram::ZeroLocation;
+			have_result_ = true;
+		}
+		else if (val==dbl(1))
+		{
+			result_ = StraightLineProgram::OneLocation;
+			have_result_ = true;
+		}
+		else
+			AddConstant();
+	}
+
+	void SLPCompiler::Visit(node::Float const& n)
+	{
+		AddConstant();
+	}
+
+	void SLPCompiler::Visit(node::Rational const& n)
+	{
+		AddConstant();
+	}
+
+	void SLPCompiler::Visit(node::special_number::Pi const& n)
+	{
+		AddConstant();
+	}
+
+	void SLPCompiler::Visit(node::special_number::E const& n)
+	{
+		AddConstant();
+	}
+
+
+
+
+	////////////////
+	//
+	//  the roots
+	//
+	////////////////
+
+	void SLPCompiler::Visit(node::Function const& n)
+	{
+		result_ = CompileNode(n.entry_node());
+		have_result_ = true;
+	}
+
+	void SLPCompiler::Visit(node::Jacobian const& n)
+	{
+		result_ = CompileNode(n.entry_node());
+		have_result_ = true;
+	}
+
+
+
+
+	////////////////
+	//
+	//  the operators
+	//
+	////////////////
+
+	void SLPCompiler::Visit(node::SumOperator const& n)
+	{
+		const auto& children = n.children();
+		const auto& signs = n.children_sign();
+
+		// the tree computes 0 + t_1 + t_2 ..., so the order of summation is preserved here.
+		size_t sum = StraightLineProgram::ZeroLocation;
+		for (size_t ii = 0; ii < children.size(); ++ii)
+		{
+			auto term = CompileNode(children[ii]);
+			sum = AddInstruction(signs[ii] ? Operation::Add : Operation::Subtract, sum, term);
+		}
+
+		result_ = sum;
+		have_result_ = true;
+	}
+
+	void SLPCompiler::Visit(node::MultOperator const& n)
+	{
+		const auto& children = n.children();
+		const auto& mult_or_div = n.children_mult_or_div();
+
+		size_t product = StraightLineProgram::OneLocation;
+		for (size_t ii = 0; ii < children.size(); ++ii)
+		{
+			auto factor = CompileNode(children[ii]);
+			product = AddInstruction(mult_or_div[ii] ? Operation::Multiply : Operation::Divide, product, factor);
+		}
+
+		result_ = product;
+		have_result_ = true;
+	}
+
+	void SLPCompiler::Visit(node::NegateOperator const& n)
+	{
+		UnaryOperation(n, Operation::Negate);
+	}
+
+	void SLPCompiler::Visit(node::PowerOperator const& n)
+	{
+		auto base = CompileNode(n.base());
+		auto exponent = CompileNode(n.exponent());
+		result_ = AddInstruction(Operation::Power, base, exponent);
+		have_result_ = true;
+	}
+
+	void SLPCompiler::Visit(node::IntegerPowerOperator const& n)
+	{
+		auto base = CompileNode(n.first_child());
+		result_ = AddInstruction(Operation::IntegerPower, base, 0, n.exponent());
+		have_result_ = true;
+	}
+
+	void SLPCompiler::Visit(node::SqrtOperator const& n)
+	{
+		UnaryOperation(n, Operation::Sqrt);
+	}
+
+	void SLPCompiler::Visit(node::ExpOperator const& n)
+	{
+		UnaryOperation(n, Operation::Exp);
+	}
+
+	void SLPCompiler::Visit(node::LogOperator const& n)
+	{
+		UnaryOperation(n, Operation::Log);
+	}
+
+	void SLPCompiler::Visit(node::SinOperator const& n)
+	{
+		UnaryOperation(n, Operation::Sin);
+	}
+
+	void SLPCompiler::Visit(node::ArcSinOperator const& n)
+	{
+		UnaryOperation(n, Operation::ArcSin);
+	}
+
+	void SLPCompiler::Visit(node::CosOperator const& n)
+	{
+		UnaryOperation(n, Operation::Cos);
+	}
+
+	void SLPCompiler::Visit(node::ArcCosOperator const& n)
+	{
+		UnaryOperation(n, Operation::ArcCos);
+	}
+
+	void SLPCompiler::Visit(node::TanOperator const& n)
+	{
+		UnaryOperation(n, Operation::Tan);
+	}
+
+	void SLPCompiler::Visit(node::ArcTanOperator const& n)
+	{
+		UnaryOperation(n, Operation::ArcTan);
+	}
+
+} // namespace bertini
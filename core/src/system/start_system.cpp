@@ -24,8 +24,17 @@
 
 #include "start_system.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+
 
 BOOST_CLASS_EXPORT(bertini::start_system::TotalDegree);
+BOOST_CLASS_EXPORT(bertini::start_system::MHomogeneous);
+BOOST_CLASS_EXPORT(bertini::start_system::LinearProduct);
+BOOST_CLASS_EXPORT(bertini::start_system::Polyhedral);
 
 
 namespace bertini {
@@ -141,6 +150,8 @@ namespace bertini {
 			auto two_i = mpfr(0,2);
 			auto one = mpfr(1);
 
+			SyncTreePrecision();
+
 			for (size_t ii = 0; ii< NumNaturalVariables(); ++ii)
 				start_point(ii+offset) = exp( acos( mpfr_float(-1) ) * two_i * mpfr_float(indices[ii]) / mpfr_float(degrees_[ii])  ) * pow(random_values_[ii]->Eval<mpfr>(), one / degrees_[ii]);
 
@@ -158,5 +169,872 @@ namespace bertini {
 			return td;
 		}
 
+
+
+
+
+		namespace {
+
+			// the checks on a target system common to the start systems built from its variable groups.  kind names the start system, for the messages.
+			void CheckGroupedTarget(System const& s, std::string const& kind)
+			{
+				if (s.NumHomVariableGroups() > 0)
+					throw std::runtime_error("a homogeneous variable group is present.  currently unallowed");
+
+				if (s.NumUngroupedVariables() > 0)
+					throw std::runtime_error("ungrouped variables are present.  currently unallowed");
+
+				if (s.NumTotalFunctions() != s.NumVariables())
+					throw std::runtime_error("attempting to construct " + kind + " start system from non-square target system");
+
+				if (s.HavePathVariable())
+					throw std::runtime_error("attempting to construct " + kind + " start system, but target system has path varible declared already");
+
+				if (!s.IsPolynomial())
+					throw std::runtime_error("attempting to construct " + kind + " start system from non-polynomial target system");
+			}
+
+
+			// the degrees of the functions of a system in each of its affine variable groups, indexed [function][group]
+			std::vector<std::vector<int> > DegreesInGroups(System const& s)
+			{
+				std::vector<std::vector<int> > degrees(s.NumFunctions(), std::vector<int>(s.NumVariableGroups()));
+				for (unsigned jj = 0; jj < s.NumVariableGroups(); ++jj)
+				{
+					auto deg = s.Degrees(s.AffineVariableGroup(jj));
+					for (unsigned ii = 0; ii < s.NumFunctions(); ++ii)
+						degrees[ii][jj] = deg[ii];
+				}
+				return degrees;
+			}
+
+
+			// call accept with each assignment of the functions, from function_index on, to variable groups of positive degree, with the groups taking the given numbers of functions.
+			template<typename Accept>
+			void ForEachGroupAssignment(std::vector<std::vector<int> > const& degrees, std::vector<unsigned> & assignment, std::vector<unsigned> & capacities, unsigned function_index, Accept & accept)
+			{
+				if (function_index==assignment.size())
+				{
+					accept(assignment);
+					return;
+				}
+
+				for (unsigned jj = 0; jj < capacities.size(); ++jj)
+					if (capacities[jj] > 0 && degrees[function_index][jj] > 0)
+					{
+						assignment[function_index] = jj;
+						--capacities[jj];
+						ForEachGroupAssignment(degrees, assignment, capacities, function_index+1, accept);
+						++capacities[jj];
+					}
+			}
+
+
+			// find the assignments of the functions to the groups of a start system, each group taking as many as it has variables, for which accept holds, and store them with the cumulative numbers of start points they give
+			template<typename Accept>
+			void EnumerateGroupAssignments(StartSystem const& start, std::vector<std::vector<int> > const& degrees, Accept const& accept, std::vector<std::vector<unsigned> > & assignments, std::vector<mpz_int> & cumulative_num_start_points)
+			{
+				std::vector<unsigned> assignment(degrees.size());
+				std::vector<unsigned> capacities(start.NumVariableGroups());
+				for (unsigned jj = 0; jj < capacities.size(); ++jj)
+					capacities[jj] = start.AffineVariableGroup(jj).size();
+
+				auto store = [&](std::vector<unsigned> const& a)
+					{
+						if (!accept(a))
+							return;
+
+						mpz_int num_start_points = 1;
+						for (unsigned ii = 0; ii < a.size(); ++ii)
+							num_start_points *= degrees[ii][a[ii]];
+
+						assignments.push_back(a);
+						cumulative_num_start_points.push_back(num_start_points + (cumulative_num_start_points.empty() ? mpz_int(0) : cumulative_num_start_points.back()));
+					};
+				ForEachGroupAssignment(degrees, assignment, capacities, 0, store);
+			}
+
+
+			// find the assignment giving a start point index, and reduce the index to one among the start points of the assignment
+			size_t LocateAssignment(std::vector<mpz_int> const& cumulative_num_start_points, mpz_int & index)
+			{
+				const size_t a = std::upper_bound(cumulative_num_start_points.begin(), cumulative_num_start_points.end(), index) - cumulative_num_start_points.begin();
+				if (a==cumulative_num_start_points.size())
+					throw std::out_of_range("start point index exceeds the number of start points");
+				if (a > 0)
+					index -= cumulative_num_start_points[a-1];
+				return a;
+			}
+
+
+			// whether each row can be matched to a distinct column among those it holds, by augmenting paths
+			bool HasCompleteMatching(std::vector<std::vector<unsigned> const*> const& rows, unsigned num_columns)
+			{
+				std::vector<int> matched_row(num_columns, -1);
+				std::vector<bool> visited;
+
+				std::function<bool(unsigned)> augment = [&](unsigned row)
+					{
+						for (auto column : *rows[row])
+							if (!visited[column])
+							{
+								visited[column] = true;
+								if (matched_row[column] < 0 || augment(matched_row[column]))
+								{
+									matched_row[column] = row;
+									return true;
+								}
+							}
+						return false;
+					};
+
+				for (unsigned row = 0; row < rows.size(); ++row)
+				{
+					visited.assign(num_columns, false);
+					if (!augment(row))
+						return false;
+				}
+				return true;
+			}
+
+		} // namespace
+
+
+
+		// constructor for MHomogeneous start system, from any other *suitable* system.
+		MHomogeneous::MHomogeneous(System const& s)
+		{
+			CheckGroupedTarget(s, "multihomogeneous");
+
+			const auto num_groups = s.NumVariableGroups();
+			degrees_ = DegreesInGroups(s);
+
+			CopyVariableStructure(s);
+
+			coefficients_.resize(s.NumFunctions());
+			for (unsigned ii = 0; ii < s.NumFunctions(); ++ii)
+			{
+				coefficients_[ii].resize(num_groups);
+
+				std::shared_ptr<node::Node> f;
+				for (unsigned jj = 0; jj < num_groups; ++jj)
+				{
+					if (degrees_[ii][jj]==0)
+						continue;
+
+					VariableGroup const& v = this->AffineVariableGroup(jj);
+					std::shared_ptr<node::Node> linear_form;
+					for (unsigned kk = 0; kk < v.size(); ++kk)
+					{
+						coefficients_[ii][jj].push_back(std::make_shared<node::Rational>(node::Rational::Rand()));
+						if (kk==0)
+							linear_form = coefficients_[ii][jj][kk]*v[kk];
+						else
+							linear_form = linear_form + coefficients_[ii][jj][kk]*v[kk];
+					}
+
+					auto factor = pow(linear_form, degrees_[ii][jj]) - 1;
+					f = f ? f*factor : factor;
+				}
+
+				if (!f)
+					throw std::runtime_error("attempting to construct multihomogeneous start system from target system with a function of degree 0");
+				AddFunction(f);
+			}
+
+			if (s.IsHomogeneous())
+				Homogenize();
+
+			if (s.IsPatched())
+				CopyPatches(s);
+
+			// every assignment gives nonsingular linear systems, the linear forms being over whole groups
+			EnumerateGroupAssignments(*this, degrees_, [](std::vector<unsigned> const&){ return true; }, assignments_, cumulative_num_start_points_);
+		}// multihomogeneous constructor
+
+
+
+		mpz_int MHomogeneous::NumStartPoints() const
+		{
+			if (cumulative_num_start_points_.empty())
+				return 0;
+			return cumulative_num_start_points_.back();
+		}
+
+
+
+		template<typename T>
+		Vec<T> MHomogeneous::StartPointFromIndex(mpz_int index) const
+		{
+			using RealType = typename Eigen::NumTraits<T>::Real;
+			using std::acos;
+			using std::exp;
+
+			std::vector<unsigned> const& assignment = assignments_[LocateAssignment(cumulative_num_start_points_, index)];
+			std::vector<mpz_int> root_orders(assignment.size());
+			for (unsigned ii = 0; ii < assignment.size(); ++ii)
+				root_orders[ii] = degrees_[ii][assignment[ii]];
+			auto roots = IndexToSubscript(index, root_orders);
+
+			const RealType two_pi = 2*acos(RealType(-1));
+			const bool is_homogenized = NumHomVariables() > 0;
+
+			Vec<T> start_point(NumVariables());
+			unsigned offset = 0;
+			for (unsigned jj = 0; jj < NumVariableGroups(); ++jj)
+			{
+				const auto n = this->AffineVariableGroup(jj).size();
+				Mat<T> A(n,n);
+				Vec<T> b(n);
+				unsigned row = 0;
+				for (unsigned ii = 0; ii < assignment.size(); ++ii)
+					if (assignment[ii]==jj)
+					{
+						for (unsigned kk = 0; kk < n; ++kk)
+							A(row,kk) = coefficients_[ii][jj][kk]->Eval<T>();
+						b(row) = exp(T(RealType(0), two_pi * RealType(roots[ii]) / RealType(root_orders[ii])));
+						++row;
+					}
+
+				if (is_homogenized)
+					start_point(offset++) = T(1);
+				start_point.segment(offset, n) = A.lu().solve(b);
+				offset += n;
+			}
+
+			if (IsPatched())
+				RescalePointToFitPatchInPlace(start_point);
+
+			return start_point;
+		}
+
+
+
+		Vec<dbl> MHomogeneous::GenerateStartPoint(dbl,mpz_int index) const
+		{
+			return StartPointFromIndex<dbl>(index);
+		}
+
+
+		Vec<mpfr> MHomogeneous::GenerateStartPoint(mpfr,mpz_int index) const
+		{
+			SyncTreePrecision();
+			return StartPointFromIndex<mpfr>(index);
+		}
+
+
+
+
+
+		// constructor for LinearProduct start system, from any other *suitable* system.
+		LinearProduct::LinearProduct(System const& s)
+		{
+			CheckGroupedTarget(s, "linear-product");
+
+			const auto num_groups = s.NumVariableGroups();
+			degrees_ = DegreesInGroups(s);
+
+			CopyVariableStructure(s);
+
+			supports_.resize(s.NumFunctions());
+			coefficients_.resize(s.NumFunctions());
+			for (unsigned ii = 0; ii < s.NumFunctions(); ++ii)
+			{
+				supports_[ii].resize(num_groups);
+				coefficients_[ii].resize(num_groups);
+
+				std::shared_ptr<node::Node> f;
+				for (unsigned jj = 0; jj < num_groups; ++jj)
+				{
+					VariableGroup const& v = this->AffineVariableGroup(jj);
+					for (unsigned kk = 0; kk < v.size(); ++kk)
+						if (s.Function(ii)->Degree(v[kk]) > 0)
+							supports_[ii][jj].push_back(kk);
+
+					coefficients_[ii][jj].resize(degrees_[ii][jj]);
+					for (auto& factor_coefficients : coefficients_[ii][jj])
+					{
+						auto constant = std::make_shared<node::Rational>(node::Rational::Rand());
+						std::shared_ptr<node::Node> factor = constant;
+						for (auto kk : supports_[ii][jj])
+						{
+							factor_coefficients.push_back(std::make_shared<node::Rational>(node::Rational::Rand()));
+							factor = factor + factor_coefficients.back()*v[kk];
+						}
+						factor_coefficients.push_back(constant);
+						f = f ? f*factor : factor;
+					}
+				}
+
+				if (!f)
+					throw std::runtime_error("attempting to construct linear-product start system from target system with a function of degree 0");
+				AddFunction(f);
+			}
+
+			if (s.IsHomogeneous())
+				Homogenize();
+
+			if (s.IsPatched())
+				CopyPatches(s);
+
+			// the linear system for a group is nonsingular when its functions can be matched to distinct variables in their supports
+			auto nonsingular = [this](std::vector<unsigned> const& assignment)
+				{
+					for (unsigned jj = 0; jj < this->NumVariableGroups(); ++jj)
+					{
+						std::vector<std::vector<unsigned> const*> rows;
+						for (unsigned ii = 0; ii < assignment.size(); ++ii)
+							if (assignment[ii]==jj)
+								rows.push_back(&supports_[ii][jj]);
+						if (!HasCompleteMatching(rows, this->AffineVariableGroup(jj).size()))
+							return false;
+					}
+					return true;
+				};
+			EnumerateGroupAssignments(*this, degrees_, nonsingular, assignments_, cumulative_num_start_points_);
+		}// linear-product constructor
+
+
+
+		mpz_int LinearProduct::NumStartPoints() const
+		{
+			if (cumulative_num_start_points_.empty())
+				return 0;
+			return cumulative_num_start_points_.back();
+		}
+
+
+
+		template<typename T>
+		Vec<T> LinearProduct::StartPointFromIndex(mpz_int index) const
+		{
+			std::vector<unsigned> const& assignment = assignments_[LocateAssignment(cumulative_num_start_points_, index)];
+			std::vector<mpz_int> num_factors(assignment.size());
+			for (unsigned ii = 0; ii < assignment.size(); ++ii)
+				num_factors[ii] = degrees_[ii][assignment[ii]];
+			auto factors = IndexToSubscript(index, num_factors);
+
+			const bool is_homogenized = NumHomVariables() > 0;
+
+			Vec<T> start_point(NumVariables());
+			unsigned offset = 0;
+			for (unsigned jj = 0; jj < NumVariableGroups(); ++jj)
+			{
+				const auto n = this->AffineVariableGroup(jj).size();
+				Mat<T> A = Mat<T>::Zero(n,n);
+				Vec<T> b(n);
+				unsigned row = 0;
+				for (unsigned ii = 0; ii < assignment.size(); ++ii)
+					if (assignment[ii]==jj)
+					{
+						auto const& c = coefficients_[ii][jj][static_cast<unsigned>(factors[ii])];
+						auto const& support = supports_[ii][jj];
+						for (unsigned kk = 0; kk < support.size(); ++kk)
+							A(row,support[kk]) = c[kk]->Eval<T>();
+						b(row) = -c.back()->Eval<T>();
+						++row;
+					}
+
+				if (is_homogenized)
+					start_point(offset++) = T(1);
+				start_point.segment(offset, n) = A.lu().solve(b);
+				offset += n;
+			}
+
+			if (IsPatched())
+				RescalePointToFitPatchInPlace(start_point);
+
+			return start_point;
+		}
+
+
+
+		Vec<dbl> LinearProduct::GenerateStartPoint(dbl,mpz_int index) const
+		{
+			return StartPointFromIndex<dbl>(index);
+		}
+
+
+		Vec<mpfr> LinearProduct::GenerateStartPoint(mpfr,mpz_int index) const
+		{
+			SyncTreePrecision();
+			return StartPointFromIndex<mpfr>(index);
+		}
+
+
+
+
+
+
+		namespace {
+
+			using Supports = std::vector<std::vector<std::vector<int> > >;
+			using Lifting = std::vector<std::vector<int> >;
+			using Cell = std::vector<std::pair<unsigned, unsigned> >;
+
+			// the lifted value <a,alpha> + w(a) of term a of function i
+			mpq_rational LiftedValue(Supports const& supports, Lifting const& lifting, unsigned i, unsigned a, std::vector<mpq_rational> const& alpha)
+			{
+				mpq_rational value = lifting[i][a];
+				for (unsigned kk = 0; kk < alpha.size(); ++kk)
+					value += supports[i][a][kk]*alpha[kk];
+				return value;
+			}
+
+
+			// the inner normal alpha of a cell, solving <b_i - a_i, alpha> = w(a_i) - w(b_i), exactly.  the differences must be independent
+			std::vector<mpq_rational> CellNormal(Supports const& supports, Lifting const& lifting, Cell const& cell)
+			{
+				const auto n = cell.size();
+				std::vector<std::vector<mpq_rational> > A(n, std::vector<mpq_rational>(n+1));
+				for (unsigned ii = 0; ii < n; ++ii)
+				{
+					for (unsigned kk = 0; kk < n; ++kk)
+						A[ii][kk] = supports[ii][cell[ii].second][kk] - supports[ii][cell[ii].first][kk];
+					A[ii][n] = lifting[ii][cell[ii].first] - lifting[ii][cell[ii].second];
+				}
+
+				for (unsigned col = 0; col < n; ++col)
+				{
+					unsigned pivot = col;
+					while (A[pivot][col]==0)
+						if (++pivot==n)
+							throw std::runtime_error("in polyhedral start system, a mixed cell has dependent edges");
+					std::swap(A[pivot], A[col]);
+
+					for (unsigned ii = 0; ii < n; ++ii)
+						if (ii!=col && A[ii][col]!=0)
+						{
+							const mpq_rational factor = A[ii][col]/A[col][col];
+							for (unsigned kk = col; kk <= n; ++kk)
+								A[ii][kk] -= factor*A[col][kk];
+						}
+				}
+
+				std::vector<mpq_rational> alpha(n);
+				for (unsigned ii = 0; ii < n; ++ii)
+					alpha[ii] = A[ii][n]/A[ii][ii];
+				return alpha;
+			}
+
+
+			// the diagonal of a lower triangular Hermite form of an integer matrix, made by unimodular column operations.  the representatives of Z^n modulo the lattice of the columns are the vectors with 0 <= k_r < diagonal_r, and the product of the diagonal is the absolute value of the determinant
+			std::vector<mpz_int> HermiteDiagonal(std::vector<std::vector<mpz_int> > H)
+			{
+				const auto n = H.size();
+				std::vector<mpz_int> diagonal(n);
+				for (unsigned r = 0; r < n; ++r)
+				{
+					// the rows above are zero from column r on, so only the rows from r are touched
+					for (unsigned c = r+1; c < n; ++c)
+						while (H[r][c]!=0)
+						{
+							const mpz_int q = H[r][r]/H[r][c];
+							for (unsigned kk = r; kk < n; ++kk)
+							{
+								H[kk][r] -= q*H[kk][c];
+								std::swap(H[kk][r], H[kk][c]);
+							}
+						}
+					diagonal[r] = abs(H[r][r]);
+				}
+				return diagonal;
+			}
+
+
+			// the matrix of a cell, with rows b_i - a_i
+			std::vector<std::vector<mpz_int> > CellMatrix(Supports const& supports, Cell const& cell)
+			{
+				const auto n = cell.size();
+				std::vector<std::vector<mpz_int> > V(n, std::vector<mpz_int>(n));
+				for (unsigned ii = 0; ii < n; ++ii)
+					for (unsigned kk = 0; kk < n; ++kk)
+						V[ii][kk] = supports[ii][cell[ii].second][kk] - supports[ii][cell[ii].first][kk];
+				return V;
+			}
+
+
+			// reduce a row against rows in echelon form, each with a unit at its pivot and zeros at the pivots before it.  if it is independent of them, add it, and return true
+			bool AddIfIndependent(std::vector<mpq_rational> row, std::vector<std::vector<mpq_rational> > & basis, std::vector<unsigned> & pivots)
+			{
+				for (unsigned bb = 0; bb < basis.size(); ++bb)
+					if (row[pivots[bb]]!=0)
+					{
+						const mpq_rational factor = row[pivots[bb]];
+						for (unsigned kk = 0; kk < row.size(); ++kk)
+							row[kk] -= factor*basis[bb][kk];
+					}
+
+				unsigned pivot = 0;
+				while (pivot < row.size() && row[pivot]==0)
+					++pivot;
+				if (pivot==row.size())
+					return false;
+
+				const mpq_rational scale = row[pivot];
+				for (auto& r : row)
+					r /= scale;
+				basis.push_back(row);
+				pivots.push_back(pivot);
+				return true;
+			}
+
+
+			// find the mixed cells among the choices of pairs of terms of the functions from function_index on, given those before.  the pairs must have independent differences, and be the least lifted values of their supports for the normal they determine
+			void SearchMixedCells(Supports const& supports, Lifting const& lifting, Cell & cell, std::vector<std::vector<mpq_rational> > & basis, std::vector<unsigned> & pivots, unsigned function_index, std::vector<Cell> & cells, std::atomic<bool> & degenerate)
+			{
+				const auto n = supports.size();
+				if (function_index==n)
+				{
+					const auto alpha = CellNormal(supports, lifting, cell);
+					for (unsigned ii = 0; ii < n; ++ii)
+					{
+						const auto least = LiftedValue(supports, lifting, ii, cell[ii].first, alpha);
+						for (unsigned a = 0; a < supports[ii].size(); ++a)
+						{
+							if (a==cell[ii].first || a==cell[ii].second)
+								continue;
+							const auto value = LiftedValue(supports, lifting, ii, a, alpha);
+							if (value < least)
+								return;
+							if (value==least)
+							{
+								degenerate = true;
+								return;
+							}
+						}
+					}
+					cells.push_back(cell);
+					return;
+				}
+
+				auto const& support = supports[function_index];
+				for (unsigned a = 0; a < support.size(); ++a)
+					for (unsigned b = a+1; b < support.size(); ++b)
+					{
+						std::vector<mpq_rational> difference(n);
+						for (unsigned kk = 0; kk < n; ++kk)
+							difference[kk] = support[b][kk] - support[a][kk];
+
+						const auto basis_size = basis.size();
+						if (!AddIfIndependent(difference, basis, pivots))
+							continue;
+
+						cell[function_index] = {a, b};
+						SearchMixedCells(supports, lifting, cell, basis, pivots, function_index+1, cells, degenerate);
+
+						basis.resize(basis_size);
+						pivots.resize(basis_size);
+					}
+			}
+
+		} // namespace
+
+
+
+		// constructor for Polyhedral start system, from any other *suitable* system.
+		Polyhedral::Polyhedral(System const& s, unsigned num_threads)
+		{
+			CheckGroupedTarget(s, "polyhedral");
+
+			// the supports are over the affine variables, in the order of the groups.  homogenizing variables, if any, are dropped, which dehomogenizes
+			VariableGroup affine_variables;
+			for (unsigned jj = 0; jj < s.NumVariableGroups(); ++jj)
+				for (auto const& v : s.AffineVariableGroup(jj))
+					affine_variables.push_back(v);
+
+			std::unordered_map<node::Variable const*, unsigned> affine_index;
+			for (unsigned kk = 0; kk < affine_variables.size(); ++kk)
+				affine_index[affine_variables[kk].get()] = kk;
+
+			std::vector<std::shared_ptr<node::Function> > functions;
+			for (unsigned ii = 0; ii < s.NumFunctions(); ++ii)
+				functions.push_back(s.Function(ii));
+
+			SparsePolynomialSystem polynomials;
+			if (!PolynomialExpander().Expand(functions, s.Variables(), nullptr, polynomials))
+				throw std::runtime_error("attempting to construct polyhedral start system from target system which could not be expanded into monomials");
+
+			const auto n = affine_variables.size();
+			supports_.resize(s.NumFunctions());
+			for (unsigned ii = 0; ii < s.NumFunctions(); ++ii)
+			{
+				for (auto const& exponents : polynomials.Exponents(ii))
+				{
+					std::vector<int> point(n, 0);
+					for (unsigned kk = 0; kk < exponents.size(); ++kk)
+					{
+						auto found = affine_index.find(s.Variables()[kk].get());
+						if (found!=affine_index.end())
+							point[found->second] = exponents[kk];
+					}
+					if (std::any_of(point.begin(), point.end(), [](int e){ return e!=0; }) && std::find(supports_[ii].begin(), supports_[ii].end(), point)==supports_[ii].end())
+						supports_[ii].push_back(point);
+				}
+
+				if (supports_[ii].empty())
+					throw std::runtime_error("attempting to construct polyhedral start system from target system with a function of degree 0");
+				supports_[ii].push_back(std::vector<int>(n, 0));
+			}
+
+			CopyVariableStructure(s);
+
+			coefficients_.resize(s.NumFunctions());
+			for (unsigned ii = 0; ii < s.NumFunctions(); ++ii)
+			{
+				std::shared_ptr<node::Node> f;
+				for (auto const& point : supports_[ii])
+				{
+					coefficients_[ii].push_back(std::make_shared<node::Rational>(node::Rational::Rand()));
+					std::shared_ptr<node::Node> term = coefficients_[ii].back();
+					for (unsigned kk = 0; kk < n; ++kk)
+						if (point[kk] > 0)
+							term = term*pow(affine_variables[kk], point[kk]);
+					f = f ? f+term : term;
+				}
+				AddFunction(f);
+			}
+
+			if (s.IsHomogeneous())
+				Homogenize();
+
+			if (s.IsPatched())
+				CopyPatches(s);
+
+			if (num_threads==0)
+				num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+			// a lifting with ties is drawn again.  ties have probability near zero for supports of modest size
+			const unsigned max_liftings = 10;
+			for (unsigned ii = 0; ii < max_liftings; ++ii)
+				if (FindMixedCells(num_threads))
+					return;
+			throw std::runtime_error("in polyhedral start system, failed to draw a generic lifting");
+		}// polyhedral constructor
+
+
+
+		bool Polyhedral::FindMixedCells(unsigned num_threads)
+		{
+			lifting_.resize(supports_.size());
+			for (unsigned ii = 0; ii < supports_.size(); ++ii)
+			{
+				lifting_[ii].clear();
+				for (unsigned a = 0; a < supports_[ii].size(); ++a)
+					lifting_[ii].push_back(RandomInt<3>().convert_to<int>());
+			}
+
+			// the pairs of the first support are dealt out among the threads, and the cells from each are collected in order, so that the cells are in the same order whatever the number of threads
+			std::vector<std::pair<unsigned, unsigned> > first_pairs;
+			for (unsigned a = 0; a < supports_[0].size(); ++a)
+				for (unsigned b = a+1; b < supports_[0].size(); ++b)
+					first_pairs.emplace_back(a, b);
+
+			std::vector<std::vector<Cell> > cells_from(first_pairs.size());
+			std::atomic<bool> degenerate(false);
+			const auto n = supports_.size();
+
+			auto work = [&](unsigned id)
+			{
+				for (size_t job = id; job < first_pairs.size(); job += num_threads)
+				{
+					Cell cell(n);
+					cell[0] = first_pairs[job];
+
+					std::vector<std::vector<mpq_rational> > basis;
+					std::vector<unsigned> pivots;
+					std::vector<mpq_rational> difference(n);
+					for (unsigned kk = 0; kk < n; ++kk)
+						difference[kk] = supports_[0][cell[0].second][kk] - supports_[0][cell[0].first][kk];
+					if (AddIfIndependent(difference, basis, pivots))
+						SearchMixedCells(supports_, lifting_, cell, basis, pivots, 1, cells_from[job], degenerate);
+				}
+			};
+
+			num_threads = static_cast<unsigned>(std::max<size_t>(std::min<size_t>(num_threads, first_pairs.size()), 1));
+			std::vector<std::thread> threads;
+			for (unsigned ii = 1; ii < num_threads; ++ii)
+				threads.emplace_back(work, ii);
+			work(0);
+			for (auto& th : threads)
+				th.join();
+
+			if (degenerate)
+				return false;
+
+			cells_.clear();
+			cell_volumes_.clear();
+			for (auto const& from : cells_from)
+				for (auto const& cell : from)
+				{
+					cells_.push_back(cell);
+					auto diagonal = HermiteDiagonal(CellMatrix(supports_, cell));
+					mpz_int volume = 1;
+					for (auto const& d : diagonal)
+						volume *= d;
+					cell_volumes_.push_back(volume);
+				}
+			return true;
+		}
+
+
+
+		mpz_int Polyhedral::MixedVolume() const
+		{
+			mpz_int volume = 0;
+			for (auto const& v : cell_volumes_)
+				volume += v;
+			return volume;
+		}
+
+
+
+		mpz_int Polyhedral::NumStartPoints() const
+		{
+			return start_points_.size();
+		}
+
+
+
+		std::vector<Vec<dbl> > Polyhedral::BinomialSolutions(size_t cell) const
+		{
+			using std::exp;
+			using std::log;
+
+			// y^(b_i - a_i) = -c_a / c_b.  with y = exp(z), V z = log(-c_a/c_b) + 2 pi i k, and the distinct solutions are had from the k modulo the lattice of the columns of V
+			const auto& pairs = cells_[cell];
+			const auto n = pairs.size();
+			const auto V = CellMatrix(supports_, pairs);
+			const auto diagonal = HermiteDiagonal(V);
+
+			Mat<double> V_double(n,n);
+			for (unsigned ii = 0; ii < n; ++ii)
+				for (unsigned kk = 0; kk < n; ++kk)
+					V_double(ii,kk) = V[ii][kk].convert_to<double>();
+			const Mat<double> V_inverse = V_double.inverse();
+
+			Vec<dbl> logs(n);
+			for (unsigned ii = 0; ii < n; ++ii)
+				logs(ii) = log(-coefficients_[ii][pairs[ii].first]->Eval<dbl>() / coefficients_[ii][pairs[ii].second]->Eval<dbl>());
+
+			const double two_pi = 2*std::acos(-1.0);
+			std::vector<Vec<dbl> > solutions;
+			for (mpz_int index = 0; index < cell_volumes_[cell]; ++index)
+			{
+				auto k = IndexToSubscript(index, diagonal);
+				Vec<dbl> rhs(n);
+				for (unsigned ii = 0; ii < n; ++ii)
+					rhs(ii) = logs(ii) + dbl(0, two_pi*k[ii].convert_to<double>());
+
+				Vec<dbl> y = V_inverse.cast<dbl>()*rhs;
+				for (unsigned ii = 0; ii < n; ++ii)
+					y(ii) = exp(y(ii));
+				solutions.push_back(y);
+			}
+			return solutions;
+		}
+
+
+
+		System Polyhedral::CellHomotopy(size_t cell) const
+		{
+			const auto& pairs = cells_[cell];
+			const auto n = pairs.size();
+			const auto alpha = CellNormal(supports_, lifting_, pairs);
+
+			// the exponents of t, before scaling by the least positive one
+			std::vector<std::vector<mpq_rational> > exponents(n);
+			mpq_rational least_positive = 0;
+			for (unsigned ii = 0; ii < n; ++ii)
+			{
+				const auto beta = LiftedValue(supports_, lifting_, ii, pairs[ii].first, alpha);
+				for (unsigned a = 0; a < supports_[ii].size(); ++a)
+				{
+					exponents[ii].push_back(LiftedValue(supports_, lifting_, ii, a, alpha) - beta);
+					if (exponents[ii].back() > 0 && (least_positive==0 || exponents[ii].back() < least_positive))
+						least_positive = exponents[ii].back();
+				}
+			}
+
+			VariableGroup y;
+			for (unsigned kk = 0; kk < n; ++kk)
+				y.push_back(std::make_shared<node::Variable>("y" + std::to_string(kk)));
+			auto t = std::make_shared<node::Variable>("t");
+
+			System homotopy;
+			homotopy.AddVariableGroup(y);
+			for (unsigned ii = 0; ii < n; ++ii)
+			{
+				std::shared_ptr<node::Node> f;
+				for (unsigned a = 0; a < supports_[ii].size(); ++a)
+				{
+					std::shared_ptr<node::Node> term = std::make_shared<node::Rational>(*coefficients_[ii][a]);
+					for (unsigned kk = 0; kk < n; ++kk)
+						if (supports_[ii][a][kk] > 0)
+							term = term*pow(y[kk], supports_[ii][a][kk]);
+					if (exponents[ii][a] > 0)
+						term = term*pow(t, mpq_rational(exponents[ii][a]/least_positive));
+					f = f ? f+term : term;
+				}
+				homotopy.AddFunction(f);
+			}
+			homotopy.AddPathVariable(t);
+			return homotopy;
+		}
+
+
+
+		template<typename T>
+		Vec<T> Polyhedral::FromAffine(Vec<T> const& affine) const
+		{
+			const bool is_homogenized = NumHomVariables() > 0;
+
+			Vec<T> start_point(NumVariables());
+			unsigned offset = 0, affine_offset = 0;
+			for (unsigned jj = 0; jj < NumVariableGroups(); ++jj)
+			{
+				const auto n = this->AffineVariableGroup(jj).size();
+				if (is_homogenized)
+					start_point(offset++) = T(1);
+				start_point.segment(offset, n) = affine.segment(affine_offset, n);
+				offset += n;
+				affine_offset += n;
+			}
+
+			if (IsPatched())
+				RescalePointToFitPatchInPlace(start_point);
+
+			return start_point;
+		}
+
+
+
+		Vec<dbl> Polyhedral::GenerateStartPoint(dbl,mpz_int index) const
+		{
+			if (index >= start_points_.size())
+				throw std::out_of_range("start point index exceeds the number of start points found for polyhedral start system");
+			return FromAffine<dbl>(start_points_[static_cast<size_t>(index)]);
+		}
+
+
+		Vec<mpfr> Polyhedral::GenerateStartPoint(mpfr,mpz_int index) const
+		{
+			if (index >= start_points_.size())
+				throw std::out_of_range("start point index exceeds the number of start points found for polyhedral start system");
+
+			SyncTreePrecision();
+
+			auto const& affine_double = start_points_[static_cast<size_t>(index)];
+			Vec<mpfr> affine(affine_double.size());
+			for (unsigned kk = 0; kk < affine_double.size(); ++kk)
+				affine(kk) = mpfr(affine_double(kk));
+
+			// the start points were found in double precision, and Newton's method doubles the correct digits with each step
+			Vec<mpfr> start_point = FromAffine<mpfr>(affine);
+			for (unsigned ii = 0; ii < 4; ++ii)
+				start_point -= Jacobian(start_point).lu().solve(Eval(start_point));
+			return start_point;
+		}
+
 	} // namespace start_system
 } //namespace bertini
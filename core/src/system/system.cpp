@@ -24,6 +24,10 @@
 
 
 #include "system.hpp"
+#include "function_tree/dependencies.hpp"
+#include "function_tree/deep_copy.hpp"
+
+#include <numeric>
 
 template<typename NumType> using Vec = bertini::Vec<NumType>;
 template<typename NumType> using Mat = bertini::Mat<NumType>;
@@ -65,6 +69,26 @@ namespace bertini
 		swap(a.precision_,b.precision_);
 		swap(a.is_patched_,b.is_patched_);
 		swap(a.patch_,b.patch_);
+
+		swap(a.eval_method_,b.eval_method_);
+		swap(a.jacobian_method_,b.jacobian_method_);
+		swap(a.straight_line_program_,b.straight_line_program_);
+		swap(a.is_compiled_,b.is_compiled_);
+		swap(a.polynomial_form_,b.polynomial_form_);
+		swap(a.is_expanded_,b.is_expanded_);
+		swap(a.have_polynomial_form_,b.have_polynomial_form_);
+		swap(a.function_jacobian_sparsity_,b.function_jacobian_sparsity_);
+		swap(a.num_function_jacobian_nonzeros_,b.num_function_jacobian_nonzeros_);
+		swap(a.have_jacobian_sparsity_,b.have_jacobian_sparsity_);
+		swap(a.sparse_density_threshold_,b.sparse_density_threshold_);
+
+		swap(a.dependent_nodes_,b.dependent_nodes_);
+		swap(a.have_dependencies_,b.have_dependencies_);
+		swap(a.changed_inputs_,b.changed_inputs_);
+		swap(a.reset_all_nodes_,b.reset_all_nodes_);
+		swap(a.distinct_nodes_,b.distinct_nodes_);
+		swap(a.have_distinct_nodes_,b.have_distinct_nodes_);
+		swap(a.trees_at_system_precision_,b.trees_at_system_precision_);
 	}
 
 	// the copy constructor
@@ -94,6 +118,11 @@ namespace bertini
 
 		precision_ = other.precision_;
 
+		// the straight line program is not copied, but compiled anew when needed, since it refers to the function nodes.
+		eval_method_ = other.eval_method_;
+		jacobian_method_ = other.jacobian_method_;
+		sparse_density_threshold_ = other.sparse_density_threshold_;
+
 		// now to do the members which are not simply copied
 		constant_subfunctions_.resize(other.constant_subfunctions_.size());
 		for (unsigned ii = 0; ii < constant_subfunctions_.size(); ++ii)
@@ -120,6 +149,63 @@ namespace bertini
 	}
 
 
+	System System::Clone() const
+	{
+		// one copier for everything, so that nodes shared among the trees are shared among the copies, too
+		node::DeepCopier copier;
+		auto copy_group = [&copier](VariableGroup const& g)
+			{
+				VariableGroup c;
+				for (const auto& v : g)
+					c.push_back(copier.Copy(v));
+				return c;
+			};
+		auto copy_functions = [&copier](std::vector<Fn> const& fs)
+			{
+				std::vector<Fn> c;
+				for (const auto& f : fs)
+					c.push_back(copier.Copy(f));
+				return c;
+			};
+
+		System clone;
+
+		clone.ungrouped_variables_ = copy_group(ungrouped_variables_);
+		for (const auto& g : variable_groups_)
+			clone.variable_groups_.push_back(copy_group(g));
+		for (const auto& g : hom_variable_groups_)
+			clone.hom_variable_groups_.push_back(copy_group(g));
+		clone.homogenizing_variables_ = copy_group(homogenizing_variables_);
+		clone.time_order_of_variable_groups_ = time_order_of_variable_groups_;
+
+		clone.have_path_variable_ = have_path_variable_;
+		clone.path_variable_ = copier.Copy(path_variable_);
+
+		clone.implicit_parameters_ = copy_group(implicit_parameters_);
+		clone.explicit_parameters_ = copy_functions(explicit_parameters_);
+		clone.constant_subfunctions_ = copy_functions(constant_subfunctions_);
+		clone.subfunctions_ = copy_functions(subfunctions_);
+		clone.functions_ = copy_functions(functions_);
+
+		for (const auto& j : jacobian_)
+			clone.jacobian_.push_back(copier.Copy(j));
+		clone.is_differentiated_ = is_differentiated_;
+
+		clone.variable_ordering_ = copy_group(variable_ordering_);
+		clone.have_ordering_ = have_ordering_;
+
+		clone.patch_ = patch_;
+		clone.is_patched_ = is_patched_;
+
+		// the values of the variables are deliberately left behind
+		clone.eval_method_ = eval_method_;
+		clone.jacobian_method_ = jacobian_method_;
+		clone.sparse_density_threshold_ = sparse_density_threshold_;
+		clone.precision_ = precision_;
+		return clone;
+	}
+
+
 	/////////
 	//
 	//  getters
@@ -202,31 +288,13 @@ namespace bertini
 
 	void System::precision(unsigned new_precision) const
 	{
-		for (const auto& iter : functions_) {
-			iter->precision(new_precision);
-		}
-
-		for (const auto& iter : subfunctions_) {
-			iter->precision(new_precision);
-		}
-
-		for (const auto& iter : explicit_parameters_) {
-			iter->precision(new_precision);
-		}
-
+		if (new_precision!=precision_)
+			trees_at_system_precision_ = false;
 
 		for (const auto& iter :implicit_parameters_) {
 			iter->precision(new_precision);
 		}
 
-		for (const auto& iter : constant_subfunctions_) {
-			iter->precision(new_precision);
-		}
-
-		if (is_differentiated_)
-			for (const auto& iter : jacobian_)
-				iter->precision(new_precision);
-
 		if (have_path_variable_)
 			path_variable_->precision(new_precision);
 
@@ -251,10 +319,37 @@ namespace bertini
 		if (IsPatched())
 			patch_.Precision(new_precision);
 
+		if (is_compiled_)
+			straight_line_program_.precision(new_precision);
+
+		if (is_expanded_ && have_polynomial_form_)
+			polynomial_form_.precision(new_precision);
+
+		// the stored values of constant nodes are at the old precision
+		reset_all_nodes_ = true;
+
 		precision_ = new_precision;
 	}
 
 
+	void System::SyncTreePrecision() const
+	{
+		if (trees_at_system_precision_)
+			return;
+
+		if (!have_distinct_nodes_)
+		{
+			distinct_nodes_ = node::DistinctNodes(Roots());
+			have_distinct_nodes_ = true;
+		}
+
+		for (const auto& iter : distinct_nodes_)
+			iter->PrecisionSelf(precision_);
+
+		trees_at_system_precision_ = true;
+	}
+
+
 	void System::Differentiate() const
 	{
 			jacobian_.resize(NumFunctions());
@@ -263,9 +358,169 @@ namespace bertini
 				jacobian_[ii] = std::make_shared<bertini::node::Jacobian>(functions_[ii]->Differentiate());
 
 			is_differentiated_ = true;
+			is_compiled_ = false;
+			have_distinct_nodes_ = false;
+			trees_at_system_precision_ = false;
 		}
 
 
+	std::vector< std::shared_ptr<node::Node> > System::Roots() const
+	{
+		std::vector< std::shared_ptr<node::Node> > roots;
+		for (const auto& iter : functions_)
+			roots.push_back(iter);
+		for (const auto& iter : subfunctions_)
+			roots.push_back(iter);
+		for (const auto& iter : explicit_parameters_)
+			roots.push_back(iter);
+		for (const auto& iter : constant_subfunctions_)
+			roots.push_back(iter);
+		if (is_differentiated_)
+			for (const auto& iter : jacobian_)
+				roots.push_back(iter);
+		return roots;
+	}
+
+
+	size_t System::NumDistinctNodes() const
+	{
+		return node::CountDistinctNodes(Roots());
+	}
+
+
+	std::pair<size_t, size_t> System::EliminateCommonSubexpressions()
+	{
+		if (jacobian_method_==JacobianMethod::Symbolic && !is_differentiated_)
+			Differentiate();
+
+		auto roots = Roots();
+		auto num_before = node::CountDistinctNodes(roots);
+
+		node::HashConsingFactory factory;
+		for (const auto& iter : roots)
+			factory.Canonicalize(iter);
+
+		InvalidateStructure();
+		return std::make_pair(num_before, node::CountDistinctNodes(roots));
+	}
+
+
+	void System::ResetFunctionTrees() const
+	{
+		SyncTreePrecision();
+
+		if (reset_all_nodes_)
+		{
+			for (const auto& iter : functions_)
+				iter->Reset();
+			reset_all_nodes_ = false;
+		}
+		else
+		{
+			if (!have_dependencies_)
+			{
+				VariableGroup path_variable;
+				if (have_path_variable_)
+					path_variable.push_back(path_variable_);
+
+				dependent_nodes_ = node::DependentNodes(std::vector< std::shared_ptr<node::Node> >(functions_.begin(), functions_.end()),
+				                                        {Variables(), path_variable, implicit_parameters_});
+				have_dependencies_ = true;
+			}
+
+			for (unsigned ii = 0; ii < NumInputKinds; ++ii)
+				if (changed_inputs_[ii])
+					for (const auto& iter : dependent_nodes_[ii])
+						iter->ResetSelf();
+
+			// variables which are not inputs of the system can only be set directly on their nodes, so the nodes depending on them are always reset.
+			for (const auto& iter : dependent_nodes_[NumInputKinds])
+				iter->ResetSelf();
+		}
+
+		changed_inputs_.fill(false);
+	}
+
+
+	void System::CompileStraightLineProgram() const
+	{
+		std::shared_ptr<node::Variable> path_variable = have_path_variable_ ? path_variable_ : nullptr;
+
+		if (jacobian_method_==JacobianMethod::Symbolic)
+		{
+			if (!is_differentiated_)
+				Differentiate();
+			straight_line_program_ = SLPCompiler().Compile(functions_, Variables(), path_variable, jacobian_);
+		}
+		else // the derivatives come from forward-mode differentiation of the functions alone
+			straight_line_program_ = SLPCompiler().Compile(functions_, Variables(), path_variable);
+
+		straight_line_program_.precision(precision_);
+		if (eval_method_==EvalMethod::Native)
+			straight_line_program_.SetNativeProgram(NativeCompiler().Compile(straight_line_program_));
+		is_compiled_ = true;
+	}
+
+
+	std::vector< std::vector<int> > const& System::FunctionJacobianSparsity() const
+	{
+		if (!have_jacobian_sparsity_)
+		{
+			std::vector< std::shared_ptr<node::Node> > roots(functions_.begin(), functions_.end());
+			function_jacobian_sparsity_ = node::VariablesOccurring(roots, Variables());
+
+			num_function_jacobian_nonzeros_ = 0;
+			for (const auto& iter : function_jacobian_sparsity_)
+				num_function_jacobian_nonzeros_ += iter.size();
+			have_jacobian_sparsity_ = true;
+		}
+		return function_jacobian_sparsity_;
+	}
+
+
+	std::vector< std::vector<int> > System::JacobianSparsity() const
+	{
+		auto sparsity = FunctionJacobianSparsity();
+
+		if (IsPatched())
+		{
+			int column = 0;
+			for (auto size : patch_.VariableGroupSizes())
+			{
+				sparsity.emplace_back(size);
+				std::iota(sparsity.back().begin(), sparsity.back().end(), column);
+				column += size;
+			}
+		}
+		return sparsity;
+	}
+
+
+	size_t System::NumJacobianNonzeros() const
+	{
+		FunctionJacobianSparsity();
+		return num_function_jacobian_nonzeros_ + (IsPatched() ? patch_.NumVariables() : 0);
+	}
+
+
+	double System::JacobianDensity() const
+	{
+		const double num_entries = static_cast<double>(NumTotalFunctions())*NumVariables();
+		return num_entries > 0 ? NumJacobianNonzeros()/num_entries : 0;
+	}
+
+
+	void System::ExpandPolynomials() const
+	{
+		std::shared_ptr<node::Variable> path_variable = have_path_variable_ ? path_variable_ : nullptr;
+
+		have_polynomial_form_ = PolynomialExpander().Expand(functions_, Variables(), path_variable, polynomial_form_);
+		if (have_polynomial_form_)
+			polynomial_form_.precision(precision_);
+		is_expanded_ = true;
+	}
+
+
 
 
 
@@ -331,6 +586,9 @@ namespace bertini
 		#ifndef BERTINI_DISABLE_ASSERTS
 		assert(homogenizing_variables_.size() == variable_groups_.size());
 		#endif
+
+		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -420,6 +678,7 @@ namespace bertini
 	{
 		variable_groups_.push_back(v);
 		is_differentiated_ = false;
+		InvalidateStructure();
 		have_ordering_ = false;
 		is_patched_ = false;
 		time_order_of_variable_groups_.push_back( VariableGroupType::Affine);
@@ -432,6 +691,7 @@ namespace bertini
 	{
 		hom_variable_groups_.push_back(v);
 		is_differentiated_ = false;
+		InvalidateStructure();
 		have_ordering_ = false;
 		is_patched_ = false;
 		time_order_of_variable_groups_.push_back( VariableGroupType::Homogeneous);
@@ -445,6 +705,7 @@ namespace bertini
 	{
 		ungrouped_variables_.push_back(v);
 		is_differentiated_ = false;
+		InvalidateStructure();
 		have_ordering_ = false;
 		is_patched_ = false;
 		time_order_of_variable_groups_.push_back( VariableGroupType::Ungrouped);
@@ -457,6 +718,7 @@ namespace bertini
 	{
 		ungrouped_variables_.insert( ungrouped_variables_.end(), v.begin(), v.end() );
 		is_differentiated_ = false;
+		InvalidateStructure();
 		have_ordering_ = false;
 		is_patched_ = false;
 		for (const auto& iter : v)
@@ -470,6 +732,7 @@ namespace bertini
 	{
 		implicit_parameters_.push_back(v);
 		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -479,6 +742,7 @@ namespace bertini
 	{
 		implicit_parameters_.insert( implicit_parameters_.end(), v.begin(), v.end() );
 		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -493,6 +757,7 @@ namespace bertini
 	{
 		explicit_parameters_.push_back(F);
 		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -501,6 +766,7 @@ namespace bertini
 	{
 		explicit_parameters_.insert( explicit_parameters_.end(), v.begin(), v.end() );
 		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -511,6 +777,7 @@ namespace bertini
 	{
 		subfunctions_.push_back(F);
 		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -519,6 +786,7 @@ namespace bertini
 	{
 		subfunctions_.insert( subfunctions_.end(), v.begin(), v.end() );
 		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -529,6 +797,7 @@ namespace bertini
 	{
 		functions_.push_back(F);
 		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -538,6 +807,7 @@ namespace bertini
 		Fn F = std::make_shared<node::Function>(N);
 		functions_.push_back(F);
 		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -546,6 +816,7 @@ namespace bertini
 	{
 		functions_.insert( functions_.end(), v.begin(), v.end() );
 		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -557,6 +828,7 @@ namespace bertini
 	{
 		constant_subfunctions_.push_back(F);
 		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -564,6 +836,7 @@ namespace bertini
 	{
 		constant_subfunctions_.insert( constant_subfunctions_.end(), v.begin(), v.end() );
 		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -575,6 +848,7 @@ namespace bertini
 	{
 		path_variable_ = v;
 		is_differentiated_ = false;
+		InvalidateStructure();
 		have_path_variable_ = true;
 	}
 
@@ -760,10 +1034,16 @@ namespace bertini
 
     	for (unsigned ii=0; ii < num_evaluations; ii++)
     	{	
+    		// random numbers are made with at least 50 digits, but the point must be at the precision of the system
     		Vec<mpfr> randy = RandomOfUnits<mpfr>(NumVariables());
+    		Precision(randy, precision());
     		Vec<mpfr> f_vals;
     		if (HavePathVariable())
-    			f_vals = Eval(randy, mpfr::rand());
+    		{
+    			mpfr t = mpfr::rand();
+    			Precision(t, precision());
+    			f_vals = Eval(randy, t);
+    		}
     		else
     			f_vals = Eval(randy);
 	    	
@@ -836,6 +1116,8 @@ namespace bertini
 		}
 
 		swap(functions_, re_ordered_functions);
+		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -863,6 +1145,8 @@ namespace bertini
 		}
 
 		swap(functions_, re_ordered_functions);
+		is_differentiated_ = false;
+		InvalidateStructure();
 	}
 
 
@@ -1029,6 +1313,8 @@ namespace bertini
 		for (auto iter=functions_.begin(); iter!=functions_.end(); iter++)
 			(*iter)->SetRoot( (*(rhs.functions_.begin()+(iter-functions_.begin())))->entry_node() + (*iter)->entry_node());
 
+		is_differentiated_ = false;
+		InvalidateStructure();
 		return *this;
 	}
 
@@ -1044,6 +1330,8 @@ namespace bertini
 		{
 			(*iter)->SetRoot( N * (*iter)->entry_node());
 		}
+		is_differentiated_ = false;
+		InvalidateStructure();
 		return *this;
 	}
 
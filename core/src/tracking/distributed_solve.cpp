@@ -0,0 +1,179 @@
+//This file is part of Bertini 2.
+//
+//distributed_solve.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//distributed_solve.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with distributed_solve.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+#include "bertini2/tracking/distributed_solve.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+namespace bertini {
+namespace tracking {
+namespace distributed {
+
+	WorkerProcess Spawn(std::function<void(int)> const& worker_main, std::vector<int> const& close_in_child)
+	{
+		int ends[2];
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, ends)!=0)
+			throw std::runtime_error("unable to make socket for worker process");
+
+		auto pid = fork();
+		if (pid<0)
+		{
+			close(ends[0]);
+			close(ends[1]);
+			throw std::runtime_error("unable to fork worker process");
+		}
+
+		if (pid==0)
+		{
+			close(ends[0]);
+			for (auto s : close_in_child)
+				close(s);
+
+			int status = 0;
+			try{
+				worker_main(ends[1]);
+			}
+			catch (...)
+			{
+				status = 1;
+			}
+			close(ends[1]);
+			_exit(status); // skip the parent's atexit handlers and buffered output
+		}
+
+		close(ends[1]);
+		WorkerProcess worker;
+		worker.pid = pid;
+		worker.socket = ends[0];
+		return worker;
+	}
+
+
+	void Retire(WorkerProcess & worker)
+	{
+		if (worker.socket>=0)
+			close(worker.socket);
+		if (worker.pid>0)
+			waitpid(worker.pid, nullptr, 0);
+		worker = WorkerProcess();
+	}
+
+
+	void Kill(WorkerProcess & worker)
+	{
+		if (worker.pid>0)
+			kill(worker.pid, SIGKILL);
+		Retire(worker);
+	}
+
+
+
+	namespace {
+
+		bool WriteAll(int socket, char const* data, size_t size)
+		{
+			while (size>0)
+			{
+				auto written = send(socket, data, size, MSG_NOSIGNAL);
+				if (written<0 && errno==EINTR)
+					continue;
+				if (written<=0)
+					return false;
+				data += written;
+				size -= written;
+			}
+			return true;
+		}
+
+		bool ReadAll(int socket, char* data, size_t size)
+		{
+			while (size>0)
+			{
+				auto got = recv(socket, data, size, 0);
+				if (got<0 && errno==EINTR)
+					continue;
+				if (got<=0)
+					return false;
+				data += got;
+				size -= got;
+			}
+			return true;
+		}
+
+	} // re: anonymous namespace
+
+
+	bool Send(int socket, std::string const& message)
+	{
+		uint64_t size = message.size();
+		return WriteAll(socket, reinterpret_cast<char const*>(&size), sizeof(size)) &&
+		       WriteAll(socket, message.data(), message.size());
+	}
+
+
+	bool Receive(int socket, std::string & message)
+	{
+		uint64_t size;
+		if (!ReadAll(socket, reinterpret_cast<char*>(&size), sizeof(size)))
+			return false;
+		message.resize(size);
+		return size==0 || ReadAll(socket, &message[0], size);
+	}
+
+
+	size_t WaitForAny(std::vector<int> const& sockets)
+	{
+		std::vector<pollfd> fds(sockets.size());
+		for (size_t ii = 0; ii < sockets.size(); ++ii)
+		{
+			fds[ii].fd = sockets[ii];
+			fds[ii].events = POLLIN;
+		}
+
+		while (true)
+		{
+			auto ready = poll(fds.data(), fds.size(), -1);
+			if (ready<0 && errno==EINTR)
+				continue;
+			if (ready<0)
+				throw std::runtime_error("unable to wait for worker processes");
+
+			for (size_t ii = 0; ii < fds.size(); ++ii)
+				if (fds[ii].revents)
+					return ii;
+		}
+	}
+
+} // re: namespace distributed
+} // re: namespace tracking
+} // re: namespace bertini
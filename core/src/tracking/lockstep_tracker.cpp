@@ -0,0 +1,293 @@
+//This file is part of Bertini 2.
+//
+//lockstep_tracker.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//lockstep_tracker.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with lockstep_tracker.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+#include "bertini2/tracking/lockstep_tracker.hpp"
+
+#include <Eigen/LU>
+
+
+namespace bertini {
+namespace tracking {
+
+	LockstepTracker::LockstepTracker(System const& sys) : LockstepTracker(sys, config::AdaptiveMultiplePrecisionConfig(sys))
+	{}
+
+
+	LockstepTracker::LockstepTracker(System const& sys, config::AdaptiveMultiplePrecisionConfig const& amp_config) : system_(sys), amp_config_(amp_config)
+	{
+		if (!sys.HavePathVariable())
+			throw std::runtime_error("lockstep tracker requires a system with a path variable");
+	}
+
+
+	void LockstepTracker::Setup(double tracking_tolerance, double path_truncation_threshold,
+	                            config::Stepping<double> const& stepping, config::Newton const& newton)
+	{
+		tracking_tolerance_ = tracking_tolerance;
+		path_truncation_threshold_ = path_truncation_threshold;
+		stepping_ = stepping;
+		newton_ = newton;
+	}
+
+
+	namespace {
+
+		amp::PrecisionTier TierOf(dbl)
+		{
+			return amp::PrecisionTier::Double;
+		}
+
+		amp::PrecisionTier TierOf(dd_complex)
+		{
+			return amp::PrecisionTier::DoubleDouble;
+		}
+
+		double ToDouble(double x)
+		{
+			return x;
+		}
+
+		double ToDouble(dd_real const& x)
+		{
+			return static_cast<double>(x);
+		}
+
+	} // re: anonymous namespace
+
+
+	template<typename ComplexType>
+	std::vector<SuccessCode> LockstepTracker::Velocities(Mat<ComplexType> & velocities, Mat<ComplexType> const& points, Vec<ComplexType> const& times) const
+	{
+		using RealType = typename Eigen::NumTraits<ComplexType>::Real;
+		auto& w = std::get<Workspace<ComplexType> >(workspaces_);
+		system_.JacobianBatch(w.jacobians, w.function_values, w.time_derivatives, points, times);
+
+		velocities.resize(points.rows(), points.cols());
+		std::vector<SuccessCode> codes(points.cols(), SuccessCode::Success);
+		for (int kk = 0; kk < points.cols(); ++kk)
+		{
+			Eigen::PartialPivLU<Mat<ComplexType> > lu(w.jacobians[kk]);
+			velocities.col(kk) = -lu.solve(w.time_derivatives.col(kk));
+
+			if (!velocities.col(kk).allFinite())
+			{
+				codes[kk] = SuccessCode::MatrixSolveFailure;
+				continue;
+			}
+
+			// the criteria need only a few digits of the norms, so they are computed in double.  the 1-norm goes with the estimate of the reciprocal condition number in that norm.
+			const double norm_J = ToDouble(RealType(w.jacobians[kk].cwiseAbs().colwise().sum().maxCoeff()));
+			const double norm_J_inverse = 1/(ToDouble(RealType(lu.rcond()))*norm_J);
+			const double norm_z = ToDouble(RealType(points.col(kk).norm()));
+			if (amp::CheapestSufficientTier(norm_J, norm_J_inverse, norm_z, tracking_tolerance_, amp_config_) > TierOf(ComplexType()))
+				codes[kk] = SuccessCode::HigherPrecisionNecessary;
+		}
+		return codes;
+	}
+
+
+	std::vector<SuccessCode> LockstepTracker::TrackPaths(std::vector<Vec<dbl> > & endpoints,
+	                                                     dbl const& start_time, dbl const& end_time,
+	                                                     std::vector<Vec<dbl> > const& start_points) const
+	{
+		std::vector<dbl> times(start_points.size(), start_time);
+		return TrackPaths(endpoints, times, end_time, start_points);
+	}
+
+
+	template<typename ComplexType>
+	std::vector<SuccessCode> LockstepTracker::TrackPaths(std::vector<Vec<ComplexType> > & endpoints,
+	                                                     std::vector<ComplexType> & times, ComplexType const& end_time,
+	                                                     std::vector<Vec<ComplexType> > const& start_points) const
+	{
+		using RealType = typename Eigen::NumTraits<ComplexType>::Real;
+
+		const auto num_vars = system_.NumVariables();
+		for (const auto& p : start_points)
+			if (static_cast<size_t>(p.size())!=num_vars)
+				throw std::runtime_error("start point size must match the number of variables in the system to be tracked");
+		if (times.size()!=start_points.size())
+			throw std::runtime_error("lockstep tracker needs one start time per start point");
+
+		auto& w = std::get<Workspace<ComplexType> >(workspaces_);
+
+		endpoints = start_points;
+		std::vector<PathState<ComplexType> > states(start_points.size());
+		for (size_t ii = 0; ii < states.size(); ++ii)
+		{
+			states[ii].time = times[ii];
+			states[ii].step_size = stepping_.initial_step_size;
+		}
+
+		std::vector<size_t> active;
+		Mat<ComplexType> x, y, k1, k2, k3, k4;
+		Vec<ComplexType> t, dt;
+
+		while (true)
+		{
+			active.clear();
+			for (size_t ii = 0; ii < states.size(); ++ii)
+				if (states[ii].active)
+					active.push_back(ii);
+			if (active.empty())
+				break;
+
+			const auto num_active = active.size();
+			x.resize(num_vars, num_active);
+			t.resize(num_active);
+			dt.resize(num_active);
+			for (size_t jj = 0; jj < num_active; ++jj)
+			{
+				const auto& s = states[active[jj]];
+				x.col(jj) = endpoints[active[jj]];
+				t(jj) = s.time;
+
+				ComplexType remaining = end_time - s.time;
+				RealType distance = abs(remaining);
+				dt(jj) = distance < s.step_size ? remaining : remaining*(RealType(s.step_size)/distance);
+			}
+
+			std::vector<SuccessCode> codes(num_active, SuccessCode::Success);
+			auto merge = [&codes](std::vector<SuccessCode> const& more)
+				{
+					for (size_t jj = 0; jj < codes.size(); ++jj)
+						if (codes[jj]==SuccessCode::Success)
+							codes[jj] = more[jj];
+				};
+
+			// predict, by the classical fourth-order Runge-Kutta method, in each column with its own time step
+			const Vec<ComplexType> half_dt = dt/ComplexType(2);
+			const Vec<ComplexType> t_half = t + half_dt;
+			const Vec<ComplexType> t_next = t + dt;
+
+			merge(Velocities(k1, x, t));
+			y = x + k1*half_dt.asDiagonal();
+			merge(Velocities(k2, y, t_half));
+			y = x + k2*half_dt.asDiagonal();
+			merge(Velocities(k3, y, t_half));
+			y = x + k3*dt.asDiagonal();
+			merge(Velocities(k4, y, t_next));
+			y = x + (k1 + ComplexType(2)*k2 + ComplexType(2)*k3 + k4)*(dt/ComplexType(6)).asDiagonal();
+
+			// correct, by Newton's method, until each column converges or fails
+			std::vector<bool> converged(num_active, false);
+			for (unsigned ii = 0; ii < newton_.max_num_newton_iterations; ++ii)
+			{
+				system_.JacobianBatch(w.jacobians, w.function_values, w.time_derivatives, y, t_next);
+
+				bool all_done = true;
+				for (size_t jj = 0; jj < num_active; ++jj)
+				{
+					if (converged[jj] || codes[jj]!=SuccessCode::Success)
+						continue;
+
+					Eigen::PartialPivLU<Mat<ComplexType> > lu(w.jacobians[jj]);
+					Vec<ComplexType> delta = -lu.solve(w.function_values.col(jj));
+					if (!delta.allFinite())
+					{
+						codes[jj] = SuccessCode::MatrixSolveFailure;
+						continue;
+					}
+
+					y.col(jj) += delta;
+					if (delta.norm() < RealType(tracking_tolerance_) && ii+1 >= newton_.min_num_newton_iterations)
+						converged[jj] = true;
+					else
+						all_done = false;
+				}
+
+				if (all_done)
+					break;
+			}
+
+
+			for (size_t jj = 0; jj < num_active; ++jj)
+			{
+				const auto index = active[jj];
+				auto& s = states[index];
+				++s.num_steps;
+
+				if (codes[jj]==SuccessCode::HigherPrecisionNecessary)
+				{
+					s.code = codes[jj];
+					s.active = false;
+					continue;
+				}
+
+				if (codes[jj]==SuccessCode::Success && converged[jj])
+				{
+					endpoints[index] = y.col(jj);
+					s.time += dt(jj);
+
+					if (++s.num_consecutive_successes >= stepping_.consecutive_successful_steps_before_stepsize_increase)
+					{
+						s.step_size = std::min(s.step_size*stepping_.step_size_success_factor, stepping_.max_step_size);
+						s.num_consecutive_successes = 0;
+					}
+
+					if (endpoints[index].norm() > RealType(path_truncation_threshold_))
+					{
+						s.code = SuccessCode::GoingToInfinity;
+						s.active = false;
+					}
+					else if (IsSymmRelDiffSmall(s.time, end_time, Eigen::NumTraits<ComplexType>::epsilon()))
+					{
+						s.time = end_time;
+						s.active = false;
+					}
+				}
+				else
+				{
+					s.num_consecutive_successes = 0;
+					s.step_size *= stepping_.step_size_fail_factor;
+					if (s.step_size < stepping_.min_step_size)
+					{
+						s.code = SuccessCode::MinStepSizeReached;
+						s.active = false;
+					}
+				}
+
+				if (s.active && s.num_steps >= stepping_.max_num_steps)
+				{
+					s.code = SuccessCode::MaxNumStepsTaken;
+					s.active = false;
+				}
+			}
+		}
+
+		std::vector<SuccessCode> codes;
+		for (size_t ii = 0; ii < states.size(); ++ii)
+		{
+			codes.push_back(states[ii].code);
+			times[ii] = states[ii].time;
+		}
+		return codes;
+	}
+
+
+	template std::vector<SuccessCode> LockstepTracker::TrackPaths(std::vector<Vec<dbl> > &, std::vector<dbl> &, dbl const&, std::vector<Vec<dbl> > const&) const;
+	template std::vector<SuccessCode> LockstepTracker::TrackPaths(std::vector<Vec<dd_complex> > &, std::vector<dd_complex> &, dd_complex const&, std::vector<Vec<dd_complex> > const&) const;
+
+} // re: namespace tracking
+} // re: namespace bertini
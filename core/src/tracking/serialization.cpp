@@ -0,0 +1,114 @@
+//This file is part of Bertini 2.
+//
+//serialization.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//serialization.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with serialization.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+#include "bertini2/tracking/serialization.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+
+namespace bertini {
+namespace tracking {
+
+	std::string SaveSystem(System const& sys)
+	{
+		return Pack(sys);
+	}
+
+	std::string SaveSystem(start_system::TotalDegree const& sys)
+	{
+		return Pack(sys);
+	}
+
+	std::string SaveSystem(start_system::MHomogeneous const& sys)
+	{
+		return Pack(sys);
+	}
+
+	std::string SaveSystem(start_system::LinearProduct const& sys)
+	{
+		return Pack(sys);
+	}
+
+	std::string SaveSystem(start_system::Polyhedral const& sys)
+	{
+		return Pack(sys);
+	}
+
+	void LoadSystem(std::string const& serialized, System & sys)
+	{
+		Unpack(serialized, sys);
+	}
+
+	void LoadSystem(std::string const& serialized, start_system::TotalDegree & sys)
+	{
+		Unpack(serialized, sys);
+	}
+
+	void LoadSystem(std::string const& serialized, start_system::MHomogeneous & sys)
+	{
+		Unpack(serialized, sys);
+	}
+
+	void LoadSystem(std::string const& serialized, start_system::LinearProduct & sys)
+	{
+		Unpack(serialized, sys);
+	}
+
+	void LoadSystem(std::string const& serialized, start_system::Polyhedral & sys)
+	{
+		Unpack(serialized, sys);
+	}
+
+
+
+	void WriteFileAtomically(std::string const& filename, std::string const& contents)
+	{
+		const auto temporary = filename + ".tmp";
+		{
+			std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+			out.write(contents.data(), contents.size());
+			out.flush();
+			if (!out)
+				throw std::runtime_error("unable to write to file " + temporary);
+		}
+
+		if (std::rename(temporary.c_str(), filename.c_str())!=0)
+			throw std::runtime_error("unable to replace file " + filename);
+	}
+
+
+	std::string ReadFile(std::string const& filename)
+	{
+		std::ifstream in(filename, std::ios::binary);
+		if (!in)
+			throw std::runtime_error("unable to open file " + filename);
+
+		std::ostringstream contents;
+		contents << in.rdbuf();
+		return contents.str();
+	}
+
+} // re: namespace tracking
+} // re: namespace bertini
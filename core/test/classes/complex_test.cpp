@@ -25,6 +25,8 @@
 
 
 #include "bertini2/num_traits.hpp"
+#include "bertini2/limb_pool.hpp"
+#include "bertini2/double_double.hpp"
 #include <boost/test/unit_test.hpp>
 #include <fstream>
 
@@ -790,5 +792,60 @@ BOOST_AUTO_TEST_CASE(mpfr_float_serialization2)
 	
 }
 
+
+BOOST_AUTO_TEST_CASE(limb_pool_serves_fixed_precision_arithmetic)
+{
+	DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	bertini::EnableLimbPool();
+	BOOST_CHECK(bertini::LimbPoolEnabled());
+
+	bertini::complex z("0.1","1.2"), v("0.2","1.3"), r1, r2;
+	auto churn = [&z, &v](bertini::complex & r)
+		{
+			for (unsigned ii = 0; ii < 100; ++ii)
+				r = z*v + z/v - exp(z)*v;
+		};
+
+	churn(r1); // warms the pool
+	auto misses = bertini::LimbPoolMisses();
+	churn(r2);
+
+	BOOST_CHECK_EQUAL(bertini::LimbPoolMisses(), misses);
+	BOOST_CHECK(abs(r1-r2) < threshold_clearance_mp);
+
+	bertini::DisableLimbPool();
+	BOOST_CHECK(!bertini::LimbPoolEnabled());
+}
+
+
+BOOST_AUTO_TEST_CASE(double_double_agrees_with_mpfr_to_thirty_digits)
+{
+	using bertini::dd_real;
+	DefaultPrecision(50);
+
+	mpfr_float two(2), a("1.5"), b("0.7"), c("3");
+	dd_real two_dd(two), a_dd(a), b_dd(b), c_dd(c);
+
+	auto check = [](dd_real const& x, mpfr_float const& expected)
+		{
+			BOOST_CHECK(abs(mpfr_float(x) - expected) < abs(expected)*mpfr_float("1e-30"));
+		};
+
+	check(sqrt(two_dd), sqrt(two));
+	check(exp(a_dd), exp(a));
+	check(log(c_dd), log(c));
+	check(sin(b_dd), sin(b));
+	check(cos(b_dd), cos(b));
+	check(atan2(b_dd, c_dd), atan2(b, c));
+	check(pow(a_dd, 7), pow(a, 7));
+	check(a_dd/c_dd, a/c);
+
+	bertini::dd_complex z(a_dd, b_dd), w(c_dd, -two_dd);
+	bertini::complex z_mp(a, b), w_mp(c, -two), product;
+	bertini::FromDoubleDouble(z*w, product);
+	BOOST_CHECK(abs(product - z_mp*w_mp) < mpfr_float("1e-30"));
+	BOOST_CHECK_EQUAL(bertini::Precision(z), 32);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
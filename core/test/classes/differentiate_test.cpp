@@ -1238,4 +1238,61 @@ BOOST_AUTO_TEST_CASE(integer_power_system)
 	BOOST_CHECK(abs( imag(J(0,0)) - mpfr_float("0.871779788708134710447396396772")) < threshold_clearance_mp);
 }
 
+
+
+/**
+\class bertini::System
+\test \b automatic_differentiation_matches_symbolic Confirms that the Jacobian and time derivatives computed by forward- and reverse-mode automatic differentiation agree with those from the symbolic Jacobian trees, in double and multiple precision.
+*/
+BOOST_AUTO_TEST_CASE(automatic_differentiation_matches_symbolic)
+{
+	using System = bertini::System;
+	using JacobianMethod = bertini::JacobianMethod;
+
+	DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+
+	std::string str = "variable_group x, y, z; function f1, f2, f3; pathvariable t; parameter s; s = t^2; g = x*y/z; f1 = (x^3*y - z)^2*(1-s) + s*exp(g) - log(y+3); f2 = sin(g)*cos(x) + tan(z/5)*t - sqrt(x+y+4)*g^2; f3 = x*y*z + exp(z*t) - (x+y)^4/(z-2);";
+
+	System sys;
+	std::string::const_iterator iter = str.begin();
+	std::string::const_iterator end = str.end();
+	bertini::SystemParser<std::string::const_iterator> S;
+	phrase_parse(iter, end, S, boost::spirit::ascii::space, sys);
+
+	bertini::Vec<dbl> v_d(3);
+	v_d << xnum_dbl, ynum_dbl, znum_dbl;
+	dbl t_d(0.3,0.2);
+
+	bertini::Vec<mpfr> v_mp(3);
+	v_mp << mpfr(xstr_real,xstr_imag), mpfr(ystr_real,ystr_imag), mpfr(zstr_real,zstr_imag);
+	mpfr t_mp("0.3","0.2");
+
+	auto J_symbolic_d = sys.Jacobian(v_d, t_d);
+	auto dt_symbolic_d = sys.TimeDerivative(v_d, t_d);
+	auto J_symbolic_mp = sys.Jacobian(v_mp, t_mp);
+	auto dt_symbolic_mp = sys.TimeDerivative(v_mp, t_mp);
+
+	for (auto method : {JacobianMethod::ForwardMode, JacobianMethod::ReverseMode})
+	{
+		sys.SetJacobianMethod(method);
+
+		auto J_ad_d = sys.Jacobian(v_d, t_d);
+		auto dt_ad_d = sys.TimeDerivative(v_d, t_d);
+		auto J_ad_mp = sys.Jacobian(v_mp, t_mp);
+		auto dt_ad_mp = sys.TimeDerivative(v_mp, t_mp);
+
+		// the entries are large, so the comparison is relative
+		for (unsigned ii = 0; ii < 3; ++ii)
+		{
+			BOOST_CHECK(abs(dt_symbolic_d(ii) - dt_ad_d(ii)) < relaxed_threshold_clearance_d*abs(dt_symbolic_d(ii)));
+			BOOST_CHECK(abs(dt_symbolic_mp(ii) - dt_ad_mp(ii)) < threshold_clearance_mp*abs(dt_symbolic_mp(ii)));
+			for (unsigned jj = 0; jj < 3; ++jj)
+			{
+				BOOST_CHECK(abs(J_symbolic_d(ii,jj) - J_ad_d(ii,jj)) < relaxed_threshold_clearance_d*abs(J_symbolic_d(ii,jj)));
+				BOOST_CHECK(abs(J_symbolic_mp(ii,jj) - J_ad_mp(ii,jj)) < threshold_clearance_mp*abs(J_symbolic_mp(ii,jj)));
+			}
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -533,6 +533,29 @@ BOOST_AUTO_TEST_SUITE(kahan_matrix_solving_LU)
 		BOOST_CHECK_EQUAL(A(0,0).precision(),100);
 	}
 
+	BOOST_AUTO_TEST_CASE(estimate_inverse_norm_from_lu)
+	{
+		using dbl = std::complex<double>;
+		using mpfr = bertini::complex;
+		const unsigned size = 10;
+
+		// the Kahan matrix is badly conditioned, with norm of inverse in the thousands
+		Eigen::Matrix<dbl, Eigen::Dynamic, Eigen::Dynamic> A = KahanMatrix(size, dbl(0.285));
+		Eigen::Matrix<dbl, Eigen::Dynamic, 1> x, y;
+		double exact = A.inverse().cwiseAbs().colwise().sum().maxCoeff();
+		double estimate = bertini::EstimateInverseNorm(A.lu(), x, y);
+		BOOST_CHECK(estimate <= exact*(1+1e-10));
+		BOOST_CHECK(estimate >= exact/3);
+
+		mpfr_float::default_precision(50);
+		Eigen::Matrix<mpfr, Eigen::Dynamic, Eigen::Dynamic> B = KahanMatrix(size, mpfr("0.285","0.0"));
+		Eigen::Matrix<mpfr, Eigen::Dynamic, 1> u, v;
+		mpfr_float exact_mp = B.inverse().cwiseAbs().colwise().sum().maxCoeff();
+		mpfr_float estimate_mp = bertini::EstimateInverseNorm(B.lu(), u, v);
+		BOOST_CHECK(estimate_mp <= exact_mp*(1+mpfr_float("1e-40")));
+		BOOST_CHECK(estimate_mp >= exact_mp/3);
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 	
@@ -487,6 +487,23 @@ BOOST_AUTO_TEST_CASE(not_homogeneous_summands_inhomogeneous)
 }
 
 
+BOOST_AUTO_TEST_CASE(homogenize_power_of_sum)
+{
+	Var x = std::make_shared<bertini::node::Variable>("x");
+	Var y = std::make_shared<bertini::node::Variable>("y");
+	Var h = std::make_shared<bertini::node::Variable>("h");
+
+	VariableGroup vars{x,y};
+
+	auto f1 = pow(2*x+3*y,2) - 1;
+	BOOST_CHECK_EQUAL(f1->Degree(vars), 2);
+
+	f1->Homogenize(vars, h);
+	BOOST_CHECK(f1->IsHomogeneous());
+	BOOST_CHECK_EQUAL(f1->Degree(h), 2);
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -84,5 +84,27 @@ BOOST_AUTO_TEST_CASE(slice_basic_real)
 }
 
 
+BOOST_AUTO_TEST_CASE(slice_linear_evaluates_as_the_slice)
+{
+	Var x = std::make_shared<bertini::node::Variable>("x"), y = std::make_shared<bertini::node::Variable>("y"), z = std::make_shared<bertini::node::Variable>("z");
+
+	VariableGroup vars{x,y,z};
+
+	Vec<dbl> v(3);
+	v << dbl(0.5,-1), dbl(2,0.25), dbl(-0.75,1.5);
+	x->set_current_value<dbl>(v(0));
+	y->set_current_value<dbl>(v(1));
+	z->set_current_value<dbl>(v(2));
+
+	for (bool homogeneous : {false, true})
+	{
+		auto s = LinearSlice::RandomComplex(vars,2,homogeneous);
+		auto values = s.Eval(v);
+		for (unsigned ii=0; ii<s.Dimension(); ++ii)
+			BOOST_CHECK(abs(s.Linear(ii)->Eval<dbl>() - values(ii)) < 1e-14);
+	}
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
 
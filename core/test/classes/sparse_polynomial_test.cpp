@@ -0,0 +1,209 @@
+//This file is part of Bertini 2.
+//
+//sparse_polynomial_test.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//sparse_polynomial_test.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with sparse_polynomial_test.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+/**
+\file sparse_polynomial_test.cpp Unit testing for the bertini::SparsePolynomialSystem class, and evaluation of polynomial Systems through it.
+*/
+
+#include <boost/test/unit_test.hpp>
+
+#include "bertini2/system.hpp"
+#include "bertini2/system_parsing.hpp"
+
+using System = bertini::System;
+using EvalMethod = bertini::EvalMethod;
+using bertini::DefaultPrecision;
+
+using mpfr_float = bertini::mpfr_float;
+using dbl = bertini::dbl;
+using mpfr = bertini::mpfr;
+
+extern double relaxed_threshold_clearance_d;
+extern bertini::mpfr_float threshold_clearance_mp;
+extern unsigned CLASS_TEST_MPFR_DEFAULT_DIGITS;
+
+
+template<typename NumType> using Vec = bertini::Vec<NumType>;
+template<typename NumType> using Mat = bertini::Mat<NumType>;
+
+
+namespace {
+
+	System ParseSystem(std::string const& str)
+	{
+		System sys;
+		std::string::const_iterator iter = str.begin();
+		std::string::const_iterator end = str.end();
+		bertini::SystemParser<std::string::const_iterator> S;
+		phrase_parse(iter, end, S, boost::spirit::ascii::space, sys);
+		return sys;
+	}
+
+	// polynomial in x, y, and t, through a subfunction, an explicit parameter, products of sums, powers, and division by a constant
+	const std::string polynomial_system = "variable_group x, y; function f1, f2; pathvariable t; parameter s; s = t; g = x*y - 1; f1 = (x + 2*y)^3 - (1-s)*g + pi*y/3; f2 = g^2*(x - t) + 2.5*y*t + sqrt(2)*x^4;";
+}
+
+
+BOOST_AUTO_TEST_SUITE(sparse_polynomial)
+
+
+/**
+\class bertini::SparsePolynomialSystem
+\test \b sparse_polynomial_eval_matches_tree_double Confirms that evaluation of the expanded polynomials, their Jacobian, and time derivatives matches tree evaluation, in double precision.
+*/
+BOOST_AUTO_TEST_CASE(sparse_polynomial_eval_matches_tree_double)
+{
+	System sys = ParseSystem(polynomial_system);
+
+	Vec<dbl> values(2);
+	values << dbl(0.3,-1.2), dbl(-0.7,0.4);
+	dbl t(0.4,0.1);
+
+	sys.SetEvalMethod(EvalMethod::FunctionTree);
+	auto f_tree = sys.Eval(values, t);
+	auto J_tree = sys.Jacobian(values, t);
+	auto dt_tree = sys.TimeDerivative(values, t);
+
+	sys.SetEvalMethod(EvalMethod::Polynomial);
+	auto f_poly = sys.Eval(values, t);
+	auto J_poly = sys.Jacobian(values, t);
+	auto dt_poly = sys.TimeDerivative(values, t);
+
+	for (unsigned ii = 0; ii < 2; ++ii)
+	{
+		BOOST_CHECK(abs(f_tree(ii) - f_poly(ii)) < relaxed_threshold_clearance_d);
+		BOOST_CHECK(abs(dt_tree(ii) - dt_poly(ii)) < relaxed_threshold_clearance_d);
+		for (unsigned jj = 0; jj < 2; ++jj)
+			BOOST_CHECK(abs(J_tree(ii,jj) - J_poly(ii,jj)) < relaxed_threshold_clearance_d);
+	}
+
+	// functions asked for after derivatives at the same point come from the same pass
+	values << dbl(-1.1,0.2), dbl(0.5,0.5);
+	J_poly = sys.Jacobian(values, t);
+	f_poly = sys.Eval(values, t);
+	sys.SetEvalMethod(EvalMethod::FunctionTree);
+	f_tree = sys.Eval(values, t);
+	for (unsigned ii = 0; ii < 2; ++ii)
+		BOOST_CHECK(abs(f_tree(ii) - f_poly(ii)) < relaxed_threshold_clearance_d);
+}
+
+
+/**
+\class bertini::SparsePolynomialSystem
+\test \b sparse_polynomial_eval_matches_tree_mpfr Confirms that evaluation of the expanded polynomials matches tree evaluation in multiple precision, at the default precision, after raising the precision of the system, and after returning to the default.
+*/
+BOOST_AUTO_TEST_CASE(sparse_polynomial_eval_matches_tree_mpfr)
+{
+	DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	System sys = ParseSystem(polynomial_system);
+
+	Vec<mpfr> values(2);
+	values << mpfr("0.3","-1.2"), mpfr("-0.7","0.4");
+	mpfr t("0.4","0.1");
+
+	sys.SetEvalMethod(EvalMethod::FunctionTree);
+	auto f_tree = sys.Eval(values, t);
+	auto J_tree = sys.Jacobian(values, t);
+	auto dt_tree = sys.TimeDerivative(values, t);
+
+	sys.SetEvalMethod(EvalMethod::Polynomial);
+	auto f_poly = sys.Eval(values, t);
+	auto J_poly = sys.Jacobian(values, t);
+	auto dt_poly = sys.TimeDerivative(values, t);
+
+	for (unsigned ii = 0; ii < 2; ++ii)
+	{
+		BOOST_CHECK(abs(f_tree(ii) - f_poly(ii)) < threshold_clearance_mp);
+		BOOST_CHECK(abs(dt_tree(ii) - dt_poly(ii)) < threshold_clearance_mp);
+		for (unsigned jj = 0; jj < 2; ++jj)
+			BOOST_CHECK(abs(J_tree(ii,jj) - J_poly(ii,jj)) < threshold_clearance_mp);
+	}
+	auto f_poly_default = f_poly;
+
+
+	// now go up in precision, and make sure the coefficients came along
+	unsigned higher_precision = 2*CLASS_TEST_MPFR_DEFAULT_DIGITS;
+	DefaultPrecision(higher_precision);
+	sys.precision(higher_precision);
+
+	Vec<mpfr> values_higher(2);
+	values_higher << mpfr("0.3","-1.2"), mpfr("-0.7","0.4");
+	mpfr t_higher("0.4","0.1");
+
+	f_poly = sys.Eval(values_higher, t_higher);
+	sys.SetEvalMethod(EvalMethod::FunctionTree);
+	f_tree = sys.Eval(values_higher, t_higher);
+
+	BOOST_CHECK_EQUAL(f_poly(0).precision(), higher_precision);
+	for (unsigned ii = 0; ii < 2; ++ii)
+		BOOST_CHECK(abs(f_tree(ii) - f_poly(ii)) < mpfr_float("1e-" + std::to_string(higher_precision-3)));
+
+
+	// and back down, to the coefficients kept from before
+	DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	sys.precision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	sys.SetEvalMethod(EvalMethod::Polynomial);
+
+	auto f_again = sys.Eval(values, t);
+	for (unsigned ii = 0; ii < 2; ++ii)
+		BOOST_CHECK(f_again(ii)==f_poly_default(ii));
+}
+
+
+/**
+\class bertini::SparsePolynomialSystem
+\test \b sparse_polynomial_fallback_for_nonpolynomial Confirms that a system not polynomial in its variables is evaluated through its trees by default, and that asking for polynomial evaluation of it throws.  Transcendental functions of constants alone are polynomial.
+*/
+BOOST_AUTO_TEST_CASE(sparse_polynomial_fallback_for_nonpolynomial)
+{
+	System sys = ParseSystem("variable_group x, y; function f1, f2; f1 = x^2 + exp(x)*y; f2 = sin(2)*y - 1/x;");
+
+	Vec<dbl> values(2);
+	values << dbl(0.3,-1.2), dbl(-0.7,0.4);
+
+	BOOST_CHECK(sys.GetEvalMethod()==EvalMethod::Automatic);
+	auto f_auto = sys.Eval(values);
+	auto J_auto = sys.Jacobian(values);
+
+	sys.SetEvalMethod(EvalMethod::FunctionTree);
+	auto f_tree = sys.Eval(values);
+	auto J_tree = sys.Jacobian(values);
+
+	for (unsigned ii = 0; ii < 2; ++ii)
+	{
+		BOOST_CHECK(abs(f_tree(ii) - f_auto(ii)) < relaxed_threshold_clearance_d);
+		for (unsigned jj = 0; jj < 2; ++jj)
+			BOOST_CHECK(abs(J_tree(ii,jj) - J_auto(ii,jj)) < relaxed_threshold_clearance_d);
+	}
+
+	sys.SetEvalMethod(EvalMethod::Polynomial);
+	BOOST_CHECK_THROW(sys.Eval(values), std::runtime_error);
+
+	System polynomial = ParseSystem("variable_group x, y; function f1, f2; f1 = x^2 + exp(1)*y; f2 = sin(2)*y - x/3;");
+	polynomial.SetEvalMethod(EvalMethod::Polynomial);
+	BOOST_CHECK_NO_THROW(polynomial.Eval(values));
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -28,6 +28,14 @@
 
 
 #include "bertini2/start_system.hpp"
+#include "bertini2/tracking/solve.hpp"
+#include "bertini2/tracking/distributed_solve.hpp"
+#include "bertini2/tracking/polyhedral_homotopy.hpp"
+#include "bertini2/tracking/parameter_homotopy.hpp"
+#include "bertini2/tracking/regeneration.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
 
 using System = bertini::System;
 
@@ -418,6 +426,706 @@ BOOST_AUTO_TEST_CASE(total_degree_start_system_coefficient_bound_degree_bound)
 }
 
 
+BOOST_AUTO_TEST_CASE(solve_total_degree_in_parallel)
+{
+	using namespace bertini::tracking;
+
+	bertini::System sys;
+	Var x = std::make_shared<bertini::node::Variable>("x"), y = std::make_shared<bertini::node::Variable>("y");
+
+	sys.AddVariableGroup(VariableGroup{x,y});
+	sys.AddFunction(pow(x,2) - 1);
+	sys.AddFunction(pow(y,3) - 8*x);
+	sys.Homogenize();
+	sys.AutoPatch();
+
+	bertini::start_system::TotalDegree TD(sys);
+	TD.Homogenize();
+
+	config::Solver<double> settings;
+	settings.num_threads = 3;
+
+	auto results = Solve<DoublePrecisionTracker>(sys, TD, settings);
+
+	BOOST_CHECK_EQUAL(results.size(), 6);
+
+	// x = 1, y^3 = 8;  x = -1, y^3 = -8
+	std::vector<Vec<dbl> > expected;
+	for (unsigned ii = 0; ii < 3; ++ii)
+	{
+		dbl cube_root_of_unity = std::polar(1.0, 2*M_PI*ii/3);
+		Vec<dbl> p(2), m(2);
+		p << dbl(1), dbl(2)*cube_root_of_unity;
+		m << dbl(-1), dbl(-2)*cube_root_of_unity;
+		expected.push_back(p);
+		expected.push_back(m);
+	}
+
+	std::vector<unsigned> times_found(expected.size(), 0);
+	for (unsigned ii = 0; ii < results.size(); ++ii)
+	{
+		const auto& r = results[ii];
+		BOOST_CHECK_EQUAL(r.start_index, ii);
+		BOOST_CHECK(r.tracking_success==SuccessCode::Success);
+		BOOST_CHECK(r.endgame_success==SuccessCode::Success);
+		BOOST_REQUIRE_EQUAL(r.solution.size(), 2);
+		for (unsigned jj = 0; jj < expected.size(); ++jj)
+			if ((r.solution - expected[jj]).norm() < 1e-8)
+				++times_found[jj];
+	}
+
+	for (auto n : times_found)
+		BOOST_CHECK_EQUAL(n, 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(distributed_solve_survives_worker_crash)
+{
+	using namespace bertini::tracking;
+
+	bertini::System sys;
+	Var x = std::make_shared<bertini::node::Variable>("x"), y = std::make_shared<bertini::node::Variable>("y");
+
+	sys.AddVariableGroup(VariableGroup{x,y});
+	sys.AddFunction(pow(x,2) - 1);
+	sys.AddFunction(pow(y,3) - 8*x);
+	sys.Homogenize();
+	sys.AutoPatch();
+
+	bertini::start_system::TotalDegree TD(sys);
+	TD.Homogenize();
+
+	config::Distributed<double> settings;
+	settings.num_workers = 3;
+	settings.batch_size = 2;
+
+	// the first worker to reach path 3 makes the marker file, and dies.  the batch is handed out again, to a worker which finds the marker.
+	char marker[] = "/tmp/b2_distributed_solve_XXXXXX";
+	close(mkstemp(marker));
+	unlink(marker);
+	auto crash_once = [&marker](unsigned long long index)
+		{
+			if (index==3 && open(marker, O_CREAT | O_EXCL | O_WRONLY, 0600)>=0)
+				_exit(1);
+		};
+
+	auto results = DistributedSolve<DoublePrecisionTracker>(sys, TD, settings, crash_once);
+
+	BOOST_CHECK_EQUAL(access(marker, F_OK), 0);
+	unlink(marker);
+
+	BOOST_CHECK_EQUAL(results.size(), 6);
+
+	// x = 1, y^3 = 8;  x = -1, y^3 = -8
+	std::vector<Vec<dbl> > expected;
+	for (unsigned ii = 0; ii < 3; ++ii)
+	{
+		dbl cube_root_of_unity = std::polar(1.0, 2*M_PI*ii/3);
+		Vec<dbl> p(2), m(2);
+		p << dbl(1), dbl(2)*cube_root_of_unity;
+		m << dbl(-1), dbl(-2)*cube_root_of_unity;
+		expected.push_back(p);
+		expected.push_back(m);
+	}
+
+	std::vector<unsigned> times_found(expected.size(), 0);
+	for (unsigned ii = 0; ii < results.size(); ++ii)
+	{
+		const auto& r = results[ii];
+		BOOST_CHECK_EQUAL(r.start_index, ii);
+		BOOST_CHECK(r.tracking_success==SuccessCode::Success);
+		BOOST_CHECK(r.endgame_success==SuccessCode::Success);
+		BOOST_REQUIRE_EQUAL(r.solution.size(), 2);
+		for (unsigned jj = 0; jj < expected.size(); ++jj)
+			if ((r.solution - expected[jj]).norm() < 1e-8)
+				++times_found[jj];
+	}
+
+	for (auto n : times_found)
+		BOOST_CHECK_EQUAL(n, 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(resume_solve_tracks_only_unfinished_paths)
+{
+	using namespace bertini::tracking;
+
+	bertini::System sys;
+	Var x = std::make_shared<bertini::node::Variable>("x"), y = std::make_shared<bertini::node::Variable>("y");
+
+	sys.AddVariableGroup(VariableGroup{x,y});
+	sys.AddFunction(pow(x,2) - 1);
+	sys.AddFunction(pow(y,3) - 8*x);
+	sys.Homogenize();
+	sys.AutoPatch();
+
+	bertini::start_system::TotalDegree TD(sys);
+	TD.Homogenize();
+
+	char checkpoint_file[] = "/tmp/b2_checkpoint_XXXXXX";
+	close(mkstemp(checkpoint_file));
+
+	config::Solver<double> settings;
+	settings.num_threads = 2;
+	settings.checkpoint_file = checkpoint_file;
+	settings.checkpoint_interval = 0;
+
+	Solve<DoublePrecisionTracker>(sys, TD, settings);
+
+	// pretend the process died with paths 1 and 4 in flight, and mark path 0, to see that it is not tracked again
+	SolveCheckpoint<dbl> progress;
+	Unpack(ReadFile(checkpoint_file), progress);
+	BOOST_REQUIRE_EQUAL(progress.finished.size(), 6);
+	for (auto f : progress.finished)
+		BOOST_CHECK(f);
+
+	progress.finished[1] = progress.finished[4] = false;
+	progress.results[1] = progress.results[4] = SolveResult<dbl>();
+	progress.results[0].cycle_number = 42;
+	WriteFileAtomically(checkpoint_file, Pack(progress));
+
+	auto results = ResumeSolve<DoublePrecisionTracker>(settings);
+	unlink(checkpoint_file);
+
+	BOOST_REQUIRE_EQUAL(results.size(), 6);
+	BOOST_CHECK_EQUAL(results[0].cycle_number, 42);
+
+	// x = 1, y^3 = 8;  x = -1, y^3 = -8
+	std::vector<Vec<dbl> > expected;
+	for (unsigned ii = 0; ii < 3; ++ii)
+	{
+		dbl cube_root_of_unity = std::polar(1.0, 2*M_PI*ii/3);
+		Vec<dbl> p(2), m(2);
+		p << dbl(1), dbl(2)*cube_root_of_unity;
+		m << dbl(-1), dbl(-2)*cube_root_of_unity;
+		expected.push_back(p);
+		expected.push_back(m);
+	}
+
+	std::vector<unsigned> times_found(expected.size(), 0);
+	for (unsigned ii = 0; ii < results.size(); ++ii)
+	{
+		const auto& r = results[ii];
+		BOOST_CHECK_EQUAL(r.start_index, ii);
+		BOOST_CHECK(r.tracking_success==SuccessCode::Success);
+		BOOST_CHECK(r.endgame_success==SuccessCode::Success);
+		BOOST_REQUIRE_EQUAL(r.solution.size(), 2);
+		for (unsigned jj = 0; jj < expected.size(); ++jj)
+			if ((r.solution - expected[jj]).norm() < 1e-8)
+				++times_found[jj];
+	}
+
+	for (auto n : times_found)
+		BOOST_CHECK_EQUAL(n, 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(solve_in_lockstep_bundles_finds_all_solutions)
+{
+	using namespace bertini::tracking;
+
+	bertini::System sys;
+	Var x = std::make_shared<bertini::node::Variable>("x"), y = std::make_shared<bertini::node::Variable>("y");
+
+	sys.AddVariableGroup(VariableGroup{x,y});
+	sys.AddFunction(pow(x,2) - 1);
+	sys.AddFunction(pow(y,3) - 8*x);
+	sys.Homogenize();
+	sys.AutoPatch();
+
+	bertini::start_system::TotalDegree TD(sys);
+	TD.Homogenize();
+
+	config::Solver<double> settings;
+	settings.num_threads = 1;
+	settings.bundle_size = 4;
+
+	// all the paths of the bundle reach the boundary, none by falling back to the regular tracker
+	auto homotopy = GammaTrickHomotopy(sys, TD);
+	LockstepTracker lockstep(homotopy);
+	lockstep.Setup(settings.tolerances.newton_before_endgame, settings.tolerances.path_truncation_threshold, settings.stepping, settings.newton);
+
+	std::vector<Vec<dbl> > start_points, boundary_points;
+	for (unsigned ii = 0; ii < TD.NumStartPoints(); ++ii)
+		start_points.push_back(TD.StartPoint<dbl>(ii));
+	auto codes = lockstep.TrackPaths(boundary_points, dbl(1), dbl(settings.endgame_boundary), start_points);
+	BOOST_REQUIRE_EQUAL(codes.size(), 6);
+	for (auto c : codes)
+		BOOST_CHECK(c==SuccessCode::Success);
+
+	auto results = Solve<DoublePrecisionTracker>(sys, TD, settings);
+	BOOST_REQUIRE_EQUAL(results.size(), 6);
+
+	std::vector<Vec<dbl> > expected;
+	for (unsigned ii = 0; ii < 3; ++ii)
+	{
+		dbl cube_root_of_unity = std::polar(1.0, 2*M_PI*ii/3);
+		Vec<dbl> p(2), m(2);
+		p << dbl(1), dbl(2)*cube_root_of_unity;
+		m << dbl(-1), dbl(-2)*cube_root_of_unity;
+		expected.push_back(p);
+		expected.push_back(m);
+	}
+
+	std::vector<unsigned> times_found(expected.size(), 0);
+	for (unsigned ii = 0; ii < results.size(); ++ii)
+	{
+		const auto& r = results[ii];
+		BOOST_CHECK_EQUAL(r.start_index, ii);
+		BOOST_CHECK(r.tracking_success==SuccessCode::Success);
+		BOOST_CHECK(r.endgame_success==SuccessCode::Success);
+		BOOST_REQUIRE_EQUAL(r.solution.size(), 2);
+		for (unsigned jj = 0; jj < expected.size(); ++jj)
+			if ((r.solution - expected[jj]).norm() < 1e-8)
+				++times_found[jj];
+	}
+
+	for (auto n : times_found)
+		BOOST_CHECK_EQUAL(n, 1);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(lockstep_continues_in_double_double_when_double_is_not_enough)
+{
+	using namespace bertini::tracking;
+
+	bertini::System sys;
+	Var x = std::make_shared<bertini::node::Variable>("x"), y = std::make_shared<bertini::node::Variable>("y");
+
+	sys.AddVariableGroup(VariableGroup{x,y});
+	sys.AddFunction(pow(x,2) - 1);
+	sys.AddFunction(pow(y,3) - 8*x);
+	sys.Homogenize();
+	sys.AutoPatch();
+
+	bertini::start_system::TotalDegree TD(sys);
+	TD.Homogenize();
+	auto homotopy = GammaTrickHomotopy(sys, TD);
+
+	// a tolerance too tight for double precision, by Criterion C
+	LockstepTracker lockstep(homotopy);
+	lockstep.Setup(1e-18, 1e5, config::Stepping<double>(), config::Newton());
+
+	std::vector<Vec<dbl> > start_points, boundary_points;
+	for (unsigned ii = 0; ii < TD.NumStartPoints(); ++ii)
+		start_points.push_back(TD.StartPoint<dbl>(ii));
+	std::vector<dbl> times(start_points.size(), dbl(1));
+	auto codes = lockstep.TrackPaths(boundary_points, times, dbl(0.1), start_points);
+	for (auto c : codes)
+		BOOST_CHECK(c==SuccessCode::HigherPrecisionNecessary);
+
+	std::vector<Vec<bertini::dd_complex> > dd_start_points, dd_boundary_points;
+	for (const auto& p : start_points)
+		dd_start_points.push_back(p.unaryExpr([](dbl const& z){ return bertini::ToDoubleDouble(z); }));
+	std::vector<bertini::dd_complex> dd_times(start_points.size(), bertini::dd_complex(1));
+	auto dd_codes = lockstep.TrackPaths(dd_boundary_points, dd_times, bertini::dd_complex(0.1), dd_start_points);
+	for (unsigned ii = 0; ii < dd_codes.size(); ++ii)
+	{
+		BOOST_CHECK(dd_codes[ii]==SuccessCode::Success);
+		BOOST_CHECK(dd_times[ii]==bertini::dd_complex(0.1));
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE(mhomogeneous_start_points_bilinear)
+{
+	bertini::System sys;
+	Var x1 = std::make_shared<bertini::node::Variable>("x1"), x2 = std::make_shared<bertini::node::Variable>("x2");
+	Var y1 = std::make_shared<bertini::node::Variable>("y1"), y2 = std::make_shared<bertini::node::Variable>("y2");
+
+	sys.AddVariableGroup(VariableGroup{x1,x2});
+	sys.AddVariableGroup(VariableGroup{y1,y2});
+	for (int ii = 0; ii < 4; ++ii)
+		sys.AddFunction((ii+2)*x1*y1 - (2*ii+1)*x1*y2 + (3-ii)*x2*y1 + (ii*ii+1)*x2*y2 + (ii+5)*x1 - (7-ii)*y2 + (2*ii-3));
+
+	BOOST_CHECK_THROW(bertini::start_system::TotalDegree TD(sys), std::runtime_error);
+
+	bertini::start_system::MHomogeneous MH(sys);
+
+	// 16 by the total degree, but the 2-homogeneous Bezout number is 4 choose 2
+	BOOST_CHECK_EQUAL(MH.NumStartPoints(), 6);
+	BOOST_CHECK_EQUAL(MH.GroupDegrees()[0][1], 1);
+
+	std::vector<Vec<dbl> > start_points;
+	for (mpz_int ii = 0; ii < MH.NumStartPoints(); ++ii)
+	{
+		auto start = MH.StartPoint<dbl>(ii);
+		auto function_values = MH.Eval(start);
+
+		for (size_t jj = 0; jj < function_values.size(); ++jj)
+			BOOST_CHECK(abs(function_values(jj)) < 1e-12);
+
+		for (const auto& p : start_points)
+			BOOST_CHECK((p-start).norm() > 1e-6);
+		start_points.push_back(start);
+	}
+
+	BOOST_CHECK_THROW(MH.StartPoint<dbl>(6), std::out_of_range);
+
+	bertini::DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	MH.precision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+
+	for (mpz_int ii = 0; ii < MH.NumStartPoints(); ++ii)
+	{
+		auto start = MH.StartPoint<mpfr>(ii);
+		auto function_values = MH.Eval(start);
+
+		for (size_t jj = 0; jj < function_values.size(); ++jj)
+			BOOST_CHECK(abs(function_values(jj)) < threshold_clearance_mp);
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE(solve_bilinear_with_mhomogeneous_start_system)
+{
+	using namespace bertini::tracking;
+
+	bertini::System sys;
+	Var x1 = std::make_shared<bertini::node::Variable>("x1"), x2 = std::make_shared<bertini::node::Variable>("x2");
+	Var y1 = std::make_shared<bertini::node::Variable>("y1"), y2 = std::make_shared<bertini::node::Variable>("y2");
+
+	sys.AddVariableGroup(VariableGroup{x1,x2});
+	sys.AddVariableGroup(VariableGroup{y1,y2});
+
+	// two finite solutions, (-2,1,-2,-3) and (-2/5,1/5,-6,5).  the other four of the 2-homogeneous bound are at infinity
+	sys.AddFunction(x1*y1 + x1 - 2);
+	sys.AddFunction(x1*y2 + y2 - 3);
+	sys.AddFunction(x2*y1 + x2 + 1);
+	sys.AddFunction(x2*y2 + y1 + 5);
+
+	sys.Homogenize();
+	sys.AutoPatch();
+
+	bertini::start_system::MHomogeneous MH(sys);
+	BOOST_CHECK(MH.IsHomogeneous());
+	BOOST_CHECK(MH.IsPatched());
+	BOOST_REQUIRE_EQUAL(MH.NumStartPoints(), 6);
+
+	for (mpz_int ii = 0; ii < MH.NumStartPoints(); ++ii)
+		BOOST_CHECK(MH.Eval(MH.StartPoint<dbl>(ii)).norm() < 1e-12);
+
+	config::Solver<double> settings;
+	settings.num_threads = 2;
+
+	auto results = Solve<DoublePrecisionTracker>(sys, MH, settings);
+	BOOST_REQUIRE_EQUAL(results.size(), 6);
+
+	Vec<dbl> first(4), second(4);
+	first << dbl(-2), dbl(1), dbl(-2), dbl(-3);
+	second << dbl(-0.4), dbl(0.2), dbl(-6), dbl(5);
+
+	unsigned num_first = 0, num_second = 0;
+	for (const auto& r : results)
+	{
+		BOOST_CHECK(r.tracking_success==SuccessCode::Success);
+		if ((r.solution - first).norm() < 1e-6)
+			++num_first;
+		if ((r.solution - second).norm() < 1e-6)
+			++num_second;
+	}
+	BOOST_CHECK_EQUAL(num_first, 1);
+	BOOST_CHECK_EQUAL(num_second, 1);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(linear_product_counts_only_nonsingular_factor_choices)
+{
+	using namespace bertini::tracking;
+
+	bertini::System sys;
+	Var x1 = std::make_shared<bertini::node::Variable>("x1"), x2 = std::make_shared<bertini::node::Variable>("x2");
+	Var y1 = std::make_shared<bertini::node::Variable>("y1"), y2 = std::make_shared<bertini::node::Variable>("y2");
+
+	sys.AddVariableGroup(VariableGroup{x1,x2});
+	sys.AddVariableGroup(VariableGroup{y1,y2});
+	sys.AddFunction(x1*y1 + x1 - 2);
+	sys.AddFunction(x1*y2 + y2 - 3);
+	sys.AddFunction(x2*y1 + x2 + 1);
+	sys.AddFunction(x2*y2 + y1 + 5);
+
+	sys.Homogenize();
+	sys.AutoPatch();
+
+	bertini::start_system::MHomogeneous MH(sys);
+	bertini::start_system::LinearProduct LP(sys);
+
+	// of the 6 ways of splitting the functions between the groups, 3 leave a group with two functions in the same single variable
+	BOOST_CHECK_EQUAL(MH.NumStartPoints(), 6);
+	BOOST_CHECK_EQUAL(LP.NumStartPoints(), 3);
+	BOOST_CHECK(LP.Supports()[3][1]==std::vector<unsigned>({0,1}));
+	BOOST_CHECK(LP.Supports()[1][0]==std::vector<unsigned>({0}));
+
+	for (mpz_int ii = 0; ii < LP.NumStartPoints(); ++ii)
+		BOOST_CHECK(LP.Eval(LP.StartPoint<dbl>(ii)).norm() < 1e-12);
+
+	bertini::DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	LP.precision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	for (mpz_int ii = 0; ii < LP.NumStartPoints(); ++ii)
+		BOOST_CHECK(LP.Eval(LP.StartPoint<mpfr>(ii)).norm() < threshold_clearance_mp);
+
+	config::Solver<double> settings;
+	auto results = Solve<DoublePrecisionTracker>(sys, LP, settings);
+	BOOST_REQUIRE_EQUAL(results.size(), 3);
+
+	// eliminating, y1^2 + 8 y1 + 12 = 0, and the third path goes to infinity
+	std::vector<Vec<dbl> > expected(2, Vec<dbl>(4));
+	expected[0] << dbl(-2), dbl(1), dbl(-2), dbl(-3);
+	expected[1] << dbl(-0.4), dbl(0.2), dbl(-6), dbl(5);
+
+	std::vector<unsigned> times_found(expected.size(), 0);
+	for (const auto& r : results)
+		for (unsigned jj = 0; jj < expected.size(); ++jj)
+			if (r.solution.size()==4 && (r.solution - expected[jj]).norm() < 1e-8)
+				++times_found[jj];
+
+	for (auto n : times_found)
+		BOOST_CHECK_EQUAL(n, 1);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(polyhedral_mixed_volumes)
+{
+	Var x = std::make_shared<Variable>("x"), y = std::make_shared<Variable>("y"), z = std::make_shared<Variable>("z");
+
+	// two generic bilinear functions have two solutions, where the total degree is four
+	bertini::System bilinear;
+	bilinear.AddVariableGroup(VariableGroup{x,y});
+	bilinear.AddFunction(x*y + 2*x - y - 3);
+	bilinear.AddFunction(3*x*y - x + y + 1);
+
+	bertini::start_system::Polyhedral P(bilinear);
+	BOOST_CHECK_EQUAL(P.MixedVolume(), 2);
+	BOOST_CHECK_EQUAL(P.NumStartPoints(), 0);
+	for (auto const& support : P.Supports())
+	{
+		BOOST_CHECK_EQUAL(support.size(), 4);
+		BOOST_CHECK(support.back()==std::vector<int>({0,0}));
+	}
+
+	// cyclic 3-roots, 6 solutions
+	bertini::System cyclic;
+	cyclic.AddVariableGroup(VariableGroup{x,y,z});
+	cyclic.AddFunction(x + y + z);
+	cyclic.AddFunction(x*y + y*z + z*x);
+	cyclic.AddFunction(x*y*z - 1);
+
+	bertini::start_system::Polyhedral C1(cyclic, 1), C3(cyclic, 3);
+	BOOST_CHECK_EQUAL(C1.MixedVolume(), 6);
+	BOOST_CHECK_EQUAL(C3.MixedVolume(), 6);
+
+	mpz_int cell_volumes = 0;
+	for (size_t ii = 0; ii < C3.MixedCells().size(); ++ii)
+		cell_volumes += C3.BinomialSolutions(ii).size();
+	BOOST_CHECK_EQUAL(cell_volumes, 6);
+}
+
+
+
+BOOST_AUTO_TEST_CASE(solve_sparse_system_with_polyhedral_start_system)
+{
+	using namespace bertini::tracking;
+
+	Var x = std::make_shared<Variable>("x"), y = std::make_shared<Variable>("y");
+
+	// x^2 y = 2 and x y^2 = 3 have 3 solutions, the cube roots of 4/3 for x, where the total degree is 9
+	auto make_target = [&](bertini::System & S)
+	{
+		S.AddVariableGroup(VariableGroup{x,y});
+		S.AddFunction(pow(x,2)*y - 2);
+		S.AddFunction(x*pow(y,2) - 3);
+	};
+
+	bertini::System sys, target;
+	make_target(sys);
+	make_target(target);
+	sys.Homogenize();
+	sys.AutoPatch();
+
+	bertini::start_system::Polyhedral P(sys);
+	BOOST_CHECK(P.IsHomogeneous());
+	BOOST_CHECK(P.IsPatched());
+	BOOST_REQUIRE_EQUAL(P.MixedVolume(), 3);
+
+	for (size_t ii = 0; ii < P.MixedCells().size(); ++ii)
+	{
+		auto homotopy = P.CellHomotopy(ii);
+		for (auto const& b : P.BinomialSolutions(ii))
+			BOOST_CHECK(homotopy.Eval(b, dbl(1e-12)).norm() < 1e-10);
+	}
+
+	config::Solver<double> settings;
+	settings.num_threads = 2;
+
+	BOOST_CHECK_EQUAL(TrackPolyhedralHomotopies<DoublePrecisionTracker>(P, settings), 0);
+	BOOST_REQUIRE_EQUAL(P.NumStartPoints(), 3);
+	for (mpz_int ii = 0; ii < P.NumStartPoints(); ++ii)
+		BOOST_CHECK(P.Eval(P.StartPoint<dbl>(ii)).norm() < 1e-12);
+
+	bertini::DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	P.precision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	for (mpz_int ii = 0; ii < P.NumStartPoints(); ++ii)
+		BOOST_CHECK(P.Eval(P.StartPoint<mpfr>(ii)).norm() < threshold_clearance_mp);
+
+	bertini::start_system::Polyhedral loaded;
+	LoadSystem(SaveSystem(P), loaded);
+	BOOST_CHECK_EQUAL(loaded.NumStartPoints(), 3);
+	BOOST_CHECK((loaded.StartPoint<dbl>(1) - P.StartPoint<dbl>(1)).norm() < 1e-15);
+
+	auto results = Solve<DoublePrecisionTracker>(sys, P, settings);
+	BOOST_REQUIRE_EQUAL(results.size(), 3);
+
+	for (unsigned ii = 0; ii < results.size(); ++ii)
+	{
+		BOOST_CHECK(results[ii].tracking_success==SuccessCode::Success);
+		BOOST_REQUIRE_EQUAL(results[ii].solution.size(), 2);
+		BOOST_CHECK(target.Eval(results[ii].solution).norm() < 1e-8);
+		for (unsigned jj = 0; jj < ii; ++jj)
+			BOOST_CHECK((results[ii].solution - results[jj].solution).norm() > 1e-4);
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE(parameter_homotopy_solves_many_points_from_cached_generic_solutions)
+{
+	using namespace bertini::tracking;
+
+	// x^2 = p, x y = q.  two finite solutions, of the total degree's four, at almost every point
+	auto make_family = [](bertini::System & S)
+	{
+		Var x = std::make_shared<Variable>("x"), y = std::make_shared<Variable>("y");
+		auto p = std::make_shared<bertini::node::Function>("p"), q = std::make_shared<bertini::node::Function>("q");
+		p->SetRoot(std::make_shared<bertini::node::Integer>(0));
+		q->SetRoot(std::make_shared<bertini::node::Integer>(0));
+
+		S.AddVariableGroup(VariableGroup{x,y});
+		S.AddParameter(p);
+		S.AddParameter(q);
+		S.AddFunction(pow(x,2) - p);
+		S.AddFunction(x*y - q);
+		S.Homogenize();
+		S.AutoPatch();
+	};
+
+	char cache_file[] = "/tmp/b2_generic_solutions_XXXXXX";
+	close(mkstemp(cache_file));
+
+	config::ParameterHomotopy<double> settings;
+	settings.solver.num_threads = 2;
+
+	{
+		bertini::System family;
+		make_family(family);
+		bertini::tracking::ParameterHomotopy<DoublePrecisionTracker> ph(family, settings);
+		BOOST_CHECK_THROW(ph.Solve({Vec<dbl>::Ones(2)}), std::runtime_error);
+		BOOST_CHECK_EQUAL(ph.SolveGeneric(), 2);
+		ph.SaveGeneric(cache_file);
+	}
+
+	// another instance of the family, with another patch, from the cache
+	bertini::System family;
+	make_family(family);
+	bertini::tracking::ParameterHomotopy<DoublePrecisionTracker> ph(family, settings);
+	ph.LoadGeneric(cache_file);
+	BOOST_REQUIRE_EQUAL(ph.Generic().solutions.size(), 2);
+	std::remove(cache_file);
+
+	std::vector<Vec<dbl> > points(4, Vec<dbl>(2));
+	points[0] << dbl(4), dbl(6);
+	points[1] << dbl(9), dbl(3);
+	points[2] << dbl(0.25), dbl(-1);
+	points[3] << dbl(-1), dbl(1);
+
+	std::vector<Vec<dbl> > expected(4, Vec<dbl>(2));
+	expected[0] << dbl(2), dbl(3);
+	expected[1] << dbl(3), dbl(1);
+	expected[2] << dbl(0.5), dbl(-2);
+	expected[3] << dbl(0,1), dbl(0,-1);
+
+	auto results = ph.Solve(points);
+	BOOST_REQUIRE_EQUAL(results.size(), 4);
+	for (unsigned ii = 0; ii < results.size(); ++ii)
+	{
+		BOOST_REQUIRE_EQUAL(results[ii].size(), 2);
+		unsigned num_plus = 0, num_minus = 0;
+		for (auto const& r : results[ii])
+		{
+			BOOST_CHECK(r.tracking_success==SuccessCode::Success);
+			BOOST_CHECK(r.endgame_success==SuccessCode::Success);
+			BOOST_REQUIRE_EQUAL(r.solution.size(), 2);
+			if ((r.solution - expected[ii]).norm() < 1e-8)
+				++num_plus;
+			if ((r.solution + expected[ii]).norm() < 1e-8)
+				++num_minus;
+		}
+		BOOST_CHECK_EQUAL(num_plus, 1);
+		BOOST_CHECK_EQUAL(num_minus, 1);
+	}
+}
+
+
+
+BOOST_AUTO_TEST_CASE(regeneration_tracks_only_intermediate_solutions)
+{
+	using namespace bertini::tracking;
+
+	// total degree 10, but 3 solutions, with x^3 = 2 and y = 1/x
+	auto make_system = [](bertini::System & S)
+	{
+		Var x = std::make_shared<Variable>("x"), y = std::make_shared<Variable>("y");
+		S.AddVariableGroup(VariableGroup{x,y});
+		S.AddFunction(x*y - 1);
+		S.AddFunction(pow(x,4)*y - 2);
+	};
+
+	bertini::System sys;
+	make_system(sys);
+
+	config::Regeneration<double> settings;
+	settings.solver.num_threads = 2;
+	BOOST_CHECK_THROW(SolveByRegeneration<DoublePrecisionTracker>(sys, settings), std::runtime_error);
+
+	sys.Homogenize();
+	sys.AutoPatch();
+
+	auto check_solutions = [](std::vector<Vec<dbl> > const& solutions)
+	{
+		BOOST_REQUIRE_EQUAL(solutions.size(), 3);
+		for (unsigned kk = 0; kk < 3; ++kk)
+		{
+			dbl x = std::pow(2.0, 1.0/3) * std::exp(dbl(0, 2*M_PI*kk/3));
+			auto num_found = std::count_if(solutions.begin(), solutions.end(),
+			                               [&](Vec<dbl> const& s){ return abs(s(0) - x) < 1e-8 && abs(s(1) - 1.0/x) < 1e-8; });
+			BOOST_CHECK_EQUAL(num_found, 1);
+		}
+	};
+
+	auto result = SolveByRegeneration<DoublePrecisionTracker>(sys, settings);
+	BOOST_REQUIRE_EQUAL(result.num_stage_solutions.size(), 2);
+	BOOST_CHECK_EQUAL(result.num_stage_solutions[0], 2);
+	BOOST_CHECK_EQUAL(result.num_stage_solutions[1], 3);
+	// the first stage moves 1 linear, and tracks 2 paths, and the second moves 4 linears through its 2 solutions, and tracks 10
+	BOOST_CHECK_EQUAL(result.num_paths, 21);
+	check_solutions(result.solutions);
+
+	config::Regeneration<mpfr_float> mp_settings;
+	auto mp_result = SolveByRegeneration<MultiplePrecisionTracker>(sys, mp_settings);
+	std::vector<Vec<dbl> > mp_solutions;
+	for (auto const& s : mp_result.solutions)
+	{
+		Vec<dbl> s_dbl(2);
+		s_dbl << static_cast<dbl>(s(0)), static_cast<dbl>(s(1));
+		mp_solutions.push_back(s_dbl);
+	}
+	check_solutions(mp_solutions);
+}
+
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,386 @@
+//This file is part of Bertini 2.
+//
+//straight_line_program_test.cpp is free software: you can redistribute it and/or modify
+//it under the terms of the GNU General Public License as published by
+//the Free Software Foundation, either version 3 of the License, or
+//(at your option) any later version.
+//
+//straight_line_program_test.cpp is distributed in the hope that it will be useful,
+//but WITHOUT ANY WARRANTY; without even the implied warranty of
+//MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//GNU General Public License for more details.
+//
+//You should have received a copy of the GNU General Public License
+//along with straight_line_program_test.cpp.  If not, see <http://www.gnu.org/licenses/>.
+//
+// Copyright(C) 2015, 2016 by Bertini2 Development Team
+//
+// See <http://www.gnu.org/licenses/> for a copy of the license,
+// as well as COPYING.  Bertini2 is provided with permitted
+// additional terms in the b2/licenses/ directory.
+
+// individual authors of this file include:
+// daniel brake, university of notre dame
+
+
+/**
+\file straight_line_program_test.cpp Unit testing for the bertini::StraightLineProgram class, and compiled evaluation of Systems.
+*/
+
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include "bertini2/config.h"
+#include "bertini2/system.hpp"
+#include "bertini2/system_parsing.hpp"
+
+using System = bertini::System;
+using Var = std::shared_ptr<bertini::node::Variable>;
+using VariableGroup = bertini::VariableGroup;
+using EvalMethod = bertini::EvalMethod;
+using bertini::DefaultPrecision;
+
+using mpfr_float = bertini::mpfr_float;
+using dbl = bertini::dbl;
+using mpfr = bertini::mpfr;
+
+extern double relaxed_threshold_clearance_d;
+extern bertini::mpfr_float threshold_clearance_mp;
+extern unsigned CLASS_TEST_MPFR_DEFAULT_DIGITS;
+
+
+template<typename NumType> using Vec = bertini::Vec<NumType>;
+template<typename NumType> using Mat = bertini::Mat<NumType>;
+
+
+namespace {
+
+	System ParseSystem(std::string const& str)
+	{
+		System sys;
+		std::string::const_iterator iter = str.begin();
+		std::string::const_iterator end = str.end();
+		bertini::SystemParser<std::string::const_iterator> S;
+		phrase_parse(iter, end, S, boost::spirit::ascii::space, sys);
+		return sys;
+	}
+
+	// a system with a path variable, an explicit parameter, a subfunction, and transcendental functions
+	const std::string parametrized_system = "variable_group x, y; function f1, f2; pathvariable t; parameter s; s = t; g = x*y; f1 = x^2 + (1-s)*g - exp(x) + pi*y/3; f2 = sin(g) - 2.5*y*t + sqrt(x+2)*g^3;";
+}
+
+
+BOOST_AUTO_TEST_SUITE(straight_line_program)
+
+
+/**
+\class bertini::StraightLineProgram
+\test \b slp_eval_matches_tree_double Confirms that compiled evaluation of functions, Jacobian, and time derivative matches tree evaluation, in double precision.
+*/
+BOOST_AUTO_TEST_CASE(slp_eval_matches_tree_double)
+{
+	System sys = ParseSystem(parametrized_system);
+
+	Vec<dbl> values(2);
+	values << dbl(0.3,-1.2), dbl(-0.7,0.4);
+	dbl t(0.4,0.1);
+
+	auto f_tree = sys.Eval(values, t);
+	auto J_tree = sys.Jacobian(values, t);
+	auto dt_tree = sys.TimeDerivative(values, t);
+
+	sys.SetEvalMethod(EvalMethod::StraightLine);
+
+	auto f_slp = sys.Eval(values, t);
+	auto J_slp = sys.Jacobian(values, t);
+	auto dt_slp = sys.TimeDerivative(values, t);
+
+	for (unsigned ii = 0; ii < 2; ++ii)
+	{
+		BOOST_CHECK(abs(f_tree(ii) - f_slp(ii)) < relaxed_threshold_clearance_d);
+		BOOST_CHECK(abs(dt_tree(ii) - dt_slp(ii)) < relaxed_threshold_clearance_d);
+		for (unsigned jj = 0; jj < 2; ++jj)
+			BOOST_CHECK(abs(J_tree(ii,jj) - J_slp(ii,jj)) < relaxed_threshold_clearance_d);
+	}
+}
+
+
+/**
+\class bertini::StraightLineProgram
+\test \b slp_eval_matches_tree_mpfr Confirms that compiled evaluation matches tree evaluation in multiple precision, both at the default precision and after raising the precision of the system.
+*/
+BOOST_AUTO_TEST_CASE(slp_eval_matches_tree_mpfr)
+{
+	DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	System sys = ParseSystem(parametrized_system);
+
+	Vec<mpfr> values(2);
+	values << mpfr("0.3","-1.2"), mpfr("-0.7","0.4");
+	mpfr t("0.4","0.1");
+
+	auto f_tree = sys.Eval(values, t);
+	auto J_tree = sys.Jacobian(values, t);
+
+	sys.SetEvalMethod(EvalMethod::StraightLine);
+
+	auto f_slp = sys.Eval(values, t);
+	auto J_slp = sys.Jacobian(values, t);
+
+	for (unsigned ii = 0; ii < 2; ++ii)
+	{
+		BOOST_CHECK(abs(f_tree(ii) - f_slp(ii)) < threshold_clearance_mp);
+		for (unsigned jj = 0; jj < 2; ++jj)
+			BOOST_CHECK(abs(J_tree(ii,jj) - J_slp(ii,jj)) < threshold_clearance_mp);
+	}
+
+
+	// now go up in precision, and make sure the constants came along.
+	unsigned higher_precision = 2*CLASS_TEST_MPFR_DEFAULT_DIGITS;
+	DefaultPrecision(higher_precision);
+	sys.precision(higher_precision);
+
+	Vec<mpfr> values_higher(2);
+	values_higher << mpfr("0.3","-1.2"), mpfr("-0.7","0.4");
+	mpfr t_higher("0.4","0.1");
+
+	f_slp = sys.Eval(values_higher, t_higher);
+	sys.SetEvalMethod(EvalMethod::FunctionTree);
+	f_tree = sys.Eval(values_higher, t_higher);
+
+	BOOST_CHECK_EQUAL(f_slp(0).precision(), higher_precision);
+	for (unsigned ii = 0; ii < 2; ++ii)
+		BOOST_CHECK(abs(f_tree(ii) - f_slp(ii)) < mpfr_float("1e-" + std::to_string(higher_precision-3)));
+
+	DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+}
+
+
+/**
+\class bertini::StraightLineProgram
+\test \b slp_shared_subtrees_compiled_once Confirms that a subfunction referred to several times, and equal instructions from distinct subtrees, each appear only once on the tape.
+*/
+BOOST_AUTO_TEST_CASE(slp_shared_subtrees_compiled_once)
+{
+	Var x = std::make_shared<bertini::node::Variable>("x");
+	Var y = std::make_shared<bertini::node::Variable>("y");
+
+	bertini::SLPCompiler compiler;
+
+	// x*y, computed twice from distinct nodes, then squared.  the duplicates should not appear on the tape.
+	auto f = std::make_shared<bertini::node::Function>(pow(x*y,2) + pow(x*y,2));
+	auto slp = compiler.Compile({f}, VariableGroup{x,y});
+
+	BOOST_CHECK_EQUAL(slp.NumFunctions(), 1);
+	BOOST_CHECK_EQUAL(slp.NumInstructions(), 3); // x*y, (x*y)^2, and the sum
+	BOOST_CHECK(!slp.HaveJacobian());
+
+	x->set_current_value(dbl(2));
+	y->set_current_value(dbl(3));
+	Vec<dbl> v(1);
+	slp.EvalInPlace(v);
+	BOOST_CHECK_EQUAL(v(0), dbl(72));
+}
+
+
+/**
+\class bertini::System
+\test \b slp_recompiled_after_structure_change Confirms that the compiled program is rebuilt when functions are added to the system.
+*/
+BOOST_AUTO_TEST_CASE(slp_recompiled_after_structure_change)
+{
+	Var x = std::make_shared<bertini::node::Variable>("x");
+	Var y = std::make_shared<bertini::node::Variable>("y");
+
+	System sys;
+	sys.AddVariableGroup(VariableGroup{x,y});
+	sys.AddFunction(x*y - 1);
+	sys.SetEvalMethod(EvalMethod::StraightLine);
+
+	Vec<dbl> values(2);
+	values << dbl(2), dbl(3);
+
+	auto f = sys.Eval(values);
+	BOOST_CHECK_EQUAL(f.size(), 1);
+	BOOST_CHECK_EQUAL(f(0), dbl(5));
+
+	sys.AddFunction(x+y);
+	f = sys.Eval(values);
+	BOOST_CHECK_EQUAL(f.size(), 2);
+	BOOST_CHECK_EQUAL(f(1), dbl(5));
+
+	auto J = sys.Jacobian(values);
+	BOOST_CHECK_EQUAL(J(0,0), dbl(3));
+	BOOST_CHECK_EQUAL(J(0,1), dbl(2));
+	BOOST_CHECK_EQUAL(J(1,0), dbl(1));
+	BOOST_CHECK_EQUAL(J(1,1), dbl(1));
+}
+
+
+/**
+\class bertini::StraightLineProgram
+\test \b slp_reverse_mode_preferred_for_wide_systems Confirms that reverse-mode differentiation is preferred for a function of many variables, forward mode for many functions of one variable, and that the two agree.
+*/
+BOOST_AUTO_TEST_CASE(slp_reverse_mode_preferred_for_wide_systems)
+{
+	const unsigned num_vars = 10;
+
+	VariableGroup vars;
+	for (unsigned ii = 0; ii < num_vars; ++ii)
+		vars.push_back(std::make_shared<bertini::node::Variable>("x" + std::to_string(ii)));
+
+	std::shared_ptr<bertini::node::Node> product = vars[0];
+	for (unsigned ii = 1; ii < num_vars; ++ii)
+		product = product*vars[ii];
+
+	auto wide = bertini::SLPCompiler().Compile({std::make_shared<bertini::node::Function>(product + vars[0])}, vars);
+	BOOST_CHECK(wide.PreferReverseMode());
+
+	std::vector< std::shared_ptr<bertini::node::Function> > functions;
+	for (unsigned ii = 0; ii < num_vars; ++ii)
+		functions.push_back(std::make_shared<bertini::node::Function>(pow(vars[0],int(ii)+2) - vars[0]));
+	auto tall = bertini::SLPCompiler().Compile(functions, VariableGroup{vars[0]});
+	BOOST_CHECK(!tall.PreferReverseMode());
+
+
+	for (unsigned ii = 0; ii < num_vars; ++ii)
+		vars[ii]->set_current_value(dbl(ii+1,-0.5));
+
+	Mat<dbl> J_forward(1,num_vars), J_reverse(1,num_vars);
+	wide.ForwardJacobianInPlace(J_forward);
+	wide.ReverseJacobianInPlace(J_reverse);
+	for (unsigned ii = 0; ii < num_vars; ++ii)
+		BOOST_CHECK(abs(J_forward(0,ii) - J_reverse(0,ii)) < relaxed_threshold_clearance_d*abs(J_forward(0,ii)));
+}
+
+
+/**
+\class bertini::StraightLineProgram
+\test \b slp_precision_round_trip Confirms that after leaving a precision and returning to it, compiled evaluation gives the same values as before, at that precision, and that the function trees catch up to the precision of the system when next evaluated.
+*/
+BOOST_AUTO_TEST_CASE(slp_precision_round_trip)
+{
+	DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	System sys = ParseSystem(parametrized_system);
+	sys.SetEvalMethod(EvalMethod::StraightLine);
+
+	Vec<mpfr> values(2);
+	values << mpfr("0.3","-1.2"), mpfr("-0.7","0.4");
+	mpfr t("0.4","0.1");
+
+	auto f_before = sys.Eval(values, t);
+	auto J_before = sys.Jacobian(values, t);
+
+	unsigned higher_precision = 2*CLASS_TEST_MPFR_DEFAULT_DIGITS;
+	for (unsigned ii = 0; ii < 3; ++ii)
+	{
+		DefaultPrecision(higher_precision);
+		sys.precision(higher_precision);
+		Vec<mpfr> values_higher(2);
+		values_higher << mpfr("0.3","-1.2"), mpfr("-0.7","0.4");
+		auto f_higher = sys.Eval(values_higher, mpfr("0.4","0.1"));
+		BOOST_CHECK_EQUAL(f_higher(0).precision(), higher_precision);
+		BOOST_CHECK_EQUAL(sys.GetStraightLineProgram().precision(), higher_precision);
+
+		DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+		sys.precision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+		auto f_after = sys.Eval(values, t);
+		auto J_after = sys.Jacobian(values, t);
+
+		BOOST_CHECK_EQUAL(f_after(0).precision(), CLASS_TEST_MPFR_DEFAULT_DIGITS);
+		for (unsigned jj = 0; jj < 2; ++jj)
+		{
+			BOOST_CHECK_EQUAL(f_after(jj), f_before(jj));
+			for (unsigned kk = 0; kk < 2; ++kk)
+				BOOST_CHECK_EQUAL(J_after(jj,kk), J_before(jj,kk));
+		}
+	}
+
+	// the trees were left behind while evaluating through the program
+	DefaultPrecision(higher_precision);
+	sys.precision(higher_precision);
+	sys.SetEvalMethod(EvalMethod::FunctionTree);
+	Vec<mpfr> values_higher(2);
+	values_higher << mpfr("0.3","-1.2"), mpfr("-0.7","0.4");
+	auto f_tree = sys.Eval(values_higher, mpfr("0.4","0.1"));
+	BOOST_CHECK_EQUAL(sys.Function(0)->bertini::node::Node::precision(), higher_precision);
+	BOOST_CHECK_EQUAL(f_tree(0).precision(), higher_precision);
+
+	DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+}
+
+/**
+\class bertini::NativeCompiler
+\test \b slp_native_matches_interpreted Confirms that evaluation through the compiled native code matches the interpreted program in double precision, and that multiple precision continues to interpret.
+*/
+BOOST_AUTO_TEST_CASE(slp_native_matches_interpreted)
+{
+	DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	System sys = ParseSystem(parametrized_system);
+
+	Vec<dbl> values(2);
+	values << dbl(0.3,-1.2), dbl(-0.7,0.4);
+	dbl t(0.4,0.1);
+
+	sys.SetEvalMethod(EvalMethod::StraightLine);
+	auto f_slp = sys.Eval(values, t);
+	auto J_slp = sys.Jacobian(values, t);
+	auto dt_slp = sys.TimeDerivative(values, t);
+	BOOST_CHECK(!sys.GetStraightLineProgram().HaveNativeProgram());
+
+	sys.SetEvalMethod(EvalMethod::Native);
+	auto dt_native = sys.TimeDerivative(values, t);
+	auto J_native = sys.Jacobian(values, t);
+	auto f_native = sys.Eval(values, t);
+	BOOST_CHECK(sys.GetStraightLineProgram().HaveNativeProgram());
+
+	for (unsigned ii = 0; ii < 2; ++ii)
+	{
+		BOOST_CHECK(abs(f_slp(ii) - f_native(ii)) < relaxed_threshold_clearance_d);
+		BOOST_CHECK(abs(dt_slp(ii) - dt_native(ii)) < relaxed_threshold_clearance_d);
+		for (unsigned jj = 0; jj < 2; ++jj)
+			BOOST_CHECK(abs(J_slp(ii,jj) - J_native(ii,jj)) < relaxed_threshold_clearance_d);
+	}
+
+	Vec<mpfr> values_mp(2);
+	values_mp << mpfr("0.3","-1.2"), mpfr("-0.7","0.4");
+	mpfr t_mp("0.4","0.1");
+
+	auto f_native_mp = sys.Eval(values_mp, t_mp);
+	sys.SetEvalMethod(EvalMethod::StraightLine);
+	auto f_slp_mp = sys.Eval(values_mp, t_mp);
+	for (unsigned ii = 0; ii < 2; ++ii)
+		BOOST_CHECK(abs(f_slp_mp(ii) - f_native_mp(ii)) < threshold_clearance_mp);
+}
+
+
+/**
+\class bertini::NativeCompiler
+\test \b slp_native_cached_by_structure Confirms that the shared object for a program is cached, and that a program of the same structure but different coefficients is loaded from the cache rather than compiled again.  The second compiler is a command which always fails, so would throw if invoked.
+*/
+BOOST_AUTO_TEST_CASE(slp_native_cached_by_structure)
+{
+	namespace fs = boost::filesystem;
+	const auto directory = (fs::temp_directory_path() / fs::unique_path()).string();
+
+	System sys = ParseSystem(parametrized_system);
+	bertini::NativeCompiler compiler(directory, BERTINI_NATIVE_CXX);
+	auto native = compiler.Compile(sys.GetStraightLineProgram());
+	BOOST_CHECK(fs::exists(compiler.CachedLibraryPath(sys.GetStraightLineProgram())));
+
+	System other = ParseSystem("variable_group x, y; function f1, f2; pathvariable t; parameter s; s = t; g = x*y; f1 = x^2 + (1-s)*g - exp(x) + pi*y/7; f2 = sin(g) - 3.5*y*t + sqrt(x+2)*g^3;");
+	bertini::NativeCompiler failing(directory, "false");
+	std::shared_ptr<const bertini::NativeProgram> other_native;
+	BOOST_CHECK_NO_THROW(other_native = failing.Compile(other.GetStraightLineProgram()));
+	BOOST_CHECK_EQUAL(native->Hash(), other_native->Hash());
+
+	System different = ParseSystem("variable_group x, y; function f1, f2; f1 = x^2 + y; f2 = x*y - 1;");
+	BOOST_CHECK(bertini::NativeCompiler::StructuralHash(different.GetStraightLineProgram()) != native->Hash());
+	BOOST_CHECK_THROW(failing.Compile(different.GetStraightLineProgram()), std::runtime_error);
+
+	native.reset();
+	other_native.reset();
+	fs::remove_all(directory);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -38,6 +38,7 @@
 */
 
 #include <boost/test/unit_test.hpp>
+#include <thread>
 
 
 
@@ -965,7 +966,386 @@ BOOST_AUTO_TEST_CASE(ref_test)
 }
 
 
+/**
+\class bertini::System
+\test \b eliminate_common_subexpressions Confirms that merging repeated structure reduces the number of nodes in a system, without changing its values or Jacobian.
+*/
+BOOST_AUTO_TEST_CASE(eliminate_common_subexpressions)
+{
+	std::string str = "function f1, f2; variable_group x, y; f1 = x^2*y + 3*x^2 + (x+y)^3; f2 = x^2 - 3*y^2*x^2 + (x+y)^3;";
+
+	bertini::System sys;
+	std::string::const_iterator iter = str.begin();
+	std::string::const_iterator end = str.end();
+	bertini::SystemParser<std::string::const_iterator> S;
+	phrase_parse(iter, end, S, boost::spirit::ascii::space, sys);
+
+	Vec<dbl> values(2);
+	values << dbl(0.5,-1.5), dbl(2.0,0.25);
+
+	auto f_before = sys.Eval(values);
+	auto J_before = sys.Jacobian(values);
+
+	auto counts = sys.EliminateCommonSubexpressions();
+	BOOST_CHECK(counts.second < counts.first);
+	BOOST_CHECK_EQUAL(counts.second, sys.NumDistinctNodes());
+
+	auto f_after = sys.Eval(values);
+	auto J_after = sys.Jacobian(values);
+
+	for (unsigned ii = 0; ii < 2; ++ii)
+	{
+		BOOST_CHECK(abs(f_before(ii) - f_after(ii)) < threshold_clearance_d);
+		for (unsigned jj = 0; jj < 2; ++jj)
+			BOOST_CHECK(abs(J_before(ii,jj) - J_after(ii,jj)) < threshold_clearance_d);
+	}
+
+	// a second pass finds nothing more to merge
+	counts = sys.EliminateCommonSubexpressions();
+	BOOST_CHECK_EQUAL(counts.first, counts.second);
+}
+
+
+/**
+\class bertini::node::HashConsingFactory
+\test \b hash_consing_factory_shares_equal_nodes Confirms that the factory returns the same node for structurally identical input, and distinct nodes otherwise.
+*/
+BOOST_AUTO_TEST_CASE(hash_consing_factory_shares_equal_nodes)
+{
+	using namespace bertini::node;
+
+	auto x = std::make_shared<Variable>("x");
+	auto y = std::make_shared<Variable>("y");
+
+	HashConsingFactory factory;
+	auto a = factory.Make<IntegerPowerOperator>(x, 2);
+	auto b = factory.Make<IntegerPowerOperator>(x, 2);
+	auto c = factory.Make<IntegerPowerOperator>(x, 3);
+	auto d = factory.Make<IntegerPowerOperator>(y, 2);
+
+	BOOST_CHECK(a==b);
+	BOOST_CHECK(a!=c);
+	BOOST_CHECK(a!=d);
+
+	auto e = sin(x)*y + sin(x)*y;
+	BOOST_CHECK_EQUAL(CountDistinctNodes({e}), 7);
+	e = factory.Canonicalize(e);
+	BOOST_CHECK_EQUAL(CountDistinctNodes({e}), 5); // x, y, sin(x), sin(x)*y, and the sum
+
+	auto p = factory.Canonicalize(std::make_shared<Float>(std::string("0.1"))*x);
+	auto q = factory.Canonicalize(std::make_shared<Float>(std::string("0.1"))*x);
+	auto r = factory.Canonicalize(std::make_shared<Float>(std::string("0.1000001"))*x);
+	BOOST_CHECK(p==q);
+	BOOST_CHECK(p!=r);
+}
+
+
+/**
+\class bertini::System
+\test \b eval_resets_only_dependent_nodes Confirms that evaluation keeps the stored values of constant subtrees, while re-evaluating those depending on the variables or the path variable, and that a change in precision resets everything.
+
+The constant subfunction is altered behind the system's back, so that re-evaluation of it would be observed.
+*/
+BOOST_AUTO_TEST_CASE(eval_resets_only_dependent_nodes)
+{
+	using namespace bertini::node;
+
+	Var x = std::make_shared<Variable>("x");
+	Var t = std::make_shared<Variable>("t");
+	auto c = std::make_shared<Function>(std::make_shared<Integer>(2)*std::make_shared<Integer>(3));
+
+	System sys;
+	sys.AddVariableGroup(VariableGroup{x});
+	sys.AddPathVariable(t);
+	sys.AddFunction(x + c);
+	sys.AddFunction(x*t);
+	sys.SetEvalMethod(bertini::EvalMethod::FunctionTree); // the stored values are those of the tree nodes
+
+	Vec<dbl> values(1);
+	values << dbl(1);
+	auto f = sys.Eval(values, dbl(2));
+	BOOST_CHECK_EQUAL(f(0), dbl(7));
+	BOOST_CHECK_EQUAL(f(1), dbl(2));
+
+	c->SetRoot(std::make_shared<Integer>(10));
+
+	values << dbl(3);
+	f = sys.Eval(values, dbl(2));
+	BOOST_CHECK_EQUAL(f(0), dbl(9)); // the constant kept its value
+	BOOST_CHECK_EQUAL(f(1), dbl(6));
+
+	sys.SetPathVariable(dbl(5));
+	f = sys.Eval<dbl>();
+	BOOST_CHECK_EQUAL(f(0), dbl(9));
+	BOOST_CHECK_EQUAL(f(1), dbl(15));
+
+	sys.precision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	f = sys.Eval(values, dbl(5));
+	BOOST_CHECK_EQUAL(f(0), dbl(13)); // now the constant was evaluated afresh
+	BOOST_CHECK_EQUAL(f(1), dbl(15));
+}
+
+
+/**
+\class bertini::System
+\test \b clone_shares_no_nodes Confirms that a clone evaluates like the original, that evaluating or changing the precision of the clone leaves the original alone, and that clones may be evaluated in separate threads at once.
+*/
+BOOST_AUTO_TEST_CASE(clone_shares_no_nodes)
+{
+	std::string str = "function f1, f2; variable_group x, y; pathvariable t; parameter s; s = t^2; g = x*y; f1 = g^2 - s*x; f2 = exp(g) + y*t;";
+
+	System sys;
+	std::string::const_iterator iter = str.begin();
+	std::string::const_iterator end = str.end();
+	bertini::SystemParser<std::string::const_iterator> S;
+	phrase_parse(iter, end, S, boost::spirit::ascii::space, sys);
+
+	auto clone = sys.Clone();
+	BOOST_CHECK_EQUAL(clone.NumFunctions(), sys.NumFunctions());
+	BOOST_CHECK_EQUAL(clone.NumDistinctNodes(), sys.NumDistinctNodes());
+	BOOST_CHECK(clone.Variables()[0] != sys.Variables()[0]);
+
+	Vec<dbl> values(2);
+	values << dbl(0.5,0.1), dbl(-0.3,0.7);
+	dbl t(0.2,-0.4);
+
+	auto f = sys.Eval(values, t);
+	auto J = sys.Jacobian(values, t);
+
+	Vec<dbl> other_values(2);
+	other_values << dbl(2), dbl(3);
+	clone.Eval(other_values, dbl(1));
+	clone.precision(2*CLASS_TEST_MPFR_DEFAULT_DIGITS);
+
+	// the original's nodes still hold their values, so evaluating without setting the variables again gives the same result
+	BOOST_CHECK_EQUAL(sys.precision(), bertini::DefaultPrecision());
+	auto f_again = sys.Eval<dbl>();
+	for (unsigned ii = 0; ii < 2; ++ii)
+		BOOST_CHECK_EQUAL(f(ii), f_again(ii));
+
+	auto f_clone = clone.Eval(values, t);
+	auto J_clone = clone.Jacobian(values, t);
+	for (unsigned ii = 0; ii < 2; ++ii)
+	{
+		BOOST_CHECK(abs(f(ii) - f_clone(ii)) < threshold_clearance_d);
+		for (unsigned jj = 0; jj < 2; ++jj)
+			BOOST_CHECK(abs(J(ii,jj) - J_clone(ii,jj)) < threshold_clearance_d);
+	}
+
+
+	std::vector<System> clones{sys.Clone(), sys.Clone()};
+	std::vector<Vec<dbl> > results(2);
+	std::vector<std::thread> threads;
+	for (unsigned ii = 0; ii < 2; ++ii)
+		threads.emplace_back([&, ii]{
+			Vec<dbl> v(2);
+			v << dbl(ii+1), dbl(ii+2);
+			for (unsigned jj = 0; jj < 1000; ++jj)
+				results[ii] = clones[ii].Eval(v, dbl(jj%10));
+			});
+	for (auto& thread : threads)
+		thread.join();
+
+	for (unsigned ii = 0; ii < 2; ++ii)
+	{
+		values << dbl(ii+1), dbl(ii+2);
+		f = sys.Eval(values, dbl(9));
+		for (unsigned jj = 0; jj < 2; ++jj)
+			BOOST_CHECK(abs(f(jj) - results[ii](jj)) < threshold_clearance_d*abs(f(jj)));
+	}
+}
+
+
+BOOST_AUTO_TEST_CASE(eval_and_jacobian_batch_match_single_points)
+{
+	std::string str = "function f1, f2; variable_group x, y; pathvariable t; parameter s; s = t^2; g = x*y; f1 = g^2 - s*x; f2 = exp(g) + y*t;";
+
+	System sys;
+	std::string::const_iterator iter = str.begin();
+	std::string::const_iterator end = str.end();
+	bertini::SystemParser<std::string::const_iterator> S;
+	phrase_parse(iter, end, S, boost::spirit::ascii::space, sys);
+
+	const unsigned num_points = 5;
+	Mat<dbl> points(2, num_points);
+	Vec<dbl> times(num_points);
+	for (unsigned kk = 0; kk < num_points; ++kk)
+	{
+		points(0,kk) = dbl(0.5,0.1)*dbl(kk+1);
+		points(1,kk) = dbl(-0.3,0.7)/dbl(kk+1);
+		times(kk) = dbl(0.2,-0.4)*dbl(kk+1);
+	}
+
+	Mat<dbl> values;
+	std::vector<Mat<dbl> > jacobians;
+	sys.EvalBatch(values, points, times);
+	sys.JacobianBatch(jacobians, points, times);
+
+	BOOST_REQUIRE_EQUAL(values.cols(), num_points);
+	BOOST_REQUIRE_EQUAL(jacobians.size(), num_points);
+	for (unsigned kk = 0; kk < num_points; ++kk)
+	{
+		Vec<dbl> x = points.col(kk);
+		auto f = sys.Eval(x, times(kk));
+		auto J = sys.Jacobian(x, times(kk));
+		for (unsigned ii = 0; ii < 2; ++ii)
+		{
+			BOOST_CHECK(abs(f(ii) - values(ii,kk)) < threshold_clearance_d);
+			for (unsigned jj = 0; jj < 2; ++jj)
+				BOOST_CHECK(abs(J(ii,jj) - jacobians[kk](ii,jj)) < threshold_clearance_d);
+		}
+	}
+
+
+	bertini::DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	sys.precision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	Mat<mpfr> points_mp(2, num_points);
+	Vec<mpfr> times_mp(num_points);
+	for (unsigned kk = 0; kk < num_points; ++kk)
+	{
+		points_mp(0,kk) = mpfr("0.5","0.1")*mpfr(kk+1);
+		points_mp(1,kk) = mpfr("-0.3","0.7")/mpfr(kk+1);
+		times_mp(kk) = mpfr("0.2","-0.4")*mpfr(kk+1);
+	}
+
+	Mat<mpfr> values_mp;
+	std::vector<Mat<mpfr> > jacobians_mp;
+	sys.EvalBatch(values_mp, points_mp, times_mp);
+	sys.JacobianBatch(jacobians_mp, points_mp, times_mp);
+
+	for (unsigned kk = 0; kk < num_points; ++kk)
+	{
+		Vec<mpfr> x = points_mp.col(kk);
+		auto f = sys.Eval(x, times_mp(kk));
+		auto J = sys.Jacobian(x, times_mp(kk));
+		for (unsigned ii = 0; ii < 2; ++ii)
+		{
+			BOOST_CHECK(abs(f(ii) - values_mp(ii,kk)) < threshold_clearance_mp);
+			for (unsigned jj = 0; jj < 2; ++jj)
+				BOOST_CHECK(abs(J(ii,jj) - jacobians_mp[kk](ii,jj)) < threshold_clearance_mp);
+		}
+	}
+
 
+	// a patched system, without path variable
+	Var x = std::make_shared<bertini::node::Variable>("x"), y = std::make_shared<bertini::node::Variable>("y");
+	System patched;
+	patched.AddVariableGroup(VariableGroup{x,y});
+	patched.AddFunction(pow(x,2) - 1);
+	patched.AddFunction(pow(y,3) - 8*x);
+	patched.Homogenize();
+	patched.AutoPatch();
+
+	Mat<dbl> homogeneous_points(3, num_points);
+	for (unsigned kk = 0; kk < num_points; ++kk)
+		homogeneous_points.col(kk) << dbl(1,kk), points(0,kk), points(1,kk);
+
+	patched.EvalBatch(values, homogeneous_points);
+	patched.JacobianBatch(jacobians, homogeneous_points);
+	BOOST_REQUIRE_EQUAL(values.rows(), 3);
+	for (unsigned kk = 0; kk < num_points; ++kk)
+	{
+		Vec<dbl> p = homogeneous_points.col(kk);
+		auto f = patched.Eval(p);
+		auto J = patched.Jacobian(p);
+		for (unsigned ii = 0; ii < 3; ++ii)
+		{
+			BOOST_CHECK(abs(f(ii) - values(ii,kk)) < threshold_clearance_d);
+			for (unsigned jj = 0; jj < 3; ++jj)
+				BOOST_CHECK(abs(J(ii,jj) - jacobians[kk](ii,jj)) < threshold_clearance_d);
+		}
+	}
+}
+
+
+
+
+
+/**
+\class bertini::System
+\test \b sparse_jacobian_matches_dense Check the structural sparsity of a system whose functions each involve a few variables, and that its sparse Jacobian agrees with the dense one, whichever way it is evaluated, with and without a patch.
+*/
+BOOST_AUTO_TEST_CASE(sparse_jacobian_matches_dense)
+{
+	using bertini::EvalMethod;
+
+	const unsigned n = 60;
+	bertini::System sys;
+	VariableGroup vars;
+	for (unsigned ii = 0; ii < n; ++ii)
+		vars.push_back(std::make_shared<bertini::Variable>("x" + std::to_string(ii)));
+	Var t = std::make_shared<bertini::Variable>("t");
+	sys.AddVariableGroup(vars);
+	sys.AddPathVariable(t);
+
+	// each function involves its own variable and its two neighbours, around a cycle
+	for (unsigned ii = 0; ii < n; ++ii)
+		sys.AddFunction(4*vars[ii] + vars[(ii+n-1)%n]*vars[(ii+1)%n] - t - 1);
+
+	BOOST_CHECK_EQUAL(sys.NumJacobianNonzeros(), 3*n);
+	BOOST_CHECK(std::abs(sys.JacobianDensity() - 3.0/n) < threshold_clearance_d);
+	BOOST_CHECK(sys.UseSparseLinearAlgebra());
+	sys.SetSparseDensityThreshold(0.01);
+	BOOST_CHECK(!sys.UseSparseLinearAlgebra());
+	sys.SetSparseDensityThreshold(0.1);
+
+	Vec<dbl> x(n);
+	for (unsigned ii = 0; ii < n; ++ii)
+		x(ii) = dbl(0.1*ii, 1-0.05*ii);
+	dbl time(0.3,0.2);
+
+	for (auto method : {EvalMethod::FunctionTree, EvalMethod::StraightLine, EvalMethod::Polynomial})
+	{
+		sys.SetEvalMethod(method);
+		auto J = sys.Jacobian(x, time);
+
+		bertini::SparseMat<dbl> J_sparse;
+		sys.SparseJacobianInPlace(J_sparse, x, time);
+		BOOST_CHECK_EQUAL(J_sparse.nonZeros(), 3*n);
+		BOOST_CHECK((Mat<dbl>(J_sparse) - J).norm() < threshold_clearance_d);
+	}
+
+
+	bertini::DefaultPrecision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	sys.precision(CLASS_TEST_MPFR_DEFAULT_DIGITS);
+	sys.SetEvalMethod(EvalMethod::Automatic);
+
+	Vec<mpfr> x_mp(n);
+	for (unsigned ii = 0; ii < n; ++ii)
+		x_mp(ii) = mpfr(mpfr_float(ii)/10, 1-mpfr_float(ii)/20);
+	mpfr time_mp("0.3","0.2");
+
+	auto J_mp = sys.Jacobian(x_mp, time_mp);
+	bertini::SparseMat<mpfr> J_sparse_mp;
+	sys.SparseJacobianInPlace(J_sparse_mp, x_mp, time_mp);
+	BOOST_CHECK((Mat<mpfr>(J_sparse_mp) - J_mp).norm() < threshold_clearance_mp);
+
+
+	// a patched system, without path variable
+	bertini::System patched;
+	Var a = std::make_shared<bertini::Variable>("a"), b = std::make_shared<bertini::Variable>("b");
+	Var c = std::make_shared<bertini::Variable>("c"), d = std::make_shared<bertini::Variable>("d");
+	patched.AddVariableGroup(VariableGroup{a, b});
+	patched.AddVariableGroup(VariableGroup{c, d});
+	patched.AddFunction(a*c - 1);
+	patched.AddFunction(b - 2);
+	patched.AddFunction(pow(d,2) - a);
+	patched.Homogenize();
+	patched.AutoPatch();
+
+	auto sparsity = patched.JacobianSparsity();
+	BOOST_REQUIRE_EQUAL(sparsity.size(), patched.NumTotalFunctions());
+	// after homogenization, a*c - h0*h1, b - 2*h0, and d^2*h0 - a*h1^2, then one row per patch, on its group of three
+	BOOST_CHECK_EQUAL(patched.NumJacobianNonzeros(), 4+2+4+3+3);
+	BOOST_CHECK(!patched.UseSparseLinearAlgebra());
+
+	Vec<dbl> y(6);
+	y << dbl(1,0.5), dbl(0.2,-1), dbl(0.7,0.7), dbl(-1.1,0.3), dbl(0.4,0.9), dbl(2,-0.6);
+	auto J_patched = patched.Jacobian(y);
+	bertini::SparseMat<dbl> J_patched_sparse;
+	patched.SparseJacobianInPlace(J_patched_sparse, y);
+	BOOST_CHECK((Mat<dbl>(J_patched_sparse) - J_patched).norm() < threshold_clearance_d);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
 
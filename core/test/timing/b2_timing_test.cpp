@@ -52,6 +52,8 @@ void arbitrary(boost::filesystem::path const& file, unsigned num_iterations = 10
 
 void simple_single_variable();
 
+void jacobian_crossover(unsigned num_functions = 8, unsigned num_iterations = 10000);
+
 int main(int argc, char** argv)
 {	
 	switch (argc)
@@ -59,6 +61,7 @@ int main(int argc, char** argv)
 		case 1:
 		{
 			simple_single_variable();
+			jacobian_crossover();
 			break;
 		}
 		case 2:
@@ -96,6 +99,9 @@ void arbitrary(boost::filesystem::path const& file, unsigned num_iterations)
 
 	System S(buffer.str());
 
+	auto node_counts = S.EliminateCommonSubexpressions();
+	std::cout << "common subexpression elimination: " << node_counts.first << " nodes before, " << node_counts.second << " after\n";
+
 	Vec<T> variable_values(S.NumVariables());
 
 	for (unsigned i = 0; i < variable_values.size(); ++i)
@@ -173,3 +179,51 @@ void simple_single_variable()
 
 
 
+/**
+Times forward- and reverse-mode automatic differentiation on systems with a fixed number of functions, and a growing number of variables.  Each function is a dense quadratic in the variables, so forward mode costs grow with the square of the number of variables, and reverse mode only linearly.  The crossover should appear near where the number of variables passes the number of functions.
+*/
+void jacobian_crossover(unsigned num_functions, unsigned num_iterations)
+{
+	using JacobianMethod = bertini::JacobianMethod;
+
+	std::cout << "forward vs reverse mode jacobians, for " << num_functions << " functions, " << num_iterations << " iterations\n";
+	std::cout << "variables\tforward\treverse\tautomatic chooses\n";
+
+	for (unsigned num_variables : {2, 4, 8, 16, 32, 64})
+	{
+		VariableGroup vars;
+		for (unsigned ii = 0; ii < num_variables; ++ii)
+			vars.push_back(std::make_shared<bertini::Variable>("x" + std::to_string(ii)));
+
+		System S;
+		S.AddVariableGroup(vars);
+		for (unsigned ii = 0; ii < num_functions; ++ii)
+		{
+			std::shared_ptr<bertini::node::Node> f = vars[0]*vars[(ii+1)%num_variables];
+			for (unsigned jj = 1; jj < num_variables; ++jj)
+				f = f + vars[jj]*vars[(jj+ii+1)%num_variables];
+			S.AddFunction(f);
+		}
+
+		Vec<dbl> v(num_variables);
+		for (unsigned ii = 0; ii < num_variables; ++ii)
+			v(ii) = bertini::rand_complex();
+		Mat<dbl> J(num_functions, num_variables);
+
+		std::cout << num_variables;
+		for (auto method : {JacobianMethod::ForwardMode, JacobianMethod::ReverseMode})
+		{
+			S.SetJacobianMethod(method);
+			S.JacobianInPlace(J,v); // compiles the program, so that compilation isn't timed
+
+			boost::timer::cpu_timer timer;
+			for (unsigned ii = 0; ii < num_iterations; ++ii)
+				S.JacobianInPlace(J,v);
+			timer.stop();
+
+			std::cout << "\t" << timer.format(6,"%w");
+		}
+
+		std::cout << "\t" << (S.GetStraightLineProgram().PreferReverseMode() ? "reverse" : "forward") << "\n";
+	}
+}
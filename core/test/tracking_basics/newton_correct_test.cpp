@@ -780,6 +780,207 @@ BOOST_AUTO_TEST_CASE(circle_line_one_corrector_step_double)
 		BOOST_CHECK(success_code==bertini::tracking::SuccessCode::FailedToConverge);
 	}
 
+	BOOST_AUTO_TEST_CASE(chord_newton_reuses_factorization_and_converges_d)
+	{
+		Vec<dbl> current_space(2);
+		current_space << dbl(1.1454,0.0218), dbl(0.4792, -0.0031);
+		dbl current_time(0.9);
+
+		bertini::System sys;
+		Var x = std::make_shared<Variable>("x"), y = std::make_shared<Variable>("y"), t = std::make_shared<Variable>("t");
+
+		VariableGroup vars{x,y};
+
+		sys.AddVariableGroup(vars);
+		sys.AddPathVariable(t);
+
+		sys.AddFunction( t*(pow(x,2)-1) + (1-t)*(pow(x,2) + pow(y,2) - 4) );
+		sys.AddFunction( t*(y-1) + (1-t)*(2*x + 5*y) );
+
+		double tracking_tolerance(1e-12);
+		unsigned max_num_newton_iterations = 30;
+		unsigned min_num_newton_iterations = 1;
+
+		Vec<dbl> full_newton_result, chord_result;
+		NewtonCorrector full_newton(sys);
+		auto success_code = full_newton.Correct(full_newton_result, sys, current_space, current_time,
+		                                        tracking_tolerance, min_num_newton_iterations, max_num_newton_iterations);
+		BOOST_CHECK(success_code==bertini::tracking::SuccessCode::Success);
+		BOOST_CHECK_EQUAL(full_newton.NumFactorizationsSkipped(), 0);
+
+		bertini::tracking::config::Newton chord_settings;
+		chord_settings.reuse_factorization = true;
+		NewtonCorrector chord(sys);
+		chord.Settings(chord_settings);
+		success_code = chord.Correct(chord_result, sys, current_space, current_time,
+		                             tracking_tolerance, min_num_newton_iterations, max_num_newton_iterations);
+		BOOST_CHECK(success_code==bertini::tracking::SuccessCode::Success);
+		BOOST_CHECK(chord.NumFactorizationsSkipped() > 0);
+
+		for (unsigned ii = 0; ii < chord_result.size(); ++ii)
+			BOOST_CHECK(abs(chord_result(ii)-full_newton_result(ii)) < 1e-10);
+	}
+
+	BOOST_AUTO_TEST_CASE(sparse_newton_matches_dense)
+	{
+		const unsigned n = 60;
+		bertini::System sys;
+		VariableGroup vars;
+		for (unsigned ii = 0; ii < n; ++ii)
+			vars.push_back(std::make_shared<Variable>("x" + std::to_string(ii)));
+		Var t = std::make_shared<Variable>("t");
+		sys.AddVariableGroup(vars);
+		sys.AddPathVariable(t);
+
+		for (unsigned ii = 0; ii < n; ++ii)
+			sys.AddFunction(4*vars[ii] + vars[(ii+n-1)%n]*vars[(ii+1)%n] - t - 1);
+		BOOST_REQUIRE(sys.UseSparseLinearAlgebra());
+
+		Vec<dbl> current_space(n);
+		for (unsigned ii = 0; ii < n; ++ii)
+			current_space(ii) = dbl(0.25 + 0.01*ii, 0.02);
+		dbl current_time(0.5, 0.1);
+
+		double tracking_tolerance(1e-12);
+		unsigned max_num_newton_iterations = 10;
+		unsigned min_num_newton_iterations = 1;
+
+		Vec<dbl> sparse_result, dense_result;
+		NewtonCorrector newton(sys);
+		auto success_code = newton.Correct(sparse_result, sys, current_space, current_time,
+		                                   tracking_tolerance, min_num_newton_iterations, max_num_newton_iterations);
+		BOOST_CHECK(success_code==bertini::tracking::SuccessCode::Success);
+		BOOST_CHECK(sys.Eval(sparse_result, current_time).norm() < 1e-10);
+
+		sys.SetSparseDensityThreshold(0);
+		success_code = newton.Correct(dense_result, sys, current_space, current_time,
+		                              tracking_tolerance, min_num_newton_iterations, max_num_newton_iterations);
+		BOOST_CHECK(success_code==bertini::tracking::SuccessCode::Success);
+
+		BOOST_CHECK((sparse_result-dense_result).norm() < 1e-10);
+
+
+		// and in multiple precision, with the AMP criteria, which need the norms from the sparse factorization
+		sys.SetSparseDensityThreshold(0.1);
+		DefaultPrecision(30);
+		sys.precision(30);
+		newton.ChangePrecision(30);
+
+		Vec<mpfr> current_space_mp(n), result_mp;
+		for (unsigned ii = 0; ii < n; ++ii)
+			current_space_mp(ii) = mpfr(mpfr_float(25+ii)/100, mpfr_float("0.02"));
+		mpfr current_time_mp("0.5","0.1");
+
+		mpfr_float norm_delta_z, norm_J, norm_J_inverse, condition_number_estimate;
+		auto AMP = bertini::tracking::config::AMPConfigFrom(sys);
+		success_code = newton.Correct(result_mp, norm_delta_z, norm_J, norm_J_inverse, condition_number_estimate,
+		                              sys, current_space_mp, current_time_mp, mpfr_float("1e-20"),
+		                              min_num_newton_iterations, max_num_newton_iterations, AMP);
+		BOOST_CHECK(success_code==bertini::tracking::SuccessCode::Success);
+		BOOST_CHECK(norm_J > 0);
+		BOOST_CHECK(condition_number_estimate >= 1);
+		for (unsigned ii = 0; ii < n; ++ii)
+			BOOST_CHECK(abs(dbl(static_cast<double>(result_mp(ii).real()), static_cast<double>(result_mp(ii).imag())) - sparse_result(ii)) < 1e-10);
+	}
+
+
+
+	BOOST_AUTO_TEST_CASE(mixed_precision_lu_chooses_tier_by_conditioning)
+	{
+		using bertini::tracking::MixedPrecisionLU;
+		using bertini::tracking::amp::PrecisionTier;
+
+		DefaultPrecision(50);
+		const unsigned n = 30;
+
+		Mat<mpfr> J(n,n);
+		Vec<mpfr> b(n), x;
+		for (unsigned ii = 0; ii < n; ++ii)
+		{
+			for (unsigned jj = 0; jj < n; ++jj)
+				J(ii,jj) = mpfr(mpfr_float(1)/(ii+jj+2), mpfr_float(ii==jj ? 0 : 1)/(3*n));
+			J(ii,ii) += mpfr(4);
+			b(ii) = mpfr(mpfr_float(ii+1)/n, mpfr_float(1)/3);
+		}
+
+		MixedPrecisionLU<mpfr> mixed;
+
+		// well conditioned, so factored in double
+		BOOST_REQUIRE(mixed.Factor(J));
+		BOOST_CHECK(mixed.Tier()==PrecisionTier::Double);
+		BOOST_REQUIRE(mixed.Solve(x, J, b));
+		BOOST_CHECK((J*x-b).norm() < mpfr_float("1e-45"));
+		BOOST_CHECK(mixed.NumRefinementSteps() > 0);
+
+		// grading the rows makes the condition number about 1e12, too large for double to refine quickly
+		for (unsigned ii = 0; ii < n; ++ii)
+			J.row(ii) *= mpfr(pow(mpfr_float(10), -mpfr_float(12*ii)/(n-1)));
+		BOOST_REQUIRE(mixed.Factor(J));
+		BOOST_CHECK(mixed.Tier()==PrecisionTier::DoubleDouble);
+		BOOST_REQUIRE(mixed.Solve(x, J, b));
+		BOOST_CHECK((J*x-b).norm() < mpfr_float("1e-45")*J.norm()*x.norm());
+
+		// and about 1e40, beyond double-double, so factored in full precision
+		for (unsigned ii = 0; ii < n; ++ii)
+			J.row(ii) *= mpfr(pow(mpfr_float(10), -mpfr_float(28*ii)/(n-1)));
+		BOOST_REQUIRE(mixed.Factor(J));
+		BOOST_CHECK(mixed.Tier()==PrecisionTier::Multiple);
+		BOOST_REQUIRE(mixed.Solve(x, J, b));
+		BOOST_CHECK((J*x-b).norm() < mpfr_float("1e-45")*J.norm()*x.norm());
+
+		BOOST_CHECK_EQUAL(mixed.NumStalls(), 0);
+		BOOST_CHECK_EQUAL(mixed.NumFactorizations(PrecisionTier::Multiple), 1);
+	}
+
+
+	BOOST_AUTO_TEST_CASE(mixed_precision_newton_matches_direct_mp)
+	{
+		DefaultPrecision(50);
+		const unsigned n = 30;
+		bertini::System sys;
+		VariableGroup vars;
+		for (unsigned ii = 0; ii < n; ++ii)
+			vars.push_back(std::make_shared<Variable>("x" + std::to_string(ii)));
+		Var t = std::make_shared<Variable>("t");
+		sys.AddVariableGroup(vars);
+		sys.AddPathVariable(t);
+
+		for (unsigned ii = 0; ii < n; ++ii)
+			sys.AddFunction(4*vars[ii] + vars[(ii+n-1)%n]*vars[(ii+1)%n] - t - 1);
+		sys.precision(50);
+
+		Vec<mpfr> current_space(n), direct_result, mixed_result;
+		for (unsigned ii = 0; ii < n; ++ii)
+			current_space(ii) = mpfr(mpfr_float(25+ii)/100, mpfr_float("0.02"));
+		mpfr current_time("0.5","0.1");
+
+		mpfr_float tracking_tolerance("1e-40");
+		unsigned max_num_newton_iterations = 10;
+		unsigned min_num_newton_iterations = 1;
+
+		NewtonCorrector newton(sys);
+		newton.ChangePrecision(50);
+		auto AMP = bertini::tracking::config::AMPConfigFrom(sys);
+
+		mpfr_float norm_delta_z, norm_J, direct_norm_J_inverse, mixed_norm_J_inverse, condition_number_estimate;
+		auto success_code = newton.Correct(direct_result, norm_delta_z, norm_J, direct_norm_J_inverse, condition_number_estimate,
+		                                   sys, current_space, current_time, tracking_tolerance,
+		                                   min_num_newton_iterations, max_num_newton_iterations, AMP);
+		BOOST_CHECK(success_code==bertini::tracking::SuccessCode::Success);
+
+		AMP.mixed_precision_linear_solves = true;
+		success_code = newton.Correct(mixed_result, norm_delta_z, norm_J, mixed_norm_J_inverse, condition_number_estimate,
+		                              sys, current_space, current_time, tracking_tolerance,
+		                              min_num_newton_iterations, max_num_newton_iterations, AMP);
+		BOOST_CHECK(success_code==bertini::tracking::SuccessCode::Success);
+
+		BOOST_CHECK((mixed_result-direct_result).norm() < mpfr_float("1e-40"));
+		BOOST_CHECK(sys.Eval(mixed_result, current_time).norm() < mpfr_float("1e-40"));
+		// the estimates differ, being from factorizations in different precisions, but not by much
+		BOOST_CHECK(mixed_norm_J_inverse > direct_norm_J_inverse/10);
+		BOOST_CHECK(mixed_norm_J_inverse < direct_norm_J_inverse*10);
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
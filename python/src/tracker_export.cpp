@@ -61,6 +61,8 @@ namespace bertini{
 			.def("current_point", &TrackerT::CurrentPoint)
 			.def("current_time", &TrackerT::CurrentTime)
 			.def("current_precision", &TrackerT::CurrentPrecision)
+			.def("num_precision_changes", &TrackerT::NumPrecisionChanges)
+			.def("seconds_changing_precision", &TrackerT::SecondsChangingPrecision)
 			.def("refine", return_Refine3_ptr<dbl>)
 			.def("refine", return_Refine3_ptr<mpfr>)
 			.def("refine", return_Refine4_ptr<dbl, double>)
@@ -78,6 +80,8 @@ namespace bertini{
 			.def("current_point", &TrackerT::CurrentPoint)
 			.def("current_time", &TrackerT::CurrentTime)
 			.def("current_precision", &TrackerT::CurrentPrecision)
+			.def("num_precision_changes", &TrackerT::NumPrecisionChanges)
+			.def("seconds_changing_precision", &TrackerT::SecondsChangingPrecision)
 			.def("tracker_loop_initialization", &TrackerT::TrackerLoopInitialization)
 			.def("refine", return_Refine3_ptr<dbl>)
 			.def("refine", return_Refine4_ptr<dbl, double>)
@@ -93,6 +97,8 @@ namespace bertini{
 			.def("current_point", &TrackerT::CurrentPoint)
 			.def("current_time", &TrackerT::CurrentTime)
 			.def("current_precision", &TrackerT::CurrentPrecision)
+			.def("num_precision_changes", &TrackerT::NumPrecisionChanges)
+			.def("seconds_changing_precision", &TrackerT::SecondsChangingPrecision)
 			.def("tracker_loop_initialization", &TrackerT::TrackerLoopInitialization)
 			.def("refine", return_Refine3_ptr<mpfr>)
 			.def("refine", return_Refine4_ptr<mpfr, mpfr_float>)
@@ -232,6 +238,8 @@ namespace bertini{
 				class_<Newton, std::shared_ptr<Newton> >("Newton", init<>())
 					.def_readwrite("max_num_newton_iterations", &Newton::max_num_newton_iterations)
 					.def_readwrite("min_num_newton_iterations", &Newton::min_num_newton_iterations)
+					.def_readwrite("reuse_factorization", &Newton::reuse_factorization)
+					.def_readwrite("max_chord_contraction", &Newton::max_chord_contraction)
 					;
 				
 				